@@ -0,0 +1,308 @@
+/**
+ * @file corpus.cpp
+ * @brief Файл реализации генератора русского текста
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "corpus.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+/// Алфавит в порядке индексов генератора
+const wchar_t upperAlpha[] = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+const wchar_t lowerAlpha[] = L"абвгдеёжзийклмнопрстуфхцчшщъыьэюя";
+
+/// Частоты букв русского языка (на 10000 букв)
+const double letterFreq[CorpusGenerator::alphabetSize] = {
+    801, 159, 454, 170, 298, 845, 4, 94, 165, 735, 121, 349, 440, 321, 670, 1097, 281,
+    473, 547, 626, 262, 26, 97, 48, 144, 73, 36, 4, 190, 174, 32, 64, 201
+};
+
+/// Частоты длин слов от 1 до 16 букв (на 1000 слов)
+const double wordLengthFreq[] = {
+    40, 105, 90, 100, 110, 115, 110, 95, 75, 55, 40, 27, 17, 10, 6, 4
+};
+
+const wchar_t punctuation[] = L",,,,,..!?:;-";
+const wchar_t invalidChars[] = L"0123456789QWERTYUIOPASDFGHJKLZXCVBNMqwertyuiopasdfghjklzxcvbnm";
+
+enum LetterClass { Vowel, Consonant, Sign, Short };
+
+LetterClass letterClass(int i)
+{
+    switch (upperAlpha[i]) {
+    case L'А': case L'Е': case L'Ё': case L'И': case L'О':
+    case L'У': case L'Ы': case L'Э': case L'Ю': case L'Я':
+        return Vowel;
+    case L'Ь': case L'Ъ':
+        return Sign;
+    case L'Й':
+        return Short;
+    default:
+        return Consonant;
+    }
+}
+
+/**
+ * @brief Поправочный множитель к частоте буквы next после буквы prev
+ * @param[in] prev Индекс предыдущей буквы или alphabetSize для начала слова
+ * @param[in] next Индекс следующей буквы
+ */
+double bigramFactor(int prev, int next)
+{
+    LetterClass n = letterClass(next);
+    wchar_t nc = upperAlpha[next];
+    if (prev == CorpusGenerator::alphabetSize) {
+        if (n == Sign || nc == L'Ы')
+            return 0.0;
+        return n == Short ? 0.05 : 1.0;
+    }
+    LetterClass p = letterClass(prev);
+    wchar_t pc = upperAlpha[prev];
+    double f = 1.0;
+    switch (p) {
+    case Vowel:
+        if (n == Sign || nc == L'Ы')
+            return 0.0;
+        f = n == Vowel ? 0.35 : n == Short ? 3.0 : 1.3;
+        break;
+    case Consonant:
+        f = n == Vowel ? 2.2 : n == Sign ? 1.5 : n == Short ? 0.02 : 0.6;
+        if (nc == L'Ъ' && pc != L'Б' && pc != L'Д' && pc != L'З' && pc != L'С' && pc != L'В' && pc != L'Н')
+            return 0.0;
+        if ((pc == L'Ж' || pc == L'Ш' || pc == L'Ч' || pc == L'Щ')
+            && (nc == L'Ы' || nc == L'Я' || nc == L'Ю'))
+            f *= 0.05;
+        break;
+    case Sign:
+    case Short:
+        if (n == Sign || n == Short || nc == L'Ы')
+            return 0.0;
+        f = n == Vowel ? (p == Sign ? 1.5 : 0.3) : 1.0;
+        break;
+    }
+    if (prev == next)
+        f *= n == Vowel ? 0.1 : 0.8;
+    return f;
+}
+
+/// Строит таблицу alias-метода (алгоритм Воуза) по набору весов
+CorpusGenerator::AliasTable makeAliasTable(const double* weights, int size)
+{
+    CorpusGenerator::AliasTable t;
+    t.size = size;
+    double total = 0;
+    for (int i = 0; i < size; i++)
+        total += weights[i];
+    std::vector<double> scaled(size);
+    std::vector<int> small, large;
+    for (int i = 0; i < size; i++) {
+        scaled[i] = weights[i] * size / total;
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty()) {
+        int s = small.back(), l = large.back();
+        small.pop_back();
+        t.threshold[s] = static_cast<uint32_t>(scaled[s] * 4294967295.0);
+        t.alias[s] = static_cast<uint8_t>(l);
+        scaled[l] -= 1.0 - scaled[s];
+        if (scaled[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    for (int i : small) {
+        t.threshold[i] = 0xFFFFFFFFu;
+        t.alias[i] = static_cast<uint8_t>(i);
+    }
+    for (int i : large) {
+        t.threshold[i] = 0xFFFFFFFFu;
+        t.alias[i] = static_cast<uint8_t>(i);
+    }
+    return t;
+}
+
+uint32_t probabilityThreshold(double p)
+{
+    if (p <= 0.0)
+        return 0;
+    if (p >= 1.0)
+        return 0xFFFFFFFFu;
+    return static_cast<uint32_t>(p * 4294967296.0);
+}
+
+uint64_t rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+/// Очередное число генератора xoshiro256**
+inline uint64_t xoshiro(uint64_t* s)
+{
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+/// Выбор из таблицы alias-метода без ветвления по случайному числу r
+inline int aliasSample(const CorpusGenerator::AliasTable& table, uint64_t r)
+{
+    uint32_t i = static_cast<uint32_t>(((r >> 32) * static_cast<uint64_t>(table.size)) >> 32);
+    uint32_t own = static_cast<uint32_t>(r) < table.threshold[i];
+    return static_cast<int>(own * i + (1 - own) * table.alias[i]);
+}
+
+} // namespace
+
+CorpusGenerator::CorpusGenerator(const CorpusOptions& options) : opts(options)
+{
+    // Инициализация состояния xoshiro256** через splitmix64
+    uint64_t s = opts.seed;
+    for (auto& x : state) {
+        s += 0x9E3779B97F4A7C15ull;
+        uint64_t z = s;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        x = z ^ (z >> 31);
+    }
+
+    double weights[alphabetSize];
+    for (int prev = 0; prev <= alphabetSize; prev++) {
+        for (int i = 0; i < alphabetSize; i++) {
+            weights[i] = letterFreq[i] * bigramFactor(prev, i);
+            if (!opts.yo && upperAlpha[i] == L'Ё')
+                weights[i] = 0.0;
+        }
+        next[prev] = makeAliasTable(weights, alphabetSize);
+    }
+    wordLength = makeAliasTable(wordLengthFreq, sizeof(wordLengthFreq) / sizeof(wordLengthFreq[0]));
+
+    lowerThreshold = probabilityThreshold(opts.lowercaseRate);
+    invalidThreshold = probabilityThreshold(opts.invalidRate);
+    punctuationThreshold = probabilityThreshold(opts.punctuationRate);
+}
+
+uint64_t CorpusGenerator::random()
+{
+    return xoshiro(state);
+}
+
+int CorpusGenerator::sample(const AliasTable& table)
+{
+    return aliasSample(table, xoshiro(state));
+}
+
+void CorpusGenerator::nextWord()
+{
+    int length = sample(wordLength) + 1;
+    int prev = alphabetSize;
+    wordSize = 0;
+    wordPos = 0;
+    if (!invalidThreshold && !lowerThreshold) {
+        // Без строчных и недопустимых символов лишнее случайное число не нужно
+        for (int k = 0; k < length; k++) {
+            prev = sample(next[prev]);
+            word[k] = upperAlpha[prev];
+        }
+        wordSize = length;
+    }
+    for (int k = wordSize; k < length; k++) {
+        int letter = sample(next[prev]);
+        prev = letter;
+        uint64_t r = random();
+        uint32_t low = static_cast<uint32_t>(r);
+        wchar_t c;
+        if (low < invalidThreshold) {
+            c = invalidChars[((r >> 32) * (sizeof(invalidChars) / sizeof(wchar_t) - 1)) >> 32];
+        } else if (static_cast<uint32_t>(r >> 32) < lowerThreshold && !(k == 0 && sentenceEnd)) {
+            c = lowerAlpha[letter];
+        } else {
+            c = upperAlpha[letter];
+        }
+        word[wordSize++] = c;
+    }
+    sentenceEnd = false;
+    lineSize += length;
+
+    if (punctuationThreshold && static_cast<uint32_t>(random()) < punctuationThreshold) {
+        wchar_t p = punctuation[random() % (sizeof(punctuation) / sizeof(wchar_t) - 1)];
+        word[wordSize++] = p;
+        sentenceEnd = p == L'.' || p == L'!' || p == L'?';
+        lineSize++;
+    }
+    if (opts.lineLength && lineSize >= opts.lineLength) {
+        word[wordSize++] = L'\n';
+        lineSize = 0;
+    } else if (opts.spaces) {
+        word[wordSize++] = L' ';
+        lineSize++;
+    }
+}
+
+void CorpusGenerator::generate(wchar_t* out, std::size_t count)
+{
+    while (count > 0) {
+        if (wordPos == wordSize)
+            nextWord();
+        std::size_t n = std::min<std::size_t>(count, wordSize - wordPos);
+        std::copy(word + wordPos, word + wordPos + n, out);
+        wordPos += static_cast<int>(n);
+        out += n;
+        count -= n;
+    }
+}
+
+std::wstring CorpusGenerator::generate(std::size_t count)
+{
+    std::wstring result(count, L'\0');
+    if (count)
+        generate(&result[0], count);
+    return result;
+}
+
+uint64_t CorpusGenerator::write(std::ostream& out, uint64_t count)
+{
+    const std::size_t block = 1 << 16;
+    std::vector<wchar_t> text(block);
+    std::vector<char> bytes(3 * block);
+    uint64_t written = 0;
+    while (count > 0 && out) {
+        std::size_t n = static_cast<std::size_t>(std::min<uint64_t>(count, block));
+        generate(text.data(), n);
+        std::size_t size = encodeUtf8(text.data(), n, bytes.data());
+        out.write(bytes.data(), size);
+        written += size;
+        count -= n;
+    }
+    return written;
+}
+
+std::size_t encodeUtf8(const wchar_t* text, std::size_t count, char* out)
+{
+    char* p = out;
+    for (std::size_t i = 0; i < count; i++) {
+        uint32_t c = static_cast<uint32_t>(text[i]);
+        if (c < 0x80) {
+            *p++ = static_cast<char>(c);
+        } else if (c < 0x800) {
+            *p++ = static_cast<char>(0xC0 | (c >> 6));
+            *p++ = static_cast<char>(0x80 | (c & 0x3F));
+        } else {
+            *p++ = static_cast<char>(0xE0 | ((c >> 12) & 0x0F));
+            *p++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            *p++ = static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+    return static_cast<std::size_t>(p - out);
+}
@@ -0,0 +1,111 @@
+/**
+ * @file corpus.h
+ * @brief Заголовочный файл генератора русского текста для нагрузочных тестов и замеров
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Данный файл содержит объявление класса CorpusGenerator, который по заданному
+ * зерну детерминированно порождает русский текст произвольного объёма с
+ * реалистичными частотами букв, биграмм и длин слов.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Параметры генерируемого текста
+ * @details Все вероятности задаются числами от 0 до 1. Значения по умолчанию
+ *          дают сплошной текст из прописных русских букв, разбитый пробелами на слова.
+ */
+struct CorpusOptions {
+    uint64_t seed = 1;             ///< Зерно генератора: одно зерно — один и тот же текст
+    bool spaces = true;            ///< Разделять слова пробелами
+    bool yo = true;                ///< Допускать букву Ё/ё
+    double punctuationRate = 0.0;  ///< Вероятность знака препинания после слова
+    double lowercaseRate = 0.0;    ///< Вероятность того, что буква будет строчной
+    double invalidRate = 0.0;      ///< Вероятность замены буквы недопустимым символом (цифрой или латиницей)
+    std::size_t lineLength = 0;    ///< Примерная длина строки в символах, 0 — без переводов строк
+};
+
+/**
+ * @brief Детерминированный генератор русского текста
+ * @details Буквы порождаются марковской цепью первого порядка: вероятность
+ *          следующей буквы зависит от предыдущей (частоты букв русского языка
+ *          с поправками на сочетания гласных, согласных, Й, Ь и Ъ). Длины слов
+ *          выбираются по распределению, близкому к русской прозе.
+ *          Выборка из всех распределений выполняется alias-методом за O(1),
+ *          поэтому генератор выдаёт сотни мегабайт в секунду.
+ *          Текст выдаётся потоково: последовательные вызовы generate() и write()
+ *          продолжают одну и ту же последовательность.
+ */
+class CorpusGenerator {
+public:
+    /// Число букв русского алфавита (с Ё)
+    static const int alphabetSize = 33;
+    /// Таблица выборки alias-методом
+    struct AliasTable {
+        uint32_t threshold[alphabetSize]; ///< Порог выбора собственного элемента
+        uint8_t alias[alphabetSize];      ///< Альтернативный элемент
+        int size;                         ///< Число элементов распределения
+    };
+
+    /**
+     * @brief Конструктор генератора
+     * @param[in] options Параметры генерируемого текста
+     */
+    explicit CorpusGenerator(const CorpusOptions& options = CorpusOptions());
+
+    /**
+     * @brief Записывает в буфер очередные символы текста
+     * @param[out] out Буфер для символов
+     * @param[in] count Количество символов
+     */
+    void generate(wchar_t* out, std::size_t count);
+    /**
+     * @brief Возвращает очередные символы текста в виде строки
+     * @param[in] count Количество символов
+     * @return Строка длиной count символов
+     */
+    std::wstring generate(std::size_t count);
+    /**
+     * @brief Записывает очередные символы текста в поток в кодировке UTF-8
+     * @details Текст порождается и кодируется блоками, поэтому объём
+     *          используемой памяти не зависит от count.
+     * @param[in,out] out Поток вывода (следует открывать в двоичном режиме)
+     * @param[in] count Количество символов
+     * @return Количество записанных байт
+     */
+    uint64_t write(std::ostream& out, uint64_t count);
+
+private:
+    CorpusOptions opts;
+    uint64_t state[4];           ///< Состояние xoshiro256**
+    AliasTable next[alphabetSize + 1]; ///< Переходы по предыдущей букве; последняя — начало слова
+    AliasTable wordLength;       ///< Длины слов (индекс + 1)
+    uint32_t lowerThreshold;
+    uint32_t invalidThreshold;
+    uint32_t punctuationThreshold;
+    wchar_t word[32];            ///< Текущее слово вместе с разделителями
+    int wordSize = 0;
+    int wordPos = 0;
+    std::size_t lineSize = 0;
+    bool sentenceEnd = true;
+
+    uint64_t random();
+    int sample(const AliasTable& table);
+    void nextWord();
+};
+
+/**
+ * @brief Кодирует строку из символов BMP в UTF-8
+ * @param[in] text Исходные символы
+ * @param[in] count Количество символов
+ * @param[out] out Буфер не менее 3 * count байт
+ * @return Количество записанных байт
+ */
+std::size_t encodeUtf8(const wchar_t* text, std::size_t count, char* out);
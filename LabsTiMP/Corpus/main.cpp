@@ -0,0 +1,109 @@
+/**
+ * @file main.cpp
+ * @brief Утилита генерации русского текста для замеров и нагрузочных тестов шифров
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Использование:
+ * @code
+ * corpus_gen [-n РАЗМЕР] [-s ЗЕРНО] [-o ФАЙЛ] [--no-spaces] [--no-yo]
+ *            [--punct P] [--lower P] [--invalid P] [--line N]
+ * @endcode
+ * РАЗМЕР задаётся в символах и допускает суффиксы K, M, G (степени 1024).
+ * Без -o текст в кодировке UTF-8 выводится в стандартный поток вывода.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "corpus.h"
+
+using namespace std;
+
+/**
+ * @brief Разбирает размер с необязательным суффиксом K, M или G
+ * @param[in] s Строка с размером
+ * @return Размер в символах
+ * @throw invalid_argument Если строка не является размером
+ */
+uint64_t parseSize(const string& s)
+{
+    size_t pos = 0;
+    uint64_t value = stoull(s, &pos);
+    if (pos + 1 == s.size()) {
+        switch (s[pos]) {
+        case 'K': case 'k': return value << 10;
+        case 'M': case 'm': return value << 20;
+        case 'G': case 'g': return value << 30;
+        }
+    }
+    if (pos != s.size())
+        throw invalid_argument("bad size: " + s);
+    return value;
+}
+
+/**
+ * @brief Главная функция программы
+ * @details Разбирает параметры командной строки и записывает сгенерированный текст
+ *          в файл или в стандартный поток вывода.
+ * @return 0 при успешном завершении, 1 при ошибке в параметрах или записи
+ */
+int main(int argc, char** argv)
+{
+    CorpusOptions opts;
+    uint64_t count = 1 << 20;
+    string output;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "-n" && hasValue)
+                count = parseSize(argv[++i]);
+            else if (arg == "-s" && hasValue)
+                opts.seed = stoull(argv[++i]);
+            else if (arg == "-o" && hasValue)
+                output = argv[++i];
+            else if (arg == "--no-spaces")
+                opts.spaces = false;
+            else if (arg == "--no-yo")
+                opts.yo = false;
+            else if (arg == "--punct" && hasValue)
+                opts.punctuationRate = stod(argv[++i]);
+            else if (arg == "--lower" && hasValue)
+                opts.lowercaseRate = stod(argv[++i]);
+            else if (arg == "--invalid" && hasValue)
+                opts.invalidRate = stod(argv[++i]);
+            else if (arg == "--line" && hasValue)
+                opts.lineLength = stoul(argv[++i]);
+            else
+                throw invalid_argument("unknown option: " + arg);
+        }
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        cerr << "Usage: " << argv[0] << " [-n SIZE] [-s SEED] [-o FILE] [--no-spaces] [--no-yo]"
+             << " [--punct P] [--lower P] [--invalid P] [--line N]" << endl;
+        return 1;
+    }
+
+    CorpusGenerator gen(opts);
+    ofstream file;
+    if (!output.empty()) {
+        file.open(output, ios::binary);
+        if (!file) {
+            cerr << "Error: cannot open " << output << endl;
+            return 1;
+        }
+    }
+    ostream& out = output.empty() ? cout : file;
+    gen.write(out, count);
+    out.flush();
+    if (!out) {
+        cerr << "Error: write failed" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file measure.cpp
+ * @brief Счётчики выделенной памяти на основе замены глобальных operator new/delete
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "measure.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::size_t> current(0);
+std::atomic<std::size_t> peak(0);
+std::atomic<std::size_t> calls(0);
+
+/// Размер блока хранится перед ним; заголовок сохраняет выравнивание max_align_t
+const std::size_t header = alignof(std::max_align_t);
+
+void* countedAlloc(std::size_t size)
+{
+    void* p = std::malloc(size + header);
+    if (!p)
+        throw std::bad_alloc();
+    *static_cast<std::size_t*>(p) = size;
+    calls.fetch_add(1);
+    std::size_t now = current.fetch_add(size) + size;
+    std::size_t old = peak.load();
+    while (now > old && !peak.compare_exchange_weak(old, now)) {
+    }
+    return static_cast<char*>(p) + header;
+}
+
+void countedFree(void* p)
+{
+    if (!p)
+        return;
+    void* block = static_cast<char*>(p) - header;
+    current.fetch_sub(*static_cast<std::size_t*>(block));
+    std::free(block);
+}
+
+} // namespace
+
+std::size_t allocatedBytes()
+{
+    return current.load();
+}
+
+std::size_t peakAllocatedBytes()
+{
+    return peak.load();
+}
+
+std::size_t allocationCount()
+{
+    return calls.load();
+}
+
+void resetPeakAllocatedBytes()
+{
+    peak.store(current.load());
+}
+
+void* operator new(std::size_t size)
+{
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return countedAlloc(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    countedFree(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    countedFree(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    countedFree(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    countedFree(p);
+}
@@ -0,0 +1,72 @@
+/**
+ * @file measure.h
+ * @brief Средства замера времени и пиковой памяти для нагрузочных тестов
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Подключение measure.cpp к программе заменяет глобальные operator new/delete
+ * счётчиками выделенной памяти. Его следует подключать только к тестам и замерам.
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+/// Объём памяти, выделенной через operator new и ещё не освобождённой, в байтах
+std::size_t allocatedBytes();
+/// Наибольшее значение allocatedBytes() с момента последнего сброса
+std::size_t peakAllocatedBytes();
+/// Количество вызовов operator new с начала программы
+std::size_t allocationCount();
+/// Сбрасывает пиковое значение к текущему объёму
+void resetPeakAllocatedBytes();
+
+/**
+ * @brief Результат замера
+ */
+struct Measurement {
+    double seconds;          ///< Наименьшее время выполнения, с
+    std::size_t peakBytes;   ///< Наибольший прирост выделенной памяти во время выполнения, байт
+    std::size_t allocations; ///< Наибольшее за повтор количество вызовов operator new
+};
+
+/**
+ * @brief Замеряет время, пиковую память и количество выделений памяти вызова
+ * @param[in] f Замеряемая функция без параметров
+ * @param[in] repeats Количество повторов; время берётся наименьшее
+ * @return Результат замера
+ */
+template <class F>
+Measurement measure(F f, int repeats = 3)
+{
+    Measurement m = { 0.0, 0, 0 };
+    for (int i = 0; i < repeats; i++) {
+        resetPeakAllocatedBytes();
+        std::size_t base = allocatedBytes();
+        std::size_t baseCalls = allocationCount();
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+        m.seconds = i == 0 ? d.count() : std::min(m.seconds, d.count());
+        m.peakBytes = std::max(m.peakBytes, peakAllocatedBytes() - base);
+        m.allocations = std::max(m.allocations, allocationCount() - baseCalls);
+    }
+    return m;
+}
+
+/**
+ * @brief Отношение наибольшего значения к наименьшему
+ * @details Применяется к удельным величинам (на символ): для линейного
+ *          алгоритма отношение близко к 1, для квадратичного растёт
+ *          пропорционально размеру входа.
+ * @param[in] values Непустой набор положительных значений
+ */
+inline double spread(const std::vector<double>& values)
+{
+    auto mm = std::minmax_element(values.begin(), values.end());
+    return *mm.second / *mm.first;
+}
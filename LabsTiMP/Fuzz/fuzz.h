@@ -0,0 +1,106 @@
+/**
+ * @file fuzz.h
+ * @brief Общие объявления дифференциального фаззинга шифров
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Каждая цель фаззинга (fuzz_gronsfeld.cpp, fuzz_route.cpp) разбирает
+ * входные байты в ключ и текст, прогоняет их через эталонную реализацию из
+ * reference.h и через рабочий класс шифра и сообщает о любом расхождении в
+ * результате или в наличии ошибки. Цель собирается либо с libFuzzer, либо с
+ * автономным драйвером fuzz_main.cpp, который генерирует случайные входы и
+ * минимизирует найденное расхождение.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Последовательное чтение параметров из входных байтов
+ * @details При исчерпании данных все методы возвращают нули, поэтому любой
+ *          вход, в том числе пустой, разбирается без ошибок.
+ */
+class FuzzReader {
+public:
+    FuzzReader(const uint8_t* data, std::size_t size) : data(data), size(size), pos(0) {}
+
+    /// Очередной байт или 0
+    uint8_t byte() { return pos < size ? data[pos++] : 0; }
+    /// Очередные четыре байта (little-endian)
+    uint32_t u32()
+    {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++)
+            v |= uint32_t(byte()) << (8 * i);
+        return v;
+    }
+    /// Русская буква (прописная или строчная, включая Ё/ё)
+    wchar_t letter();
+    /// Произвольный символ: буквы, пробелы, знаки, цифры, латиница и посторонняя кириллица
+    wchar_t character();
+    /// Оставшиеся байты в виде текста
+    std::wstring text();
+    /// Количество непрочитанных байт
+    std::size_t remaining() const { return size - pos; }
+
+private:
+    const uint8_t* data;
+    std::size_t size;
+    std::size_t pos;
+};
+
+/**
+ * @brief Результат вызова шифра: строка или признак ошибки
+ */
+struct Outcome {
+    bool failed;        ///< Вызов завершился исключением std::invalid_argument
+    std::wstring value; ///< Результат, если исключения не было
+
+    bool operator==(const Outcome& o) const { return failed == o.failed && value == o.value; }
+    bool operator!=(const Outcome& o) const { return !(*this == o); }
+};
+
+/**
+ * @brief Выполняет вызов и переводит ошибку шифра в Outcome
+ * @param[in] f Функция без параметров, возвращающая std::wstring
+ */
+template <class F>
+Outcome run(F f)
+{
+    try {
+        return Outcome{ false, f() };
+    } catch (const std::invalid_argument&) {
+        return Outcome{ true, std::wstring() };
+    }
+}
+
+/**
+ * @brief Проверяет один вход цели фаззинга
+ * @param[in] data Входные байты
+ * @param[in] size Количество байт
+ * @param[out] report Описание расхождения (UTF-8), если оно найдено
+ * @return true, если эталон и рабочая реализация разошлись
+ */
+bool fuzzOne(const uint8_t* data, std::size_t size, std::string& report);
+
+/**
+ * @brief Входы для крайних случаев цели (один столбец, столбцов больше текста,
+ *        ключ из одних А, буква Ё и т. п.)
+ */
+std::vector<std::vector<uint8_t>> edgeCases();
+
+/// Кодирует строку в UTF-8 для отчёта
+std::string toUtf8(const std::wstring& s);
+/// Описание результата для отчёта
+std::string describe(const Outcome& o);
+
+/// Устанавливает русскую локаль, необходимую рабочим классам шифров
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv);
+/// Точка входа libFuzzer: при расхождении печатает отчёт и аварийно завершает процесс
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, std::size_t size);
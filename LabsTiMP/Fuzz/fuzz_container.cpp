@@ -0,0 +1,132 @@
+/**
+ * @file fuzz_container.cpp
+ * @brief Цель фаззинга контейнера шифртекста и разметки фрагментов
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Формат входа: байт размера фрагмента, четыре байта параметра повреждения,
+ * остальные байты — текст. Проверяется, что container::merge обращает
+ * container::split для прописных букв, что контейнер, записанный
+ * container::Writer, разбирается container::Reader с теми же фрагментами и
+ * восстанавливает текст, и что повреждённый байт контейнера даёт либо
+ * std::invalid_argument, либо корректно разобранный контейнер (выход за
+ * пределы буфера ловит AddressSanitizer в сборке с libFuzzer).
+ */
+
+#include "fuzz.h"
+#include "../Tools/container.h"
+#include "../Tools/utf8.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cwctype>
+
+namespace {
+
+/// Буквы фрагмента, какими их возвращает шифр
+std::wstring upper(std::wstring s)
+{
+    for (wchar_t& c : s)
+        c = static_cast<wchar_t>(std::towupper(c));
+    return s;
+}
+
+/// Записывает контейнер с фрагментами text по chunk символов, «шифртекст» — прописные буквы
+std::string write(const std::wstring& text, std::size_t chunk)
+{
+    char* buffer = nullptr;
+    std::size_t size = 0;
+    FILE* file = open_memstream(&buffer, &size);
+    {
+        container::Header header;
+        header.layout = true;
+        header.chunkSize = static_cast<uint32_t>(chunk);
+        container::Writer writer(file, header);
+        for (std::size_t i = 0; i < text.size(); i += chunk) {
+            std::string layout;
+            std::wstring letters = upper(container::split(text.substr(i, chunk), layout));
+            writer.append(toUtf8(letters), letters.size(), layout);
+        }
+        writer.finish(false);
+    }
+    fclose(file);
+    std::string bytes(buffer, size);
+    free(buffer);
+    return bytes;
+}
+
+/// Разбирает контейнер и восстанавливает текст по всем фрагментам
+std::wstring read(const std::string& bytes)
+{
+    container::Reader reader(bytes.data(), bytes.size());
+    std::wstring text;
+    for (std::size_t i = 0; i < reader.chunks(); i++) {
+        std::string_view cipher = reader.cipherText(i);
+        std::vector<wchar_t> chars(cipher.size() + 2);
+        utf8::Decoder decoder;
+        std::size_t n = decoder.decode(cipher.data(), cipher.size(), chars.data());
+        n += decoder.finish(chars.data() + n);
+        std::wstring letters(chars.data(), n);
+        text += reader.header().layout ? container::merge(letters, reader.layout(i)) : letters;
+    }
+    return text;
+}
+
+} // namespace
+
+bool fuzzOne(const uint8_t* data, std::size_t size, std::string& report)
+{
+    FuzzReader in(data, size);
+    std::size_t chunk = 1 + in.byte() % 32;
+    uint32_t param = in.u32();
+    std::wstring text = in.text();
+    report = "chunk=" + std::to_string(chunk) + " text=\"" + toUtf8(text) + "\"\n";
+    bool diverged = false;
+
+    std::string layout;
+    std::wstring letters = container::split(text, layout);
+    Outcome merged = run([&] { return container::merge(upper(letters), layout); });
+    if (merged != Outcome{ false, text }) {
+        report += "merge(split): " + describe(merged) + "\n";
+        diverged = true;
+    }
+
+    std::string bytes = write(text, chunk);
+    Outcome restored = run([&] { return read(bytes); });
+    if (restored != Outcome{ false, text }) {
+        report += "container: " + describe(restored) + "\n";
+        diverged = true;
+    }
+    container::Reader reader(bytes.data(), bytes.size());
+    uint64_t offset = 0;
+    for (std::size_t i = 0; i < reader.chunks(); i++) {
+        if (reader.chunk(i).offset != offset) {
+            report += "chunk " + std::to_string(i) + ": wrong letter offset\n";
+            diverged = true;
+        }
+        offset += reader.chunk(i).letters;
+    }
+
+    // Повреждённый контейнер: ошибка разбора или разобранный текст, но не сбой
+    if (!bytes.empty()) {
+        std::string damaged = bytes;
+        damaged[param % damaged.size()] ^= static_cast<char>(1 + (param >> 24) % 255);
+        run([&] { return read(damaged); });
+        damaged.resize(param % damaged.size());
+        run([&] { return read(damaged); });
+    }
+    return diverged;
+}
+
+std::vector<std::vector<uint8_t>> edgeCases()
+{
+    // Индексы символов палитры: А = 0, ё = 39, 80 — пробел, 99 — латинская A
+    return {
+        {},
+        { 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 80, 80, 80 },                 // только пробелы
+        { 2, 0, 0, 0, 0, 15, 17, 80, 39, 6, 99 },      // фрагменты по 3 символа
+        { 31, 7, 0, 0, 0, 15, 80, 17, 80, 8, 2, 5, 19 },
+    };
+}
@@ -0,0 +1,79 @@
+/**
+ * @file fuzz_entry.cpp
+ * @brief Общая часть целей фаззинга: разбор входа и точки входа libFuzzer
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "fuzz.h"
+#include "../Corpus/corpus.h"
+#include <cstdio>
+#include <cstdlib>
+#include <locale>
+
+namespace {
+
+const wchar_t letters[] = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯабвгдеёжзийклмнопрстуфхцчшщъыьэюя";
+// Буквы повторяются, чтобы случайные входы чаще были допустимым текстом
+const wchar_t palette[] =
+    L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯабвгдеёжзийклмнопрстуфхцчшщъыьэюя"
+    L"ОЕАИНТСРВЛ            ,.!?-:;0179AZazЇїЎєѐ\t\n";
+
+const std::size_t lettersSize = sizeof(letters) / sizeof(wchar_t) - 1;
+const std::size_t paletteSize = sizeof(palette) / sizeof(wchar_t) - 1;
+
+} // namespace
+
+wchar_t FuzzReader::letter()
+{
+    return letters[byte() % lettersSize];
+}
+
+wchar_t FuzzReader::character()
+{
+    return palette[byte() % paletteSize];
+}
+
+std::wstring FuzzReader::text()
+{
+    std::wstring s;
+    s.reserve(remaining());
+    while (remaining() > 0)
+        s.push_back(character());
+    return s;
+}
+
+std::string toUtf8(const std::wstring& s)
+{
+    std::string out(3 * s.size(), '\0');
+    out.resize(encodeUtf8(s.data(), s.size(), &out[0]));
+    return out;
+}
+
+std::string describe(const Outcome& o)
+{
+    return o.failed ? "<error>" : "\"" + toUtf8(o.value) + "\"";
+}
+
+extern "C" int LLVMFuzzerInitialize(int*, char***)
+{
+    try {
+        std::locale::global(std::locale("ru_RU.UTF-8"));
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "locale ru_RU.UTF-8 is not available: %s\n", e.what());
+        std::locale::global(std::locale(""));
+    }
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, std::size_t size)
+{
+    std::string report;
+    if (fuzzOne(data, size, report)) {
+        std::fprintf(stderr, "DIVERGENCE\n%s\n", report.c_str());
+        std::abort();
+    }
+    return 0;
+}
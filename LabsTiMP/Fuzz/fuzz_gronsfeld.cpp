@@ -0,0 +1,243 @@
+/**
+ * @file fuzz_gronsfeld.cpp
+ * @brief Цель дифференциального фаззинга шифра Гронсфельда
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Формат входа: байт длины ключа k (по модулю 17), затем k байт ключа
+ * (байт со старшим битом — произвольный символ, иначе русская буква),
+ * остальные байты — текст. Сравниваются конструктор, encrypt(текст),
+ * decrypt(текст), decrypt(encrypt(текст)), decryptRange по двум частям
+ * шифртекста, append и patch по двум частям текста, строка набора ключей
+ * multiKeyCipher, варианты encrypt/decrypt с памятью из арены std::pmr,
+ * бегущий ключ из повторений ключа (целиком и частями ключа в ногу с
+ * текстом), а для ключа и текста из ASCII и русских букв — ещё и ядро
+ * gronsfeld_static (то же ядро проверяется при компиляции).
+ */
+
+#include "fuzz.h"
+#include "reference.h"
+#include "../Lab3/GronsveldMethod/modAlphaCipher.h"
+#include "../Lab3/GronsveldMethod/gronsfeld_static.h"
+#include <algorithm>
+#include <cwctype>
+#include <memory_resource>
+
+namespace {
+
+// Пример из модульных тестов Lab3, вычисленный при компиляции
+static_assert(gronsfeld_static::encrypt(L"ПРИВЕТ", L"привет, мир!").equals(L"ЯБСДЙЕЬЩЩ"),
+              "compile-time Gronsfeld encryption differs from modAlphaCipher");
+static_assert(gronsfeld_static::decrypt(L"ПРИВЕТ", gronsfeld_static::encrypt(L"ПРИВЕТ", L"ПРИВЕТМИР"))
+                  .equals(L"ПРИВЕТМИР"),
+              "compile-time Gronsfeld decryption is not the inverse of encryption");
+
+/// Все символы строки известны ядру gronsfeld_static
+bool supported(const std::wstring& s)
+{
+    for (wchar_t c : s) {
+        if (!gronsfeld_static::supported(c))
+            return false;
+    }
+    return true;
+}
+
+/// Вызов ядра gronsfeld_static с выходным буфером
+Outcome core(bool encrypt, const std::wstring& key, const std::wstring& text)
+{
+    return run([&] {
+        std::vector<wchar_t> out(text.size() + 1);
+        std::size_t n = encrypt
+            ? gronsfeld_static::encryptInto(key.data(), key.size(), text.data(), text.size(), out.data())
+            : gronsfeld_static::decryptInto(key.data(), key.size(), text.data(), text.size(), out.data());
+        return std::wstring(out.data(), n);
+    });
+}
+
+/// Сравнивает результаты одной операции и дописывает расхождение в отчёт
+bool differs(const char* op, const Outcome& ref, const Outcome& got, std::string& report)
+{
+    if (ref == got)
+        return false;
+    report += std::string(op) + ": reference " + describe(ref) + ", modAlphaCipher " + describe(got) + "\n";
+    return true;
+}
+
+/**
+ * @brief Вызов с памятью из арены: малый начальный буфер на стеке, остальное
+ *        из вышестоящего источника, чтобы проверялись обе ветви арены
+ */
+std::wstring arena(const std::wstring& text, bool encrypt, modAlphaCipher& cipher)
+{
+    char buffer[64];
+    std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer));
+    std::pmr::wstring result = encrypt ? cipher.encrypt(text, &resource) : cipher.decrypt(text, &resource);
+    return std::wstring(result.begin(), result.end());
+}
+
+/**
+ * @brief Поток блоками по block символов, преобразуемыми в том же буфере;
+ *        ошибки сообщаются после последнего блока
+ */
+Outcome stream(bool encrypt, const modAlphaCipher& cipher, const std::wstring& text, std::size_t block)
+{
+    return run([&] {
+        std::wstring buffer = text;
+        modAlphaCipher::Stream state;
+        std::size_t written = 0;
+        for (std::size_t i = 0; i < text.size(); i += block) {
+            std::size_t n = std::min(block, text.size() - i);
+            written += encrypt ? cipher.encryptBlock(&buffer[i], n, state, &buffer[written])
+                               : cipher.decryptBlock(&buffer[i], n, state, &buffer[written]);
+        }
+        if (encrypt)
+            modAlphaCipher::finishEncrypt(state);
+        else
+            modAlphaCipher::finishDecrypt(state);
+        buffer.resize(written);
+        return buffer;
+    });
+}
+
+/**
+ * @brief Бегущий ключ из повторений ключа: целиком (parts == false) или
+ *        частями по window символов, как при чтении ключа из файла
+ */
+Outcome running(bool encrypt, const std::wstring& key, const std::wstring& text, bool parts, std::size_t window)
+{
+    std::wstring stream;
+    while (stream.size() < text.size())
+        stream += key;
+    return run([&] {
+        runningKeyCipher cipher;
+        if (!parts)
+            return encrypt ? cipher.encrypt(text, stream) : cipher.decrypt(text, stream);
+        if (!encrypt && text.empty())
+            throw cipher_error("Пустой шифртекст");
+        std::wstring out(text.size(), L'\0');
+        std::size_t read = 0, written = 0;
+        for (std::size_t k = 0; read < text.size(); k += window) {
+            if (k >= stream.size())
+                throw cipher_error("Бегущий ключ короче текста");
+            std::size_t n = std::min(window, stream.size() - k);
+            runningKeyCipher::Step step = encrypt
+                ? cipher.encrypt(text.data() + read, text.size() - read, stream.data() + k, n, &out[written])
+                : cipher.decrypt(text.data() + read, text.size() - read, stream.data() + k, n, &out[written]);
+            read += step.read;
+            written += step.written;
+        }
+        if (written == 0)
+            throw cipher_error("Пустой открытый текст");
+        out.resize(written);
+        return out;
+    });
+}
+
+} // namespace
+
+bool fuzzOne(const uint8_t* data, std::size_t size, std::string& report)
+{
+    FuzzReader in(data, size);
+    std::wstring key;
+    for (int k = in.byte() % 17; k > 0; k--) {
+        uint8_t b = in.byte();
+        key.push_back(b & 0x80 ? FuzzReader(&b, 1).character() : FuzzReader(&b, 1).letter());
+    }
+    std::wstring text = in.text();
+    report = "key=\"" + toUtf8(key) + "\" text=\"" + toUtf8(text) + "\"\n";
+
+    reference::Gronsfeld* ref = nullptr;
+    modAlphaCipher* got = nullptr;
+    Outcome refKey = run([&] { ref = new reference::Gronsfeld(key); return std::wstring(); });
+    Outcome gotKey = run([&] { got = new modAlphaCipher(key); return std::wstring(); });
+    bool diverged = differs("constructor", refKey, gotKey, report);
+
+    if (ref && got) {
+        Outcome refEnc = run([&] { return ref->encrypt(text); });
+        Outcome gotEnc = run([&] { return got->encrypt(text); });
+        diverged |= differs("encrypt", refEnc, gotEnc, report);
+        diverged |= differs("decrypt", run([&] { return ref->decrypt(text); }),
+                            run([&] { return got->decrypt(text); }), report);
+        diverged |= differs("encrypt(pmr)", refEnc, run([&] { return arena(text, true, *got); }), report);
+        diverged |= differs("decrypt(pmr)", run([&] { return ref->decrypt(text); }),
+                            run([&] { return arena(text, false, *got); }), report);
+        if (!refEnc.failed) {
+            diverged |= differs("decrypt(encrypt)", run([&] { return ref->decrypt(refEnc.value); }),
+                                run([&] { return got->decrypt(refEnc.value); }), report);
+            std::size_t split = text.size() % (refEnc.value.size() + 1);
+            diverged |= differs("decryptRange", run([&] { return ref->decrypt(refEnc.value); }), run([&] {
+                return got->decryptRange(refEnc.value, 0, split)
+                    + got->decryptRange(refEnc.value, split, refEnc.value.size() - split);
+            }), report);
+            // Шифртекст, собранный заменой двух частей текста на месте
+            diverged |= differs("patch", refEnc, run([&] {
+                std::wstring patched(refEnc.value.size(), L'А');
+                std::size_t n = got->patch(patched, 0, text.substr(0, split));
+                got->patch(patched, n, text.substr(split));
+                return patched;
+            }), report);
+        }
+        // Шифртекст, собранный продолжением по двум частям текста
+        std::size_t cut = text.size() / 2 + text.size() % 3;
+        diverged |= differs("append", refEnc, run([&] {
+            std::wstring appended;
+            got->append(appended, text.substr(0, std::min(cut, text.size())));
+            got->append(appended, text.substr(std::min(cut, text.size())));
+            return appended.empty() ? got->encrypt(appended) : appended;
+        }), report);
+        // Строка ключа в матрице набора ключей (перед ним — ключ из одной буквы)
+        diverged |= differs("multi-key", refEnc, run([&] {
+            std::wstring matrix = multiKeyCipher({ L"Б", key }).encrypt(text);
+            return matrix.substr(matrix.size() / 2);
+        }), report);
+        // Поток блоками по 1..5 символов
+        std::size_t block = 1 + text.size() % 5;
+        diverged |= differs("stream encrypt", refEnc, stream(true, *got, text, block), report);
+        diverged |= differs("stream decrypt", run([&] { return ref->decrypt(text); }),
+                            stream(false, *got, text, block), report);
+        // Ключ сдвигов — буквы ключа в верхнем регистре (конструктор проверил их)
+        std::wstring upper;
+        for (wchar_t c : key)
+            upper.push_back(towupper(c));
+        std::size_t window = 1 + text.size() % 7;
+        diverged |= differs("running encrypt", refEnc, running(true, upper, text, false, 0), report);
+        diverged |= differs("running encrypt(parts)", refEnc, running(true, upper, text, true, window), report);
+        if (!refEnc.failed) {
+            Outcome refDec = run([&] { return ref->decrypt(refEnc.value); });
+            diverged |= differs("running decrypt", refDec, running(false, upper, refEnc.value, false, 0), report);
+            diverged |= differs("running decrypt(parts)", refDec,
+                                running(false, upper, refEnc.value, true, window), report);
+        }
+    }
+    if (supported(key) && supported(text)) {
+        Outcome failed{ true, std::wstring() };
+        diverged |= differs("static encrypt", ref ? run([&] { return ref->encrypt(text); }) : failed,
+                            core(true, key, text), report);
+        diverged |= differs("static decrypt", ref ? run([&] { return ref->decrypt(text); }) : failed,
+                            core(false, key, text), report);
+    }
+    delete ref;
+    delete got;
+    return diverged;
+}
+
+std::vector<std::vector<uint8_t>> edgeCases()
+{
+    // Индексы букв: А = 0, Б = 1, Е = 5, Ё = 6, Я = 32, ё = 39; 205 в ключе — цифра 0
+    return {
+        {},
+        { 0 },
+        { 1, 1, 0, 1, 2 },
+        { 3, 0, 0, 0, 5, 6 },                // ключ из одних А
+        { 2, 0, 1, 0, 0, 0, 0 },             // ровно половина А
+        { 3, 0, 0, 1, 0 },                   // больше половины А
+        { 1, 6, 6, 39, 5, 38 },              // ключ Ё, текст с Ё/ё
+        { 1, 32, 32, 32, 32 },               // сдвиг на Я
+        { 2, 1, 205, 0, 1 },                 // цифра в ключе
+        { 16, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20 },
+        { 1, 1, 80, 81, 82, 83 },            // текст без букв
+        { 1, 1, 103, 104, 107, 0, 1 },       // посторонняя кириллица в тексте
+    };
+}
@@ -0,0 +1,163 @@
+/**
+ * @file fuzz_main.cpp
+ * @brief Автономный драйвер дифференциального фаззинга (без libFuzzer)
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Использование:
+ * @code
+ * fuzz_gronsfeld [-runs N] [-seed S] [-max_len L]   случайное тестирование
+ * fuzz_gronsfeld ФАЙЛ...                            воспроизведение входов
+ * @endcode
+ * Сначала проверяются входы крайних случаев цели, затем N случайных входов
+ * и их мутаций. Первое расхождение минимизируется (удалением фрагментов и
+ * упрощением байтов), печатается вместе с шестнадцатеричной записью входа и
+ * сохраняется в файл divergence-ЗЕРНО-НОМЕР, который можно передать этой же
+ * программе или цели libFuzzer для воспроизведения.
+ */
+
+#include "fuzz.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+bool diverges(const vector<uint8_t>& in)
+{
+    string report;
+    return fuzzOne(in.data(), in.size(), report);
+}
+
+/**
+ * @brief Уменьшает вход, сохраняя расхождение
+ * @param[in] in Вход, на котором реализации расходятся
+ * @return Минимизированный вход
+ */
+vector<uint8_t> minimize(vector<uint8_t> in)
+{
+    for (size_t chunk = in.size() / 2; chunk >= 1; chunk /= 2) {
+        for (size_t i = 0; i + chunk <= in.size();) {
+            vector<uint8_t> candidate(in.begin(), in.begin() + i);
+            candidate.insert(candidate.end(), in.begin() + i + chunk, in.end());
+            if (diverges(candidate))
+                in = candidate;
+            else
+                i += chunk;
+        }
+    }
+    for (size_t i = 0; i < in.size(); i++) {
+        if (in[i] == 0)
+            continue;
+        vector<uint8_t> candidate = in;
+        candidate[i] = 0;
+        if (diverges(candidate))
+            in = candidate;
+    }
+    return in;
+}
+
+/// Печатает отчёт о расхождении и сохраняет вход в файл
+void reportDivergence(const vector<uint8_t>& in, const string& file)
+{
+    string report;
+    fuzzOne(in.data(), in.size(), report);
+    cerr << "DIVERGENCE (" << in.size() << " bytes)\n" << report << "input:";
+    for (uint8_t b : in) {
+        char hex[4];
+        snprintf(hex, sizeof(hex), " %02x", b);
+        cerr << hex;
+    }
+    cerr << endl;
+    ofstream(file, ios::binary).write(reinterpret_cast<const char*>(in.data()), in.size());
+    cerr << "reproducer written to " << file << endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    LLVMFuzzerInitialize(&argc, &argv);
+
+    unsigned long runs = 100000;
+    unsigned long long seed = 1;
+    size_t maxLen = 4096;
+    vector<string> files;
+    try {
+        for (int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            if (arg == "-runs" && i + 1 < argc)
+                runs = stoul(argv[++i]);
+            else if (arg == "-seed" && i + 1 < argc)
+                seed = stoull(argv[++i]);
+            else if (arg == "-max_len" && i + 1 < argc)
+                maxLen = stoul(argv[++i]);
+            else if (!arg.empty() && arg[0] != '-')
+                files.push_back(arg);
+            else
+                throw invalid_argument("unknown option: " + arg);
+        }
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        cerr << "Usage: " << argv[0] << " [-runs N] [-seed S] [-max_len L] | FILE..." << endl;
+        return 1;
+    }
+
+    if (!files.empty()) {
+        int failures = 0;
+        for (const string& name : files) {
+            ifstream f(name, ios::binary);
+            vector<uint8_t> in((istreambuf_iterator<char>(f)), istreambuf_iterator<char>());
+            string report;
+            if (fuzzOne(in.data(), in.size(), report)) {
+                cerr << name << ": DIVERGENCE\n" << report;
+                failures++;
+            }
+        }
+        return failures ? 1 : 0;
+    }
+
+    vector<vector<uint8_t>> seeds = edgeCases();
+    for (size_t i = 0; i < seeds.size(); i++) {
+        if (diverges(seeds[i])) {
+            reportDivergence(minimize(seeds[i]), "divergence-edge-" + to_string(i));
+            return 1;
+        }
+    }
+
+    mt19937_64 rng(seed);
+    for (unsigned long run = 0; run < runs; run++) {
+        vector<uint8_t> in;
+        if (rng() % 4 == 0) {
+            // Мутация входа крайнего случая
+            in = seeds[rng() % seeds.size()];
+            for (int k = rng() % 4; k >= 0; k--) {
+                if (!in.empty() && rng() % 2)
+                    in[rng() % in.size()] = static_cast<uint8_t>(rng());
+                else
+                    in.push_back(static_cast<uint8_t>(rng()));
+            }
+        } else {
+            // Чаще короткие входы, реже длинные
+            size_t limit = rng() % 10 == 0 ? maxLen : rng() % 2 ? 64 : 16;
+            in.resize(rng() % (limit + 1));
+            for (auto& b : in)
+                b = static_cast<uint8_t>(rng());
+        }
+        if (diverges(in)) {
+            reportDivergence(minimize(in), "divergence-" + to_string(seed) + "-" + to_string(run));
+            return 1;
+        }
+        if ((run + 1) % 100000 == 0)
+            cerr << "#" << run + 1 << endl;
+    }
+    cerr << "OK: " << seeds.size() << " edge cases and " << runs << " random inputs, no divergence" << endl;
+    return 0;
+}
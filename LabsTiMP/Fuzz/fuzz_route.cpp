@@ -0,0 +1,276 @@
+/**
+ * @file fuzz_route.cpp
+ * @brief Цель дифференциального фаззинга шифра табличной маршрутной перестановки
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Формат входа: байт режима, четыре байта параметра ключа, остальные байты —
+ * текст. Режим задаёт способ получения числа столбцов:
+ * 0 — от 1 до 16; 1 — длина текста плюс смещение от -128 до 127;
+ * 2 — произвольное 32-битное число (в том числе 0, отрицательное и INT_MAX);
+ * 3 — от 1 до 1024. Сравниваются конструктор, encrypt(текст), decrypt(текст),
+ * decrypt(encrypt(текст)), варианты encrypt/decrypt с памятью из арены
+ * std::pmr, encrypt в буфер вызывающего, ядро route_static (оно же
+ * проверяется при компиляции) и шифртекст, собранный по маршруту
+ * RouteCipher::route целиком и двумя диапазонами RouteCipher::routeRange,
+ * а также открытый текст, расшифрованный двумя диапазонами decryptRange.
+ * Старшие биты параметра выбирают маршруты записи и считывания RouteSpec:
+ * RouteCipher с этими маршрутами и RoutePlan сравниваются с эталонной
+ * таблицей reference::routeOrder.
+ */
+
+#include "fuzz.h"
+#include "reference.h"
+#include "../Lab4/route_cipher.h"
+#include "../Lab4/keyword_cipher.h"
+#include <memory_resource>
+
+namespace {
+
+// Зашифрование при компиляции совпадает с RouteCipher(4).encrypt
+static_assert(route_static::encrypt(4, L"ШИФР ТАБЛИЧНОЙ ПЕРЕСТАНОВКИ").equals(L"РЛОРАКИНЕЙИТШФБНЕТВОСПЧАИ"),
+              "compile-time route encryption differs from RouteCipher");
+static_assert(route_static::decrypt(4, route_static::encrypt(4, L"шифр")).equals(L"ШИФР"),
+              "compile-time route decryption is not the inverse of encryption");
+
+/// Вызов ядра route_static с выходным буфером
+Outcome core(bool encrypt, int columns, const std::wstring& text)
+{
+    return run([&] {
+        std::vector<wchar_t> letters(text.size() + 1), out(text.size() + 1);
+        std::size_t n = encrypt
+            ? route_static::encryptInto(columns, text.data(), text.size(), letters.data(), out.data())
+            : route_static::decryptInto(columns, text.data(), text.size(), out.data());
+        return std::wstring(out.data(), n);
+    });
+}
+
+bool differs(const char* op, const Outcome& ref, const Outcome& got, std::string& report)
+{
+    if (ref == got)
+        return false;
+    report += std::string(op) + ": reference " + describe(ref) + ", RouteCipher " + describe(got) + "\n";
+    return true;
+}
+
+/**
+ * @brief Вызов с памятью из арены: малый начальный буфер на стеке, остальное
+ *        из вышестоящего источника, чтобы проверялись обе ветви арены
+ */
+std::wstring arena(const std::wstring& text, bool encrypt, RouteCipher& cipher)
+{
+    char buffer[64];
+    std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer));
+    std::pmr::wstring result = encrypt ? cipher.encrypt(text, &resource) : cipher.decrypt(text, &resource);
+    return std::wstring(result.begin(), result.end());
+}
+
+/**
+ * @brief Сравнение маршрутов spec с эталонной таблицей
+ * @details Ошибки текста от маршрута не зависят, поэтому проверяются по
+ *          эталону маршрута по умолчанию, а результат — перестановкой
+ *          reference::routeOrder нормализованного текста.
+ */
+bool routes(const RouteSpec& spec, int columns, const std::wstring& text, std::int64_t split, reference::Route& ref,
+            std::string& report)
+{
+    std::string name = std::string(" ") + routeName(spec.write) + ":" + routeName(spec.read);
+    RouteCipher cipher(columns, spec);
+    Outcome refEnc = run([&] { return ref.encrypt(text); });
+    Outcome refDec = run([&] { return ref.decrypt(text); });
+    Outcome expectEnc = refEnc, expectDec = refDec;
+    std::wstring open;
+    if (!refEnc.failed) {
+        open = ref.decrypt(refEnc.value);
+        std::vector<std::int64_t> order = reference::routeOrder(routeName(spec.write), routeName(spec.read), columns,
+                                                                static_cast<std::int64_t>(open.size()));
+        for (std::size_t k = 0; k < order.size(); k++)
+            expectEnc.value[k] = open[order[k]];
+    }
+    if (!refDec.failed) {
+        std::vector<std::int64_t> order = reference::routeOrder(routeName(spec.write), routeName(spec.read), columns,
+                                                                static_cast<std::int64_t>(text.size()));
+        for (std::size_t k = 0; k < order.size(); k++)
+            expectDec.value[order[k]] = text[k];
+    }
+
+    bool diverged = differs(("encrypt" + name).c_str(), expectEnc, run([&] { return cipher.encrypt(text); }), report);
+    diverged |= differs(("encrypt(buffer)" + name).c_str(), expectEnc, run([&] {
+        std::vector<wchar_t> out(text.size() + 1);
+        return std::wstring(out.data(), cipher.encrypt(text.data(), text.size(), out.data()));
+    }), report);
+    diverged |= differs(("decrypt" + name).c_str(), expectDec, run([&] { return cipher.decrypt(text); }), report);
+    if (!refEnc.failed) {
+        diverged |= differs(("decrypt(encrypt)" + name).c_str(), Outcome{ false, open },
+                            run([&] { return cipher.decrypt(expectEnc.value); }), report);
+        // План, собранный двумя диапазонами, и обход routeRange
+        std::int64_t length = static_cast<std::int64_t>(open.size());
+        split = std::min(split, length);
+        diverged |= differs(("plan" + name).c_str(), expectEnc, run([&] {
+            RoutePlan plan(spec, columns, length);
+            std::wstring gathered(open.size(), L'\0');
+            plan.gather(open.data(), 0, split, &gathered[0]);
+            plan.gather(open.data(), split, length, &gathered[split]);
+            return gathered;
+        }), report);
+        diverged |= differs(("routeRange" + name).c_str(), expectEnc, run([&] {
+            std::wstring gathered;
+            cipher.routeRange(length, 0, split, [&](std::int64_t i) { gathered += open[i]; });
+            cipher.routeRange(length, split, length, [&](std::int64_t i) { gathered += open[i]; });
+            return gathered;
+        }), report);
+        diverged |= differs(("decryptRange" + name).c_str(), Outcome{ false, open }, run([&] {
+            return cipher.decryptRange(expectEnc.value, 0, split)
+                + cipher.decryptRange(expectEnc.value, split, length - split);
+        }), report);
+    }
+    return diverged;
+}
+
+/**
+ * @brief Вертикальная перестановка с ключевым словом против эталонной таблицы
+ * @details Слово из 1..37 букв выбирается по param; проверку текста и буквы
+ *          в исходном порядке даёт эталонный маршрутный шифр с одним столбцом.
+ */
+bool keyword(uint32_t param, const std::wstring& text, std::string& report)
+{
+    const std::wstring alphabet = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+    std::wstring word;
+    uint32_t x = param;
+    for (uint32_t n = 1 + param % 37; n > 0; n--) {
+        x = x * 1103515245u + 12345u;
+        word += alphabet[(x >> 16) % alphabet.size()];
+    }
+    std::string name = " " + toUtf8(word);
+    KeywordCipher cipher(word);
+    reference::Route letters(1);
+    Outcome expectEnc = run([&] { return letters.encrypt(text); });
+    Outcome expectDec = run([&] { return letters.decrypt(text); });
+    std::wstring open = expectEnc.value, closed = expectDec.value;
+    if (!expectEnc.failed) {
+        std::vector<std::int64_t> order = reference::keywordOrder(word, static_cast<std::int64_t>(open.size()));
+        for (std::size_t k = 0; k < order.size(); k++)
+            expectEnc.value[k] = open[order[k]];
+    }
+    if (!expectDec.failed) {
+        std::vector<std::int64_t> order = reference::keywordOrder(word, static_cast<std::int64_t>(closed.size()));
+        for (std::size_t k = 0; k < order.size(); k++)
+            expectDec.value[order[k]] = closed[k];
+    }
+    bool diverged = differs(("keyword encrypt" + name).c_str(), expectEnc, run([&] { return cipher.encrypt(text); }),
+                            report);
+    diverged |= differs(("keyword decrypt" + name).c_str(), expectDec, run([&] { return cipher.decrypt(text); }),
+                        report);
+    if (!expectEnc.failed) {
+        diverged |= differs(("keyword decrypt(encrypt)" + name).c_str(), Outcome{ false, open },
+                            run([&] { return cipher.decrypt(expectEnc.value); }), report);
+    }
+    return diverged;
+}
+
+} // namespace
+
+bool fuzzOne(const uint8_t* data, std::size_t size, std::string& report)
+{
+    FuzzReader in(data, size);
+    uint8_t mode = in.byte() % 4;
+    uint32_t param = in.u32();
+    std::wstring text = in.text();
+
+    int columns;
+    switch (mode) {
+    case 0:
+        columns = 1 + param % 16;
+        break;
+    case 1:
+        columns = static_cast<int>(text.size()) + static_cast<int8_t>(param & 0xFF);
+        break;
+    case 2:
+        columns = static_cast<int32_t>(param);
+        break;
+    default:
+        columns = 1 + param % 1024;
+        break;
+    }
+    report = "columns=" + std::to_string(columns) + " text=\"" + toUtf8(text) + "\"\n";
+
+    reference::Route* ref = nullptr;
+    RouteCipher* got = nullptr;
+    Outcome refKey = run([&] { ref = new reference::Route(columns); return std::wstring(); });
+    Outcome gotKey = run([&] { got = new RouteCipher(columns); return std::wstring(); });
+    bool diverged = differs("constructor", refKey, gotKey, report);
+
+    if (ref && got) {
+        Outcome refEnc = run([&] { return ref->encrypt(text); });
+        Outcome gotEnc = run([&] { return got->encrypt(text); });
+        diverged |= differs("encrypt", refEnc, gotEnc, report);
+        diverged |= differs("decrypt", run([&] { return ref->decrypt(text); }),
+                            run([&] { return got->decrypt(text); }), report);
+        diverged |= differs("encrypt(pmr)", refEnc, run([&] { return arena(text, true, *got); }), report);
+        diverged |= differs("decrypt(pmr)", run([&] { return ref->decrypt(text); }),
+                            run([&] { return arena(text, false, *got); }), report);
+        diverged |= differs("encrypt(buffer)", refEnc, run([&] {
+            std::vector<wchar_t> out(text.size() + 1);
+            return std::wstring(out.data(), got->encrypt(text.data(), text.size(), out.data()));
+        }), report);
+        if (!refEnc.failed) {
+            Outcome refDec = run([&] { return ref->decrypt(refEnc.value); });
+            diverged |= differs("decrypt(encrypt)", refDec, run([&] { return got->decrypt(refEnc.value); }), report);
+            // Сборка шифртекста по маршруту RouteCipher::route из нормализованного текста
+            const std::wstring& open = refDec.value;
+            diverged |= differs("route", refEnc, run([&] {
+                std::wstring gathered;
+                got->route(static_cast<std::int64_t>(open.size()), [&](std::int64_t i) { gathered += open[i]; });
+                return gathered;
+            }), report);
+            // Та же сборка двумя диапазонами RouteCipher::routeRange
+            std::int64_t length = static_cast<std::int64_t>(open.size());
+            std::int64_t split = static_cast<std::int64_t>((param >> 8) % (open.size() + 1));
+            diverged |= differs("routeRange", refEnc, run([&] {
+                std::wstring gathered;
+                got->routeRange(length, 0, split, [&](std::int64_t i) { gathered += open[i]; });
+                got->routeRange(length, split, length, [&](std::int64_t i) { gathered += open[i]; });
+                return gathered;
+            }), report);
+            // Расшифрование двумя диапазонами открытого текста
+            diverged |= differs("decryptRange", refDec, run([&] {
+                return got->decryptRange(refEnc.value, 0, split)
+                    + got->decryptRange(refEnc.value, split, open.size() - split);
+            }), report);
+        }
+        RouteSpec spec;
+        spec.write = static_cast<Route>((param >> 24) % 5);
+        spec.read = static_cast<Route>((param >> 27) % 8);
+        diverged |= routes(spec, columns, text, static_cast<std::int64_t>((param >> 8) % (text.size() + 1)), *ref, report);
+    }
+    diverged |= keyword(param, text, report);
+    Outcome failed{ true, std::wstring() };
+    diverged |= differs("static encrypt", ref ? run([&] { return ref->encrypt(text); }) : failed,
+                        core(true, columns, text), report);
+    diverged |= differs("static decrypt", ref ? run([&] { return ref->decrypt(text); }) : failed,
+                        core(false, columns, text), report);
+    delete ref;
+    delete got;
+    return diverged;
+}
+
+std::vector<std::vector<uint8_t>> edgeCases()
+{
+    // Индексы символов: А = 0, Ё = 6, Я = 32, ё = 39, 80 — пробел, 99 — латинская A
+    return {
+        {},
+        { 0, 0, 0, 0, 0 },
+        { 0, 0, 0, 0, 0, 15, 17, 8, 2, 5, 19 },           // один столбец
+        { 1, 0, 0, 0, 0, 15, 17, 8, 2, 5, 19 },           // столбцов ровно по длине текста
+        { 1, 5, 0, 0, 0, 15, 17, 8, 2, 5, 19 },           // столбцов больше, чем букв
+        { 2, 0xFF, 0xFF, 0xFF, 0x7F, 15, 17, 8, 2, 5 },   // INT_MAX столбцов
+        { 2, 0, 0, 0, 0, 15, 17 },                        // ноль столбцов
+        { 2, 0xFD, 0xFF, 0xFF, 0xFF, 15, 17 },            // отрицательное число столбцов
+        { 0, 2, 0, 0, 0, 80, 80, 80 },                    // только пробелы
+        { 0, 2, 0, 0, 0, 6, 39, 80, 6, 39, 5 },           // Ё/ё
+        { 0, 3, 0, 0, 0, 15, 99, 17 },                    // латиница
+        { 3, 7, 0, 0, 0, 15, 17, 8, 2, 5, 19, 13, 8, 17, 80, 11, 0, 11, 4, 5, 11, 0 },
+    };
+}
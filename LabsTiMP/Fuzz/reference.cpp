@@ -0,0 +1,340 @@
+/**
+ * @file reference.cpp
+ * @brief Эталонные реализации шифров (копия исходных табличных алгоритмов)
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "reference.h"
+#include <algorithm>
+#include <cwctype>
+
+namespace reference {
+
+namespace {
+
+wchar_t toUpperRussian(wchar_t c)
+{
+    if (c >= L'а' && c <= L'п')
+        return c - (L'а' - L'А');
+    if (c >= L'р' && c <= L'я')
+        return c - (L'р' - L'Р');
+    if (c == L'ё')
+        return L'Ё';
+    return c;
+}
+
+bool isRussianLetter(wchar_t c)
+{
+    return (c >= L'А' && c <= L'Я') || c == L'Ё' || (c >= L'а' && c <= L'я') || c == L'ё';
+}
+
+} // namespace
+
+Gronsfeld::Gronsfeld(const std::wstring& skey)
+{
+    for (unsigned i = 0; i < numAlpha.size(); i++)
+        alphaNum[numAlpha[i]] = i;
+    key = convert(getValidKey(skey));
+}
+
+std::wstring Gronsfeld::encrypt(const std::wstring& open_text)
+{
+    std::vector<int> work = convert(getValidOpenText(open_text));
+    for (size_t i = 0; i < work.size(); i++)
+        work[i] = (work[i] + key[i % key.size()]) % numAlpha.size();
+    return convert(work);
+}
+
+std::wstring Gronsfeld::decrypt(const std::wstring& cipher_text)
+{
+    std::vector<int> work = convert(getValidCipherText(cipher_text));
+    for (size_t i = 0; i < work.size(); i++)
+        work[i] = (work[i] + numAlpha.size() - key[i % key.size()]) % numAlpha.size();
+    return convert(work);
+}
+
+std::vector<int> Gronsfeld::convert(const std::wstring& s)
+{
+    std::vector<int> result;
+    for (auto c : s) {
+        auto it = alphaNum.find(c);
+        if (it == alphaNum.end())
+            throw std::invalid_argument("invalid character in text");
+        result.push_back(it->second);
+    }
+    return result;
+}
+
+std::wstring Gronsfeld::convert(const std::vector<int>& v)
+{
+    std::wstring result;
+    for (auto i : v)
+        result.push_back(numAlpha[i]);
+    return result;
+}
+
+std::wstring Gronsfeld::getValidKey(const std::wstring& s)
+{
+    if (s.empty())
+        throw std::invalid_argument("empty key");
+    for (auto c : s) {
+        if (!iswalpha(c))
+            throw std::invalid_argument("invalid character in key");
+    }
+    std::wstring tmp;
+    for (auto c : s) {
+        if (iswalpha(c))
+            tmp.push_back(towupper(c));
+    }
+    if (tmp.empty())
+        throw std::invalid_argument("key has no letters");
+    int countA = 0;
+    for (auto c : tmp) {
+        if (c == L'А')
+            countA++;
+    }
+    if (static_cast<double>(countA) / tmp.size() > 0.5)
+        throw std::invalid_argument("weak key");
+    return tmp;
+}
+
+std::wstring Gronsfeld::getValidOpenText(const std::wstring& s)
+{
+    std::wstring tmp;
+    for (auto c : s) {
+        if (iswalpha(c))
+            tmp.push_back(towupper(c));
+    }
+    if (tmp.empty())
+        throw std::invalid_argument("empty open text");
+    return tmp;
+}
+
+std::wstring Gronsfeld::getValidCipherText(const std::wstring& s)
+{
+    if (s.empty())
+        throw std::invalid_argument("empty cipher text");
+    for (auto c : s) {
+        if (!iswalpha(c))
+            throw std::invalid_argument("invalid character in cipher text");
+    }
+    return s;
+}
+
+Route::Route(int cols) : columns(cols)
+{
+    if (cols <= 0)
+        throw std::invalid_argument("columns must be positive");
+}
+
+std::wstring Route::encrypt(const std::wstring& text)
+{
+    if (text.empty())
+        return L"";
+    std::wstring processedText;
+    for (wchar_t c : text) {
+        if (c != L' ') {
+            if (!isRussianLetter(c))
+                throw std::invalid_argument("text must contain only Russian letters and spaces");
+            processedText += toUpperRussian(c);
+        }
+    }
+    if (processedText.empty())
+        throw std::invalid_argument("text must contain at least one letter");
+
+    int textLength = processedText.length();
+    int columns = std::min(this->columns, textLength);
+    int rows = (textLength + columns - 1) / columns;
+    std::vector<std::vector<wchar_t>> table(rows, std::vector<wchar_t>(columns, L' '));
+    int index = 0;
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < columns; ++j) {
+            if (index < textLength)
+                table[i][j] = processedText[index++];
+        }
+    }
+
+    std::wstring result;
+    int top = 0, bottom = rows - 1;
+    int left = 0, right = columns - 1;
+    while (top <= bottom && left <= right) {
+        for (int i = top; i <= bottom; ++i) {
+            if (table[i][right] != L' ')
+                result += table[i][right];
+        }
+        right--;
+        if (top <= bottom) {
+            for (int j = right; j >= left; --j) {
+                if (table[bottom][j] != L' ')
+                    result += table[bottom][j];
+            }
+            bottom--;
+        }
+        if (left <= right) {
+            for (int i = bottom; i >= top; --i) {
+                if (table[i][left] != L' ')
+                    result += table[i][left];
+            }
+            left++;
+        }
+    }
+    return result;
+}
+
+std::wstring Route::decrypt(const std::wstring& cipherText)
+{
+    if (cipherText.empty())
+        return L"";
+    for (wchar_t c : cipherText) {
+        if (!isRussianLetter(std::towupper(c)))
+            throw std::invalid_argument("cipher text must contain only Russian letters");
+    }
+
+    int textLength = cipherText.length();
+    int columns = std::min(this->columns, textLength);
+    int rows = (textLength + columns - 1) / columns;
+    std::vector<std::vector<wchar_t>> table(rows, std::vector<wchar_t>(columns, L' '));
+    std::vector<std::vector<bool>> filled(rows, std::vector<bool>(columns, false));
+    int index = 0;
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < columns; ++j) {
+            if (index < textLength)
+                filled[i][j] = true;
+            index++;
+        }
+    }
+
+    int top = 0, bottom = rows - 1;
+    int left = 0, right = columns - 1;
+    index = 0;
+    while (top <= bottom && left <= right && index < textLength) {
+        for (int i = top; i <= bottom && index < textLength; ++i) {
+            if (filled[i][right])
+                table[i][right] = cipherText[index++];
+        }
+        right--;
+        if (top <= bottom) {
+            for (int j = right; j >= left && index < textLength; --j) {
+                if (filled[bottom][j])
+                    table[bottom][j] = cipherText[index++];
+            }
+            bottom--;
+        }
+        if (left <= right) {
+            for (int i = bottom; i >= top && index < textLength; --i) {
+                if (filled[i][left])
+                    table[i][left] = cipherText[index++];
+            }
+            left++;
+        }
+    }
+    if (index != textLength)
+        throw std::invalid_argument("not all characters were placed in table");
+
+    std::wstring result;
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < columns; ++j) {
+            if (filled[i][j])
+                result += table[i][j];
+        }
+    }
+    return result;
+}
+
+namespace {
+
+/// Все ячейки таблицы rows x columns (номер строки * columns + номер столбца) в порядке маршрута
+std::vector<std::int64_t> cells(const std::string& route, std::int64_t rows, std::int64_t columns)
+{
+    std::vector<std::int64_t> order;
+    if (route == "rows" || route == "reversed-rows" || route == "row-snake") {
+        for (std::int64_t i = 0; i < rows; ++i) {
+            bool reversed = route == "reversed-rows" || (route == "row-snake" && i % 2 == 1);
+            for (std::int64_t j = 0; j < columns; ++j)
+                order.push_back(i * columns + (reversed ? columns - 1 - j : j));
+        }
+    } else if (route == "columns" || route == "column-snake") {
+        for (std::int64_t j = 0; j < columns; ++j) {
+            bool reversed = route == "column-snake" && j % 2 == 1;
+            for (std::int64_t i = 0; i < rows; ++i)
+                order.push_back((reversed ? rows - 1 - i : i) * columns + j);
+        }
+    } else if (route == "diagonal") {
+        for (std::int64_t d = 0; d < rows + columns - 1; ++d) {
+            for (std::int64_t i = 0; i < rows; ++i) {
+                if (d - i >= 0 && d - i < columns)
+                    order.push_back(i * columns + d - i);
+            }
+        }
+    } else if (route == "spiral" || route == "counter-spiral") {
+        // Витки как в Route::encrypt, для counter-spiral столбцы отражены
+        bool mirror = route == "counter-spiral";
+        auto cell = [&](std::int64_t i, std::int64_t j) { return i * columns + (mirror ? columns - 1 - j : j); };
+        std::int64_t top = 0, bottom = rows - 1;
+        std::int64_t left = 0, right = columns - 1;
+        while (top <= bottom && left <= right) {
+            for (std::int64_t i = top; i <= bottom; ++i)
+                order.push_back(cell(i, right));
+            right--;
+            for (std::int64_t j = right; j >= left; --j)
+                order.push_back(cell(bottom, j));
+            bottom--;
+            if (left <= right) {
+                for (std::int64_t i = bottom; i >= top; --i)
+                    order.push_back(cell(i, left));
+                left++;
+            }
+        }
+    } else {
+        throw std::invalid_argument("unknown route");
+    }
+    return order;
+}
+
+} // namespace
+
+std::vector<std::int64_t> routeOrder(const std::string& write, const std::string& read, std::int64_t columns,
+                                     std::int64_t textLength)
+{
+    if (textLength <= 0)
+        return std::vector<std::int64_t>();
+    columns = std::min(columns, textLength);
+    std::int64_t rows = (textLength + columns - 1) / columns;
+    std::vector<std::int64_t> letter(rows * columns, -1);
+    std::vector<std::int64_t> written = cells(write, rows, columns);
+    for (std::int64_t k = 0; k < textLength; ++k)
+        letter[written[k]] = k;
+    std::vector<std::int64_t> result;
+    for (std::int64_t cell : cells(read, rows, columns)) {
+        if (letter[cell] >= 0)
+            result.push_back(letter[cell]);
+    }
+    return result;
+}
+
+std::vector<std::int64_t> keywordOrder(const std::wstring& keyword, std::int64_t textLength)
+{
+    const std::wstring alphabet = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+    std::int64_t columns = static_cast<std::int64_t>(keyword.size());
+    std::int64_t rows = (textLength + columns - 1) / columns;
+    std::vector<std::vector<std::int64_t>> table(rows, std::vector<std::int64_t>(columns, -1));
+    for (std::int64_t k = 0; k < textLength; ++k)
+        table[k / columns][k % columns] = k;
+    std::vector<std::int64_t> result;
+    for (wchar_t letter : alphabet) {
+        for (std::int64_t j = 0; j < columns; ++j) {
+            if (keyword[j] != letter)
+                continue;
+            for (std::int64_t i = 0; i < rows; ++i) {
+                if (table[i][j] >= 0)
+                    result.push_back(table[i][j]);
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace reference
@@ -0,0 +1,83 @@
+/**
+ * @file reference.h
+ * @brief Эталонные реализации шифров для дифференциального тестирования
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Здесь зафиксированы исходные табличные реализации шифра Гронсфельда
+ * (Lab3/GronsveldMethod) и маршрутной перестановки (Lab4). Любая быстрая
+ * реализация обязана давать на тех же входах тот же результат или ту же
+ * ошибку. Эти файлы не оптимизируются и меняются только вместе с
+ * намеренным изменением поведения шифров.
+ */
+
+#pragma once
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace reference {
+
+/**
+ * @brief Эталонный шифр Гронсфельда с русским алфавитом из 33 букв
+ * @throw std::invalid_argument При тех же ошибках ключа и текста, что и modAlphaCipher
+ */
+class Gronsfeld {
+private:
+    std::wstring numAlpha = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+    std::map<wchar_t, int> alphaNum;
+    std::vector<int> key;
+
+    std::vector<int> convert(const std::wstring& s);
+    std::wstring convert(const std::vector<int>& v);
+    std::wstring getValidKey(const std::wstring& s);
+    std::wstring getValidOpenText(const std::wstring& s);
+    std::wstring getValidCipherText(const std::wstring& s);
+
+public:
+    explicit Gronsfeld(const std::wstring& skey);
+    std::wstring encrypt(const std::wstring& open_text);
+    std::wstring decrypt(const std::wstring& cipher_text);
+};
+
+/**
+ * @brief Эталонный шифр табличной маршрутной перестановки
+ * @throw std::invalid_argument При тех же ошибках ключа и текста, что и RouteCipher
+ */
+class Route {
+private:
+    int columns;
+
+public:
+    explicit Route(int cols);
+    std::wstring encrypt(const std::wstring& text);
+    std::wstring decrypt(const std::wstring& cipherText);
+};
+
+/**
+ * @brief Эталонная перестановка для маршрутов записи и считывания
+ * @details Таблица min(columns, textLength) столбцов строится целиком:
+ *          первые textLength ячеек маршрута записи получают номера букв,
+ *          затем ячейки читаются маршрутом считывания с пропуском пустых.
+ * @param[in] write Имя маршрута записи (как у routeName)
+ * @param[in] read Имя маршрута считывания
+ * @return Номера букв открытого текста в порядке шифртекста
+ */
+std::vector<std::int64_t> routeOrder(const std::string& write, const std::string& read, std::int64_t columns,
+                                     std::int64_t textLength);
+
+/**
+ * @brief Эталонная перестановка вертикальной перестановки с ключевым словом
+ * @details Таблица по строкам из keyword.size() столбцов строится целиком
+ *          (vector<vector<int64_t>>), номер столбца в порядке считывания —
+ *          место его буквы в алфавите «А..Я», равные буквы — слева направо.
+ * @param[in] keyword Ключевое слово из прописных русских букв
+ * @return Номера букв открытого текста в порядке шифртекста
+ */
+std::vector<std::int64_t> keywordOrder(const std::wstring& keyword, std::int64_t textLength);
+
+} // namespace reference
@@ -0,0 +1,182 @@
+// Ядро шифра Гронсфельда, пригодное для вычислений во время компиляции (C++17)
+//
+// Алфавит, проверка ключа и сдвиг повторяют modAlphaCipher, но не зависят
+// от локали и не требуют создания объекта, поэтому строковые константы
+// можно зашифровать при компиляции:
+//
+//     constexpr auto secret = gronsfeld_static::encrypt(L"КЛЮЧ", L"Секретная строка");
+//     std::wstring open = gronsfeld_static::decrypt(L"КЛЮЧ", secret).str();
+//
+// Классы символов (iswalpha, towupper) ядро знает только для ASCII и русских
+// букв; для них результат совпадает с modAlphaCipher в локали ru_RU.UTF-8.
+// Заголовок не определяет cipher_error: ошибки во время выполнения
+// сообщаются исключением std::invalid_argument с тем же текстом, что и у
+// modAlphaCipher, а при вычислении во время компиляции дают ошибку компиляции.
+
+#pragma once
+#if __cplusplus < 201703L
+#error "gronsfeld_static.h requires C++17"
+#endif
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace gronsfeld_static {
+
+// Алфавит в порядке RussianAlphabet::letters (modAlphaCipher.h)
+constexpr wchar_t alphabet[] = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+constexpr int alphabetSize = sizeof(alphabet) / sizeof(alphabet[0]) - 1;
+
+// Номер символа в алфавите или -1
+constexpr int letterIndex(wchar_t c)
+{
+    for (int i = 0; i < alphabetSize; i++) {
+        if (alphabet[i] == c)
+            return i;
+    }
+    return -1;
+}
+
+constexpr bool isRussian(wchar_t c)
+{
+    return (c >= L'А' && c <= L'я') || c == L'Ё' || c == L'ё';
+}
+
+// Символ, классы которого известны ядру
+constexpr bool supported(wchar_t c)
+{
+    return (c >= 0 && c < 0x80) || isRussian(c);
+}
+
+// iswalpha для поддерживаемых символов
+constexpr bool isAlpha(wchar_t c)
+{
+    return (c >= L'a' && c <= L'z') || (c >= L'A' && c <= L'Z') || isRussian(c);
+}
+
+// towupper для поддерживаемых символов
+constexpr wchar_t toUpper(wchar_t c)
+{
+    if ((c >= L'a' && c <= L'z') || (c >= L'а' && c <= L'я'))
+        return c - 0x20;
+    return c == L'ё' ? L'Ё' : c;
+}
+
+constexpr void checkSupported(wchar_t c)
+{
+    if (!supported(c))
+        throw std::invalid_argument("Символ вне ASCII и русского алфавита");
+}
+
+// Проверка ключа в порядке modAlphaCipher::getValidKey и convert
+constexpr void checkKey(const wchar_t* key, std::size_t length)
+{
+    if (length == 0)
+        throw std::invalid_argument("Пустой ключ");
+    std::size_t countA = 0;
+    for (std::size_t i = 0; i < length; i++) {
+        checkSupported(key[i]);
+        if (!isAlpha(key[i]))
+            throw std::invalid_argument("Недопустимый символ в ключе");
+        if (toUpper(key[i]) == L'А')
+            countA++;
+    }
+    if (2 * countA > length)
+        throw std::invalid_argument("Слабый ключ: более 50% букв А");
+    for (std::size_t i = 0; i < length; i++) {
+        if (letterIndex(toUpper(key[i])) < 0)
+            throw std::invalid_argument("Недопустимый символ в тексте");
+    }
+}
+
+// Зашифрование в память вызывающего (не меньше length символов),
+// возвращает длину шифртекста
+constexpr std::size_t encryptInto(const wchar_t* key, std::size_t keyLength, const wchar_t* text,
+                                  std::size_t length, wchar_t* out)
+{
+    checkKey(key, keyLength);
+    std::size_t n = 0, k = 0;
+    for (std::size_t i = 0; i < length; i++) {
+        checkSupported(text[i]);
+        if (!isAlpha(text[i]))
+            continue;
+        int index = letterIndex(toUpper(text[i]));
+        if (index < 0)
+            throw std::invalid_argument("Недопустимый символ в тексте");
+        out[n++] = alphabet[(index + letterIndex(toUpper(key[k]))) % alphabetSize];
+        if (++k == keyLength)
+            k = 0;
+    }
+    if (n == 0)
+        throw std::invalid_argument("Пустой открытый текст");
+    return n;
+}
+
+// Расшифрование в память вызывающего (не меньше length символов),
+// возвращает длину результата
+constexpr std::size_t decryptInto(const wchar_t* key, std::size_t keyLength, const wchar_t* text,
+                                  std::size_t length, wchar_t* out)
+{
+    checkKey(key, keyLength);
+    if (length == 0)
+        throw std::invalid_argument("Пустой шифртекст");
+    bool foreign = false;
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < length; i++) {
+        checkSupported(text[i]);
+        if (!isAlpha(text[i]))
+            throw std::invalid_argument("Недопустимый символ в шифртексте");
+        int index = letterIndex(text[i]);
+        if (index < 0)
+            foreign = true;
+        else
+            out[i] = alphabet[(index + alphabetSize - letterIndex(toUpper(key[k]))) % alphabetSize];
+        if (++k == keyLength)
+            k = 0;
+    }
+    if (foreign)
+        throw std::invalid_argument("Недопустимый символ в тексте");
+    return length;
+}
+
+// Результат постоянной длины: N — размер массива вместе с завершающим нулём
+template <std::size_t N>
+struct Text {
+    wchar_t data[N] = {};
+    std::size_t size = 0;
+
+    constexpr const wchar_t* c_str() const { return data; }
+    std::wstring str() const { return std::wstring(data, size); }
+    // Совпадает ли результат со строковой константой
+    template <std::size_t M>
+    constexpr bool equals(const wchar_t (&other)[M]) const
+    {
+        if (size != M - 1)
+            return false;
+        for (std::size_t i = 0; i < size; i++) {
+            if (data[i] != other[i])
+                return false;
+        }
+        return true;
+    }
+};
+
+// Шифртекст строковой константы
+template <std::size_t K, std::size_t N>
+constexpr Text<N> encrypt(const wchar_t (&key)[K], const wchar_t (&text)[N])
+{
+    Text<N> result;
+    result.size = encryptInto(key, K - 1, text, N - 1, result.data);
+    return result;
+}
+
+// Открытый текст по шифртексту, полученному encrypt()
+template <std::size_t K, std::size_t N>
+constexpr Text<N> decrypt(const wchar_t (&key)[K], const Text<N>& cipher_text)
+{
+    Text<N> result;
+    result.size = decryptInto(key, K - 1, cipher_text.data, cipher_text.size, result.data);
+    return result;
+}
+
+} // namespace gronsfeld_static
@@ -2,8 +2,10 @@
 
 #include <UnitTest++/UnitTest++.h>
 
+#include <algorithm>
 #include <codecvt>
 #include <iostream>
+#include <iterator>
 #include <locale>
 #include <string>
 
@@ -90,6 +92,211 @@ SUITE(DecryptTest)
     TEST_FIXTURE(KeyB_fixture, EmptyDecrypt) { CHECK_THROW(p->decrypt(L""), cipher_error); }
 }
 
+SUITE(RangeTest)
+{
+    TEST_FIXTURE(KeyB_fixture, DecryptRange) {
+        CHECK_EQUAL(to_utf8(L"ВЕТМ"), to_utf8(p->decryptRange(L"ЯБСДЙЕЬЩЩ", 3, 4)));
+        CHECK_EQUAL(to_utf8(L""), to_utf8(p->decryptRange(L"ЯБСДЙЕЬЩЩ", 9, 0)));
+        }
+    // Читаются только буквы диапазона: ошибка вне его не мешает
+    TEST_FIXTURE(KeyB_fixture, DecryptRangeReadsOnlyRange) {
+        CHECK_EQUAL(to_utf8(L"ИВ"), to_utf8(p->decryptRange(L"ЯБСД1", 2, 2)));
+        CHECK_THROW(p->decryptRange(L"ЯБСД1", 3, 2), cipher_error);
+        }
+    TEST_FIXTURE(KeyB_fixture, DecryptRangeOutside) {
+        CHECK_THROW(p->decryptRange(L"ЯБСДЙЕЬЩЩ", 8, 2), cipher_error);
+        CHECK_THROW(p->decryptRange(L"", 0, 0), cipher_error);
+        }
+}
+
+SUITE(IncrementalTest)
+{
+    // Продолжение и замена дают тот же шифртекст, что и зашифрование целиком
+    TEST_FIXTURE(KeyB_fixture, AppendContinuesKey) {
+        wstring c = p->encrypt(L"ПРИВЕТ");
+        p->append(c, L"ми р!");
+        CHECK_EQUAL(to_utf8(p->encrypt(L"ПРИВЕТМИР")), to_utf8(c));
+        p->append(c, L" ,");
+        CHECK_EQUAL(9, (int)c.size());
+        }
+    TEST_FIXTURE(KeyB_fixture, FragmentsFromKeyPosition) {
+        wstring text = L"ПРИВЕТ, МИР", c(text.size(), L'\0'), d(text.size(), L'\0');
+        size_t n = p->encryptAt(text.data() + 8, 3, 6, &c[0]);
+        n += p->encryptAt(text.data(), 8, 0, &c[n]);
+        CHECK_EQUAL(to_utf8(L"ЬЩЩЯБСДЙЕ"), to_utf8(c.substr(0, n)));
+        CHECK_EQUAL(0, (int)p->encryptAt(L", ", 2, 4, &c[0]));
+        CHECK_EQUAL(3, (int)p->decryptAt(L"ЬЩЩ", 3, 6, &d[0]));
+        CHECK_EQUAL(to_utf8(L"МИР"), to_utf8(d.substr(0, 3)));
+        CHECK_THROW(p->decryptAt(L"Ь1", 2, 6, &d[0]), cipher_error);
+        }
+    TEST_FIXTURE(KeyB_fixture, PatchReplacesRange) {
+        wstring c = p->encrypt(L"ПРИВЕТМИР");
+        CHECK_EQUAL(3, (int)p->patch(c, 6, L"д-о-м"));
+        CHECK_EQUAL(to_utf8(p->encrypt(L"ПРИВЕТДОМ")), to_utf8(c));
+        }
+    TEST_FIXTURE(KeyB_fixture, PatchErrorKeepsCipherText) {
+        wstring c = p->encrypt(L"ПРИВЕТМИР"), old = c;
+        CHECK_THROW(p->patch(c, 7, L"ДОМ"), cipher_error);
+        CHECK_THROW(p->patch(c, 0, L"ДОМ1A"), cipher_error);
+        CHECK_EQUAL(to_utf8(old), to_utf8(c));
+        }
+}
+
+SUITE(ViewTest)
+{
+    TEST_FIXTURE(KeyB_fixture, EncryptView) {
+        wstring text = L"привет, мир!", out;
+        auto view = p->encryptView(text);
+        copy(view.begin(), view.end(), back_inserter(out));
+        CHECK_EQUAL(to_utf8(L"ЯБСДЙЕЬЩЩ"), to_utf8(out));
+        }
+    TEST_FIXTURE(KeyB_fixture, DecryptView) {
+        wstring cipher_text = L"ЯБСДЙЕЬЩЩ", out;
+        auto view = p->decryptView(cipher_text);
+        copy(view.begin(), view.end(), back_inserter(out));
+        CHECK_EQUAL(to_utf8(L"ПРИВЕТМИР"), to_utf8(out));
+        }
+    // Ошибка сообщается при обходе, буквы до неё уже выданы
+    TEST_FIXTURE(KeyB_fixture, ViewThrowsAtBadCharacter) {
+        wstring text = L"ПРИ1ВЕТ", out;
+        auto view = p->decryptView(text);
+        CHECK_THROW(copy(view.begin(), view.end(), back_inserter(out)), cipher_error);
+        CHECK_EQUAL(3, (int)out.size());
+        }
+}
+
+SUITE(StreamTest)
+{
+    // Блоки потока, преобразованные в том же буфере, дают шифртекст всего текста
+    TEST_FIXTURE(KeyB_fixture, StreamBlocks) {
+        wstring text = L"привет, мир!";
+        modAlphaCipher::Stream stream;
+        size_t n = p->encryptBlock(&text[0], 5, stream, &text[0]);
+        n += p->encryptBlock(&text[5], 7, stream, &text[n]);
+        modAlphaCipher::finishEncrypt(stream);
+        CHECK_EQUAL(to_utf8(L"ЯБСДЙЕЬЩЩ"), to_utf8(text.substr(0, n)));
+        }
+    // Ошибки копятся до конца потока; небуква шифртекста важнее буквы не из алфавита
+    TEST_FIXTURE(KeyB_fixture, StreamErrorsAtEnd) {
+        wchar_t out[3];
+        modAlphaCipher::Stream stream;
+        CHECK_EQUAL(3, (int)p->decryptBlock(L"ЯБW", 3, stream, out));
+        CHECK_EQUAL(to_utf8(L"ПР"), to_utf8(wstring(out, 2)));
+        CHECK(stream.foreign && !stream.invalid);
+        p->decryptBlock(L"С1", 2, stream, out);
+        CHECK(stream.invalid);
+        string whole, streamed;
+        try { p->decrypt(L"ЯБWС1"); } catch (const cipher_error& e) { whole = e.what(); }
+        try { modAlphaCipher::finishDecrypt(stream); } catch (const cipher_error& e) { streamed = e.what(); }
+        CHECK_EQUAL(whole, streamed);
+        CHECK_THROW(modAlphaCipher::finishDecrypt(modAlphaCipher::Stream()), cipher_error);
+        CHECK_THROW(modAlphaCipher::finishEncrypt(modAlphaCipher::Stream()), cipher_error);
+        }
+}
+
+SUITE(AlphabetTest)
+{
+    TEST(LatinEncrypt) {
+        CHECK_EQUAL(to_utf8(L"BCDBC"), to_utf8(latinAlphaCipher(L"bcd").encrypt(L"a a-a, aa")));
+        }
+    TEST(LatinWrap) {
+        CHECK_EQUAL(to_utf8(L"AZ"), to_utf8(latinAlphaCipher(L"B").encrypt(L"ZY")));
+        CHECK_EQUAL(to_utf8(L"ZY"), to_utf8(latinAlphaCipher(L"B").decrypt(L"AZ")));
+        }
+    TEST(LatinWeakKey) {
+        CHECK_THROW(latinAlphaCipher(L"AAB"), cipher_error);
+        }
+    TEST(LatinForeignLetter) {
+        CHECK_THROW(latinAlphaCipher(L"B").encrypt(L"HELLO МИР"), cipher_error);
+        }
+    TEST(MixedWrap) {
+        CHECK_EQUAL(to_utf8(L"АA"), to_utf8(mixedAlphaCipher(L"B").encrypt(L"zя")));
+        CHECK_EQUAL(to_utf8(L"ZЯ"), to_utf8(mixedAlphaCipher(L"B").decrypt(L"АA")));
+        }
+    TEST(MixedRussianKey) {
+        CHECK_EQUAL(to_utf8(L"ЩAЩA"), to_utf8(mixedAlphaCipher(L"БA").encrypt(L"za za")));
+        }
+}
+
+SUITE(RunningKeyTest)
+{
+    TEST(SameAsRepeatedKey) {
+        CHECK_EQUAL(to_utf8(modAlphaCipher(L"ПРИВЕТ").encrypt(L"ПРИВЕТ МИР")),
+                    to_utf8(runningKeyCipher().encrypt(L"ПРИВЕТ МИР", L"ПРИВЕТПРИВ")));
+        }
+    TEST(KeySkipsNonLetters) {
+        CHECK_EQUAL(to_utf8(L"БВГБВ"), to_utf8(runningKeyCipher().encrypt(L"ААААА", L"б, в - г!\nБ... в; a ж")));
+        }
+    TEST(RoundTrip) {
+        runningKeyCipher cipher;
+        wstring key = L"Мороз и солнце; день чудесный! Ещё ты дремлешь, друг прелестный";
+        CHECK_EQUAL(to_utf8(L"ПРИВЕТМИР"), to_utf8(cipher.decrypt(cipher.encrypt(L"Привет, мир", key), key)));
+        }
+    TEST(ShortKey) {
+        CHECK_THROW(runningKeyCipher().encrypt(L"ПРИВЕТ", L"КЛЮЧ"), cipher_error);
+        CHECK_THROW(runningKeyCipher().decrypt(L"ПРИВЕТ", L"КЛЮЧ"), cipher_error);
+        }
+    TEST(EmptyText) {
+        CHECK_THROW(runningKeyCipher().encrypt(L"123", L"КЛЮЧ"), cipher_error);
+        CHECK_THROW(runningKeyCipher().decrypt(L"", L"КЛЮЧ"), cipher_error);
+        }
+    // Ключ частями по 3 символа со смещением: тот же результат, что целиком
+    TEST(ChunkedKeyWithOffset) {
+        runningKeyCipher cipher;
+        wstring text = L"Съешь же ещё этих мягких французских булок";
+        wstring key = L"Я помню чудное мгновенье: передо мной явилась ты, как мимолётное виденье";
+        uint64_t offset = 5;
+        size_t start = cipher.skip(key.data(), key.size(), offset);
+        CHECK_EQUAL(0u, offset);
+        wstring expected = cipher.encrypt(text, key.substr(start));
+        wstring result(text.size(), L'\0');
+        size_t read = 0, written = 0;
+        for (size_t k = start; k < key.size() && read < text.size(); k += 3) {
+            size_t n = min<size_t>(3, key.size() - k);
+            runningKeyCipher::Step step = cipher.encrypt(text.data() + read, text.size() - read, key.data() + k, n,
+                                                         &result[written]);
+            CHECK(step.read == text.size() - read || step.keyRead == n);
+            read += step.read;
+            written += step.written;
+        }
+        result.resize(written);
+        CHECK_EQUAL(to_utf8(expected), to_utf8(result));
+        }
+}
+
+SUITE(MultiKeyTest)
+{
+    // Текст длиннее участка, ключи разной длины: строки матрицы совпадают
+    // с шифртекстами отдельных шифров
+    TEST(RowsMatchSingleKeys) {
+        vector<wstring> keys = { L"Б", L"ключ", L"ПРИВЕТ", L"КОРИЧНЕВАЯЛИСА" };
+        wstring text;
+        for (int i = 0; i < 300; i++)
+            text += L"Съешь же ещё этих мягких булок. ";
+        multiKeyCipher cipher(keys);
+        CHECK_EQUAL(keys.size(), cipher.size());
+        wstring matrix = cipher.encrypt(text);
+        size_t n = matrix.size() / keys.size();
+        for (size_t i = 0; i < keys.size(); i++)
+            CHECK(modAlphaCipher(keys[i]).encrypt(text) == matrix.substr(i * n, n));
+        }
+    TEST(LatinKeys) {
+        CHECK_EQUAL(to_utf8(L"BCDBZAZA"), to_utf8(basicMultiKeyCipher<LatinAlphabet>({ L"bcd", L"za" }).encrypt(L"a a-a, a")));
+        }
+    TEST(BadKeys) {
+        CHECK_THROW(multiKeyCipher(vector<wstring>()), cipher_error);
+        CHECK_THROW(multiKeyCipher({ L"КЛЮЧ", L"ААБ" }), cipher_error);
+        CHECK_THROW(multiKeyCipher({ L"КЛЮЧ", L"" }), cipher_error);
+        }
+    TEST(BadTextKeepsOutput) {
+        multiKeyCipher cipher({ L"КЛЮЧ", L"Б" });
+        wstring out(20, L'*');
+        CHECK_THROW(cipher.encrypt(L"ПРИВЕТ W", 8, &out[0]), cipher_error);
+        CHECK_THROW(cipher.encrypt(L" 1 ", 3, &out[0]), cipher_error);
+        CHECK_EQUAL(to_utf8(wstring(20, L'*')), to_utf8(out));
+        }
+}
+
 int main(int argc, char** argv)
 {
     init_locale();
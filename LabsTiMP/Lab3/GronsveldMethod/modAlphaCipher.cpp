@@ -6,57 +6,282 @@
 
 using namespace std;
 
-static const locale loc("ru_RU.UTF-8");
+constexpr wchar_t RussianAlphabet::letters[];
+constexpr wchar_t LatinAlphabet::letters[];
+constexpr wchar_t MixedAlphabet::letters[];
 
-modAlphaCipher::modAlphaCipher(const std::wstring& skey)
+template <class Alphabet>
+CharClasses<Alphabet>::CharClasses()
 {
-    numAlpha = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ"; // без Ё 
-    for (unsigned i = 0; i < numAlpha.size(); i++) {
-        alphaNum[numAlpha[i]] = i;
+    for (int c = 0; c < count; c++) {
+        openClass[c] = classify(c, true);
+        cipherClass[c] = classify(c, false);
     }
+}
+
+template <class Alphabet>
+const CharClasses<Alphabet>& CharClasses<Alphabet>::shared()
+{
+    static const CharClasses classes;
+    return classes;
+}
+
+template <class Alphabet>
+int CharClasses<Alphabet>::classify(wchar_t c, bool open)
+{
+    if (!iswalpha(c))
+        return notLetter;
+    int index = AlphabetTable<Alphabet>::find(open ? towupper(c) : c);
+    return index < 0 ? foreignLetter : index;
+}
+
+template <class Alphabet>
+basicAlphaCipher<Alphabet>::basicAlphaCipher(const std::wstring& skey)
+{
     key = convert(getValidKey(skey));
 }
 
-wstring modAlphaCipher::encrypt(const wstring& open_text)
+template <class Alphabet>
+wstring basicAlphaCipher<Alphabet>::encrypt(const wstring& open_text)
+{
+    wstring result(open_text.size(), L'\0');
+    result.resize(encrypt(open_text.data(), open_text.size(), &result[0]));
+    return result;
+}
+
+template <class Alphabet>
+wstring basicAlphaCipher<Alphabet>::decrypt(const wstring& cipher_text)
+{
+    wstring result(cipher_text.size(), L'\0');
+    result.resize(decrypt(cipher_text.data(), cipher_text.size(), &result[0]));
+    return result;
+}
+
+#if __cplusplus >= 201703L
+template <class Alphabet>
+pmr::wstring basicAlphaCipher<Alphabet>::encrypt(wstring_view open_text, pmr::memory_resource* resource)
+{
+    pmr::wstring result(open_text.size(), L'\0', resource);
+    result.resize(encrypt(open_text.data(), open_text.size(), result.data()));
+    return result;
+}
+
+template <class Alphabet>
+pmr::wstring basicAlphaCipher<Alphabet>::decrypt(wstring_view cipher_text, pmr::memory_resource* resource)
 {
-    vector<int> work = convert(getValidOpenText(open_text));
-    for (size_t i = 0; i < work.size(); i++) {
-        work[i] = (work[i] + key[i % key.size()]) % numAlpha.size();
+    pmr::wstring result(cipher_text.size(), L'\0', resource);
+    result.resize(decrypt(cipher_text.data(), cipher_text.size(), result.data()));
+    return result;
+}
+#endif
+
+template <class Alphabet>
+size_t basicAlphaCipher<Alphabet>::encrypt(const wchar_t* open_text, size_t length, wchar_t* out) const
+{
+    Stream stream;
+    size_t n = encryptBlock(open_text, length, stream, out);
+    finishEncrypt(stream);
+    return n;
+}
+
+template <class Alphabet>
+size_t basicAlphaCipher<Alphabet>::encryptFrom(const wchar_t* open_text, size_t length, size_t k, wchar_t* out) const
+{
+    Stream stream;
+    stream.k = k;
+    size_t n = encryptBlock(open_text, length, stream, out);
+    if (stream.foreign)
+        throw cipher_error("Недопустимый символ в тексте");
+    return n;
+}
+
+template <class Alphabet>
+size_t basicAlphaCipher<Alphabet>::encryptBlock(const wchar_t* open_text, size_t length, Stream& stream,
+                                                wchar_t* out) const
+{
+    const CharClasses<Alphabet>& classes = CharClasses<Alphabet>::shared();
+    // Шифртекст не длиннее текста: буквы пишутся сразу на свои места.
+    // Модуль — константа, перенос сдвига — сравнение и вычитание
+    const int size = Table::size;
+    size_t n = 0, k = stream.k;
+    bool foreign = false;
+    for (size_t i = 0; i < length; i++) {
+        int index = classes.open(open_text[i]);
+        if (index < 0) {
+            foreign |= index == foreignLetter;
+            continue;
+        }
+        index += key[k];
+        out[n++] = Alphabet::letters[index >= size ? index - size : index];
+        if (++k == key.size())
+            k = 0;
     }
-    return convert(work);
+    stream.k = k;
+    stream.letters += n;
+    stream.foreign |= foreign;
+    return n;
+}
+
+template <class Alphabet>
+void basicAlphaCipher<Alphabet>::finishEncrypt(const Stream& stream)
+{
+    if (stream.foreign)
+        throw cipher_error("Недопустимый символ в тексте");
+    if (stream.letters == 0)
+        throw cipher_error("Пустой открытый текст");
 }
 
-wstring modAlphaCipher::decrypt(const wstring& cipher_text)
+template <class Alphabet>
+size_t basicAlphaCipher<Alphabet>::append(const wchar_t* open_text, size_t length, size_t offset, wchar_t* out) const
 {
-    vector<int> work = convert(getValidCipherText(cipher_text));
-    for (size_t i = 0; i < work.size(); i++) {
-        work[i] = (work[i] + numAlpha.size() - key[i % key.size()]) % numAlpha.size();
+    return encryptFrom(open_text, length, offset % key.size(), out);
+}
+
+template <class Alphabet>
+void basicAlphaCipher<Alphabet>::append(wstring& cipher_text, const wstring& open_text) const
+{
+    size_t old = cipher_text.size();
+    cipher_text.resize(old + open_text.size());
+    try {
+        cipher_text.resize(old + append(open_text.data(), open_text.size(), old, &cipher_text[old]));
+    } catch (...) {
+        cipher_text.resize(old);
+        throw;
     }
-    return convert(work);
 }
 
-vector<int> modAlphaCipher::convert(const wstring& s)
+template <class Alphabet>
+size_t basicAlphaCipher<Alphabet>::patch(wchar_t* cipher_text, size_t length, size_t offset, const wchar_t* open_text,
+                                         size_t open_length) const
 {
-    vector<int> result;
-    for (auto c : s) {
-        auto it = alphaNum.find(c);
-        if (it == alphaNum.end())
+    const CharClasses<Alphabet>& classes = CharClasses<Alphabet>::shared();
+    // Сначала проверка текста и подсчёт букв, чтобы при ошибке ничего не менять
+    size_t count = 0;
+    for (size_t i = 0; i < open_length; i++) {
+        int index = classes.open(open_text[i]);
+        if (index == foreignLetter)
             throw cipher_error("Недопустимый символ в тексте");
-        result.push_back(it->second);
+        if (index != notLetter)
+            count++;
     }
+    if (offset > length || count > length - offset)
+        throw cipher_error("Диапазон вне шифртекста");
+    return encryptFrom(open_text, open_length, offset % key.size(), cipher_text + offset);
+}
+
+template <class Alphabet>
+size_t basicAlphaCipher<Alphabet>::patch(wstring& cipher_text, size_t offset, const wstring& open_text) const
+{
+    return patch(&cipher_text[0], cipher_text.size(), offset, open_text.data(), open_text.size());
+}
+
+template <class Alphabet>
+size_t basicAlphaCipher<Alphabet>::decrypt(const wchar_t* cipher_text, size_t length, wchar_t* out) const
+{
+    if (length == 0)
+        throw cipher_error("Пустой шифртекст");
+    return decryptFrom(cipher_text, length, 0, out);
+}
+
+template <class Alphabet>
+size_t basicAlphaCipher<Alphabet>::decryptRange(const wchar_t* cipher_text, size_t length, size_t offset,
+                                                size_t count, wchar_t* out) const
+{
+    if (length == 0)
+        throw cipher_error("Пустой шифртекст");
+    if (offset > length || count > length - offset)
+        throw cipher_error("Диапазон вне шифртекста");
+    return decryptFrom(cipher_text + offset, count, offset % key.size(), out);
+}
+
+template <class Alphabet>
+wstring basicAlphaCipher<Alphabet>::decryptRange(const wstring& cipher_text, size_t offset, size_t count) const
+{
+    wstring result(count, L'\0');
+    decryptRange(cipher_text.data(), cipher_text.size(), offset, count, &result[0]);
     return result;
 }
 
-wstring modAlphaCipher::convert(const vector<int>& v)
+template <class Alphabet>
+size_t basicAlphaCipher<Alphabet>::encryptAt(const wchar_t* open_text, size_t length, uint64_t offset,
+                                             wchar_t* out) const
 {
-    wstring result;
-    for (auto i : v) {
-        result.push_back(numAlpha[i]);
+    return encryptFrom(open_text, length, static_cast<size_t>(offset % key.size()), out);
+}
+
+template <class Alphabet>
+size_t basicAlphaCipher<Alphabet>::decryptAt(const wchar_t* cipher_text, size_t length, uint64_t offset,
+                                             wchar_t* out) const
+{
+    return decryptFrom(cipher_text, length, static_cast<size_t>(offset % key.size()), out);
+}
+
+template <class Alphabet>
+size_t basicAlphaCipher<Alphabet>::decryptFrom(const wchar_t* cipher_text, size_t length, size_t k, wchar_t* out) const
+{
+    Stream stream;
+    stream.k = k;
+    decryptBlock(cipher_text, length, stream, out);
+    if (stream.invalid)
+        throw cipher_error("Недопустимый символ в шифртексте");
+    if (stream.foreign)
+        throw cipher_error("Недопустимый символ в тексте");
+    return length;
+}
+
+template <class Alphabet>
+size_t basicAlphaCipher<Alphabet>::decryptBlock(const wchar_t* cipher_text, size_t length, Stream& stream,
+                                                wchar_t* out) const
+{
+    const CharClasses<Alphabet>& classes = CharClasses<Alphabet>::shared();
+    const int size = Table::size;
+    size_t k = stream.k;
+    bool invalid = false, foreign = false;
+    for (size_t i = 0; i < length; i++) {
+        int index = classes.cipher(cipher_text[i]);
+        if (index < 0) {
+            invalid |= index == notLetter;
+            foreign |= index == foreignLetter;
+        } else {
+            out[i] = Alphabet::letters[index < key[k] ? index + size - key[k] : index - key[k]];
+        }
+        if (++k == key.size())
+            k = 0;
+    }
+    stream.k = k;
+    stream.letters += length;
+    stream.invalid |= invalid;
+    stream.foreign |= foreign;
+    return length;
+}
+
+template <class Alphabet>
+void basicAlphaCipher<Alphabet>::finishDecrypt(const Stream& stream)
+{
+    // Небуква важнее буквы не из алфавита: её ошибка проверяется по всему тексту
+    if (stream.letters == 0)
+        throw cipher_error("Пустой шифртекст");
+    if (stream.invalid)
+        throw cipher_error("Недопустимый символ в шифртексте");
+    if (stream.foreign)
+        throw cipher_error("Недопустимый символ в тексте");
+}
+
+template <class Alphabet>
+vector<int> basicAlphaCipher<Alphabet>::convert(const wstring& s)
+{
+    vector<int> result;
+    for (auto c : s) {
+        int index = Table::find(c);
+        if (index < 0)
+            throw cipher_error("Недопустимый символ в тексте");
+        result.push_back(index);
     }
     return result;
 }
 
-wstring modAlphaCipher::getValidKey(const wstring& s)
+template <class Alphabet>
+wstring basicAlphaCipher<Alphabet>::getValidKey(const wstring& s)
 {
     if (s.empty())
         throw cipher_error("Пустой ключ");
@@ -78,9 +303,10 @@ wstring modAlphaCipher::getValidKey(const wstring& s)
     if (tmp.empty())
         throw cipher_error("Ключ не содержит букв");
     // Дополнительные исправления    
+    // Буква с номером 0 не сдвигает текст
     int countA = 0;
     for (auto c : tmp) {
-        if (c == L'А')
+        if (c == Alphabet::letters[0])
             countA++;
     }
 
@@ -92,31 +318,166 @@ wstring modAlphaCipher::getValidKey(const wstring& s)
     return tmp;
 }
 
-wstring modAlphaCipher::getValidOpenText(const wstring& s)
+template <class Alphabet>
+typename basicRunningKeyCipher<Alphabet>::Step
+basicRunningKeyCipher<Alphabet>::encrypt(const wchar_t* text, size_t length, const wchar_t* key, size_t keyLength,
+                                         wchar_t* out) const
 {
-    wstring tmp;
-    for (auto c : s) {
-        if (iswalpha(c)) {
-            tmp.push_back(towupper(c));
-        }
+    const CharClasses<Alphabet>& classes = CharClasses<Alphabet>::shared();
+    const int size = Table::size;
+    Step step = { 0, 0, 0 };
+    for (; step.read < length; step.read++) {
+        int index = classes.open(text[step.read]);
+        if (index == notLetter)
+            continue;
+        if (index == foreignLetter)
+            throw cipher_error("Недопустимый символ в тексте");
+        // Следующая буква ключа; небуквы и буквы не из алфавита пропускаются
+        int shift = -1;
+        while (step.keyRead < keyLength && shift < 0)
+            shift = classes.open(key[step.keyRead++]);
+        if (shift < 0)
+            break;
+        index += shift;
+        out[step.written++] = Alphabet::letters[index >= size ? index - size : index];
     }
+    return step;
+}
 
-    if (tmp.empty())
-        throw cipher_error("Пустой открытый текст");
+template <class Alphabet>
+typename basicRunningKeyCipher<Alphabet>::Step
+basicRunningKeyCipher<Alphabet>::decrypt(const wchar_t* text, size_t length, const wchar_t* key, size_t keyLength,
+                                         wchar_t* out) const
+{
+    const CharClasses<Alphabet>& classes = CharClasses<Alphabet>::shared();
+    const int size = Table::size;
+    Step step = { 0, 0, 0 };
+    for (; step.read < length; step.read++) {
+        int index = classes.cipher(text[step.read]);
+        if (index == notLetter)
+            throw cipher_error("Недопустимый символ в шифртексте");
+        if (index == foreignLetter)
+            throw cipher_error("Недопустимый символ в тексте");
+        int shift = -1;
+        while (step.keyRead < keyLength && shift < 0)
+            shift = classes.open(key[step.keyRead++]);
+        if (shift < 0)
+            break;
+        out[step.written++] = Alphabet::letters[index < shift ? index + size - shift : index - shift];
+    }
+    return step;
+}
 
-    return tmp;
+template <class Alphabet>
+size_t basicRunningKeyCipher<Alphabet>::skip(const wchar_t* key, size_t keyLength, uint64_t& letters) const
+{
+    const CharClasses<Alphabet>& classes = CharClasses<Alphabet>::shared();
+    size_t i = 0;
+    for (; i < keyLength && letters > 0; i++) {
+        if (classes.open(key[i]) >= 0)
+            letters--;
+    }
+    return i;
 }
 
-wstring modAlphaCipher::getValidCipherText(const wstring& s)
+template <class Alphabet>
+wstring basicRunningKeyCipher<Alphabet>::encrypt(const wstring& open_text, const wstring& key) const
 {
-    if (s.empty())
+    wstring result(open_text.size(), L'\0');
+    Step step = encrypt(open_text.data(), open_text.size(), key.data(), key.size(), &result[0]);
+    if (step.read < open_text.size())
+        throw cipher_error("Бегущий ключ короче текста");
+    if (step.written == 0)
+        throw cipher_error("Пустой открытый текст");
+    result.resize(step.written);
+    return result;
+}
+
+template <class Alphabet>
+wstring basicRunningKeyCipher<Alphabet>::decrypt(const wstring& cipher_text, const wstring& key) const
+{
+    if (cipher_text.empty())
         throw cipher_error("Пустой шифртекст");
+    wstring result(cipher_text.size(), L'\0');
+    Step step = decrypt(cipher_text.data(), cipher_text.size(), key.data(), key.size(), &result[0]);
+    if (step.read < cipher_text.size())
+        throw cipher_error("Бегущий ключ короче текста");
+    return result;
+}
 
-    for (auto c : s) {
-        if (!iswalpha(c)) {
-            throw cipher_error("Недопустимый символ в шифртексте");
+template <class Alphabet>
+basicMultiKeyCipher<Alphabet>::basicMultiKeyCipher(const vector<wstring>& keys)
+{
+    if (keys.empty())
+        throw cipher_error("Пустой набор ключей");
+    for (const wstring& skey : keys) {
+        vector<int> key = basicAlphaCipher<Alphabet>::convert(basicAlphaCipher<Alphabet>::getValidKey(skey));
+        offsets.push_back(shifts.size());
+        lengths.push_back(key.size());
+        for (size_t j = 0; j < tile + key.size(); j++)
+            shifts.push_back(static_cast<unsigned char>(key[j % key.size()]));
+    }
+}
+
+template <class Alphabet>
+size_t basicMultiKeyCipher<Alphabet>::encrypt(const wchar_t* open_text, size_t length, wchar_t* out) const
+{
+    const CharClasses<Alphabet>& classes = CharClasses<Alphabet>::shared();
+    // Номера букв текста, дополненные до целого числа участков
+    vector<unsigned char> index;
+    index.reserve(length + tile);
+    for (size_t i = 0; i < length; i++) {
+        int c = classes.open(open_text[i]);
+        if (c == notLetter)
+            continue;
+        if (c == foreignLetter)
+            throw cipher_error("Недопустимый символ в тексте");
+        index.push_back(static_cast<unsigned char>(c));
+    }
+    size_t n = index.size();
+    if (n == 0)
+        throw cipher_error("Пустой открытый текст");
+    index.resize((n + tile - 1) / tile * tile);
+
+    // Номер буквы плюс сдвиг меньше удвоенного размера алфавита и
+    // помещается в байт. Цикл сложения — по целому участку постоянной
+    // длины, без ветвлений; буквы подставляются отдельным проходом
+    const unsigned char size = Table::size;
+    unsigned char sum[tile];
+    for (size_t start = 0; start < n; start += tile) {
+        const unsigned char* text = &index[start];
+        size_t count = min<size_t>(tile, n - start);
+        for (size_t i = 0; i < lengths.size(); i++) {
+            const unsigned char* key = &shifts[offsets[i] + start % lengths[i]];
+            for (size_t j = 0; j < tile; j++) {
+                unsigned char v = text[j] + key[j];
+                sum[j] = v >= size ? v - size : v;
+            }
+            wchar_t* row = out + i * n + start;
+            for (size_t j = 0; j < count; j++)
+                row[j] = Alphabet::letters[sum[j]];
         }
     }
+    return n;
+}
 
-    return s;
+template <class Alphabet>
+wstring basicMultiKeyCipher<Alphabet>::encrypt(const wstring& open_text) const
+{
+    wstring result(open_text.size() * size(), L'\0');
+    result.resize(encrypt(open_text.data(), open_text.size(), &result[0]) * size());
+    return result;
 }
+
+template class CharClasses<RussianAlphabet>;
+template class CharClasses<LatinAlphabet>;
+template class CharClasses<MixedAlphabet>;
+template class basicAlphaCipher<RussianAlphabet>;
+template class basicAlphaCipher<LatinAlphabet>;
+template class basicAlphaCipher<MixedAlphabet>;
+template class basicRunningKeyCipher<RussianAlphabet>;
+template class basicRunningKeyCipher<LatinAlphabet>;
+template class basicRunningKeyCipher<MixedAlphabet>;
+template class basicMultiKeyCipher<RussianAlphabet>;
+template class basicMultiKeyCipher<LatinAlphabet>;
+template class basicMultiKeyCipher<MixedAlphabet>;
@@ -1,36 +1,436 @@
 #pragma once
-#include <map>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <stdexcept>
 #include <locale>
 #include <codecvt>
+#include <cstddef>
+#include <iterator>
+#include "cipher.h"
+#include "cipher_error.h"
+#if __cplusplus >= 202002L
+#include <ranges>
+#endif
+#if __cplusplus >= 201703L
+#include <memory_resource>
+#include <string_view>
+#endif
 
-class modAlphaCipher
+// Алфавиты шифра: прописные буквы в порядке номеров. Номер буквы — её сдвиг
+// в ключе, буква с номером 0 («А») сдвига не даёт
+struct RussianAlphabet {
+    static constexpr wchar_t letters[] = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+};
+
+struct LatinAlphabet {
+    static constexpr wchar_t letters[] = L"ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+};
+
+struct MixedAlphabet {
+    static constexpr wchar_t letters[] = L"ABCDEFGHIJKLMNOPQRSTUVWXYZАБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+};
+
+namespace alphabet_detail {
+
+template <class Alphabet>
+constexpr int size()
+{
+    return sizeof(Alphabet::letters) / sizeof(wchar_t) - 1;
+}
+
+// Наименьший (upper = false) или наибольший код буквы алфавита
+template <class Alphabet>
+constexpr wchar_t bound(bool upper)
+{
+    wchar_t result = Alphabet::letters[0];
+    for (int i = 1; i < size<Alphabet>(); i++) {
+        if (upper ? Alphabet::letters[i] > result : Alphabet::letters[i] < result)
+            result = Alphabet::letters[i];
+    }
+    return result;
+}
+
+} // namespace alphabet_detail
+
+// Таблицы алфавита, построенные при компиляции: размер (модуль сдвига),
+// номер → буква (Alphabet::letters) и буква → номер для символов first..last
+template <class Alphabet>
+struct AlphabetTable
 {
+    static constexpr int size = alphabet_detail::size<Alphabet>();
+    static constexpr wchar_t first = alphabet_detail::bound<Alphabet>(false);
+    static constexpr wchar_t last = alphabet_detail::bound<Alphabet>(true);
+    static_assert(size > 0 && size < 128, "Алфавит должен содержать от 1 до 127 букв");
+
+    struct Index {
+        signed char value[last - first + 1];
+    };
+    static const Index index;
+
+    // Номер буквы или -1
+    static constexpr int find(wchar_t c)
+    {
+        return c >= first && c <= last ? index.value[c - first] : -1;
+    }
+};
+
+namespace alphabet_detail {
+
+template <class Alphabet>
+constexpr typename AlphabetTable<Alphabet>::Index buildIndex()
+{
+    typedef AlphabetTable<Alphabet> Table;
+    typename Table::Index result{};
+    for (int c = 0; c <= Table::last - Table::first; c++)
+        result.value[c] = -1;
+    for (int i = 0; i < Table::size; i++)
+        result.value[Alphabet::letters[i] - Table::first] = i;
+    return result;
+}
+
+template <class Alphabet>
+constexpr bool unique()
+{
+    typedef AlphabetTable<Alphabet> Table;
+    for (int i = 0; i < Table::size; i++) {
+        if (buildIndex<Alphabet>().value[Alphabet::letters[i] - Table::first] != i)
+            return false;
+    }
+    return true;
+}
+
+} // namespace alphabet_detail
+
+template <class Alphabet>
+constexpr typename AlphabetTable<Alphabet>::Index AlphabetTable<Alphabet>::index = alphabet_detail::buildIndex<Alphabet>();
+
+// Классы символов U+0000..U+045F (латиница и кириллица): номер буквы в
+// алфавите, notLetter для небукв (iswalpha) или foreignLetter для букв не
+// из алфавита. open — после towupper (открытый текст, ключ), cipher — без
+// него (шифртекст). Таблицы одни на алфавит: shared() строит их при первом
+// обращении по глобальной локали, и шифры только ссылаются на них
+template <class Alphabet>
+class CharClasses
+{
+public:
+    enum { notLetter = -2, foreignLetter = -1, count = 0x460 };
+
+    static const CharClasses& shared();
+    int open(wchar_t c) const
+    {
+        return static_cast<unsigned>(c) < count ? openClass[c] : classify(c, true);
+    }
+    int cipher(wchar_t c) const
+    {
+        return static_cast<unsigned>(c) < count ? cipherClass[c] : classify(c, false);
+    }
+
 private:
-    std::wstring numAlpha = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
-    std::map<wchar_t, int> alphaNum;
+    signed char openClass[count];
+    signed char cipherClass[count];
+
+    CharClasses();
+    static int classify(wchar_t c, bool open);
+};
+
+// Шифр Гронсфельда над алфавитом Alphabet. Модуль сдвига — константа
+// времени компиляции. Методы определены в modAlphaCipher.cpp и
+// инстанцированы для RussianAlphabet, LatinAlphabet и MixedAlphabet.
+// Общий интерфейс шифров и цепочки (then) — CipherInterface из cipher.h
+template <class Alphabet>
+class basicAlphaCipher : public CipherInterface<basicAlphaCipher<Alphabet>>
+{
+private:
+    typedef AlphabetTable<Alphabet> Table;
+    static_assert(alphabet_detail::unique<Alphabet>(), "Буквы алфавита должны быть различны");
+    enum { notLetter = CharClasses<Alphabet>::notLetter, foreignLetter = CharClasses<Alphabet>::foreignLetter };
     std::vector<int> key;
-    
-    std::vector<int> convert(const std::wstring& s);
-    std::wstring convert(const std::vector<int>& v);
-    
-    std::wstring getValidKey(const std::wstring& s);
-    std::wstring getValidOpenText(const std::wstring& s);
-    std::wstring getValidCipherText(const std::wstring& s);
+
+    static std::vector<int> convert(const std::wstring& s);
+
+    static std::wstring getValidKey(const std::wstring& s);
+
+    // Набор ключей проверяет их так же, как конструктор
+    template <class> friend class basicMultiKeyCipher;
+
+    // Зашифрование с позиции ключа k, без проверки на пустой текст
+    std::size_t encryptFrom(const wchar_t* open_text, std::size_t length, std::size_t k, wchar_t* out) const;
+    // Расшифрование с позиции ключа k
+    std::size_t decryptFrom(const wchar_t* cipher_text, std::size_t length, std::size_t k, wchar_t* out) const;
 
 public:
-    modAlphaCipher() = delete;
-    modAlphaCipher(const std::wstring& skey);
+    basicAlphaCipher() = delete;
+    basicAlphaCipher(const std::wstring& skey);
     std::wstring encrypt(const std::wstring& open_text);
     std::wstring decrypt(const std::wstring& cipher_text);
+    // Проверка и преобразование за один проход без промежуточных буферов:
+    // результат пишется в память вызывающего (не меньше length символов,
+    // например массив на стеке для коротких сообщений), возвращается его длина
+    std::size_t encrypt(const wchar_t* open_text, std::size_t length, wchar_t* out) const;
+    std::size_t decrypt(const wchar_t* cipher_text, std::size_t length, wchar_t* out) const;
+    // Расшифрование букв шифртекста с номерами offset..offset+count-1:
+    // сдвиг ключа определяется номером буквы, поэтому читаются и
+    // проверяются только они. cipher_text — весь шифртекст длины length
+    std::size_t decryptRange(const wchar_t* cipher_text, std::size_t length, std::size_t offset, std::size_t count,
+                             wchar_t* out) const;
+    std::wstring decryptRange(const std::wstring& cipher_text, std::size_t offset, std::size_t count) const;
+    // Преобразование фрагмента сообщения, перед которым стоит offset букв:
+    // ключ начинается с позиции offset % длина ключа, поэтому фрагменты
+    // одного сообщения обрабатываются одним шифром в любом порядке.
+    // Фрагмент без букв при зашифровании даёт пустой результат; пустое
+    // сообщение целиком проверяет вызывающий
+    std::size_t encryptAt(const wchar_t* open_text, std::size_t length, uint64_t offset, wchar_t* out) const;
+    std::size_t decryptAt(const wchar_t* cipher_text, std::size_t length, uint64_t offset, wchar_t* out) const;
+    // Продолжение сообщения, от которого уже зашифровано offset букв:
+    // сдвиг ключа определяется номером буквы, поэтому время зависит только
+    // от длины добавляемого текста. Текст без букв даёт пустой результат.
+    // Вариант со строкой дописывает буквы к cipher_text (offset — его длина)
+    std::size_t append(const wchar_t* open_text, std::size_t length, std::size_t offset, wchar_t* out) const;
+    void append(std::wstring& cipher_text, const std::wstring& open_text) const;
+    // Замена букв шифртекста с номерами offset.. зашифрованными буквами
+    // open_text (длина шифртекста не меняется). Остальные буквы не читаются;
+    // при ошибке шифртекст не изменяется. Возвращает число заменённых букв
+    std::size_t patch(wchar_t* cipher_text, std::size_t length, std::size_t offset, const wchar_t* open_text,
+                      std::size_t open_length) const;
+    std::size_t patch(std::wstring& cipher_text, std::size_t offset, const std::wstring& open_text) const;
+    // Потоковое преобразование блоками: проверка, приведение к прописным,
+    // номер буквы и сдвиг выполняются за один проход по блоку. Ошибки не
+    // прерывают обработку, а копятся в Stream; finishEncrypt/finishDecrypt
+    // после последнего блока сообщают их с тем же текстом, что и для
+    // сообщения целиком. out может совпадать с текстом блока
+    struct Stream {
+        std::size_t k = 0;     // Позиция ключа для следующей буквы
+        uint64_t letters = 0;  // Обработано букв
+        bool foreign = false;  // Встречена буква не из алфавита
+        bool invalid = false;  // В шифртексте встречена небуква
+    };
+    std::size_t encryptBlock(const wchar_t* open_text, std::size_t length, Stream& stream, wchar_t* out) const;
+    std::size_t decryptBlock(const wchar_t* cipher_text, std::size_t length, Stream& stream, wchar_t* out) const;
+    static void finishEncrypt(const Stream& stream);
+    static void finishDecrypt(const Stream& stream);
+    // Ленивое преобразование: итератор вида читает текст по мере обхода и
+    // вычисляет очередную букву результата, поэтому результат можно сразу
+    // писать в итератор вывода или передавать адаптерам диапазонов (в C++20
+    // вид — std::ranges::view). Память — O(1), ни строки результата, ни
+    // вектора номеров. Ошибки текста сообщаются при обходе первым
+    // недопустимым символом, пустой текст даёт пустой вид. Шифр и текст
+    // должны существовать, пока используется вид
+    template <class It, bool Encrypt>
+    class View;
+    template <class It>
+    View<It, true> encryptView(It first, It last) const
+    {
+        return View<It, true>(this, first, last);
+    }
+    template <class It>
+    View<It, false> decryptView(It first, It last) const
+    {
+        return View<It, false>(this, first, last);
+    }
+    View<std::wstring::const_iterator, true> encryptView(const std::wstring& open_text) const
+    {
+        return encryptView(open_text.begin(), open_text.end());
+    }
+    View<std::wstring::const_iterator, false> decryptView(const std::wstring& cipher_text) const
+    {
+        return decryptView(cipher_text.begin(), cipher_text.end());
+    }
+    // Вид временной строки указывал бы на уничтоженный текст
+    void encryptView(std::wstring&&) const = delete;
+    void decryptView(std::wstring&&) const = delete;
+#if __cplusplus >= 201703L
+    // Результат размещается в resource (например, в арене запроса)
+    std::pmr::wstring encrypt(std::wstring_view open_text, std::pmr::memory_resource* resource);
+    std::pmr::wstring decrypt(std::wstring_view cipher_text, std::pmr::memory_resource* resource);
+#endif
+};
+
+// Шифр Гронсфельда с бегущим ключом: сдвиг каждой буквы задаёт очередная
+// буква отдельного текста ключа (например, книги) не короче сообщения.
+// Буквы ключа — символы, прописная форма которых есть в алфавите; прочие
+// символы ключа пропускаются, проверка на слабый ключ не выполняется.
+// Основные методы обрабатывают текст и ключ частями в ногу друг с другом,
+// поэтому ни сообщение, ни ключ не обязаны находиться в памяти целиком
+template <class Alphabet>
+class basicRunningKeyCipher
+{
+private:
+    typedef AlphabetTable<Alphabet> Table;
+    enum { notLetter = CharClasses<Alphabet>::notLetter, foreignLetter = CharClasses<Alphabet>::foreignLetter };
+
+public:
+    // Результат шага: прочитано символов текста и ключа, записано символов
+    struct Step {
+        std::size_t read;
+        std::size_t keyRead;
+        std::size_t written;
+    };
+
+    // Шаг зашифрования или расшифрования части текста частью ключа.
+    // Останавливается, когда кончается текст (read == length) или буквы
+    // части ключа (keyRead == keyLength, read — позиция буквы, ждущей
+    // следующей части ключа). out — не меньше length символов.
+    // Ошибки текста сообщаются сразу, пустое сообщение проверяет вызывающий
+    Step encrypt(const wchar_t* text, std::size_t length, const wchar_t* key, std::size_t keyLength,
+                 wchar_t* out) const;
+    Step decrypt(const wchar_t* text, std::size_t length, const wchar_t* key, std::size_t keyLength,
+                 wchar_t* out) const;
+    // Пропускает до letters букв ключа (смещение в ключе), уменьшая letters
+    // на число пропущенных; возвращает количество прочитанных символов
+    std::size_t skip(const wchar_t* key, std::size_t keyLength, uint64_t& letters) const;
+
+    // Сообщение и ключ целиком, с проверками как у basicAlphaCipher и
+    // ошибкой «Бегущий ключ короче текста»
+    std::wstring encrypt(const std::wstring& open_text, const std::wstring& key) const;
+    std::wstring decrypt(const std::wstring& cipher_text, const std::wstring& key) const;
+};
+
+// Зашифрование одного текста набором ключей (аудит смены ключей, тестовые
+// векторы). Ключи проверяются при создании с теми же ошибками, что и в
+// basicAlphaCipher. Текст проверяется и переводится в номера букв один раз,
+// затем шифртексты всех ключей вычисляются по участкам текста: участок
+// номеров остаётся в кэше, пока его проходят все ключи, а сложение со
+// сдвигами ключа идёт байтами по целому участку и векторизуется
+template <class Alphabet>
+class basicMultiKeyCipher
+{
+private:
+    typedef AlphabetTable<Alphabet> Table;
+    // tile — букв в участке
+    enum { notLetter = CharClasses<Alphabet>::notLetter, foreignLetter = CharClasses<Alphabet>::foreignLetter,
+           tile = 1024 };
+    // Сдвиги ключа i, повторённые на tile + длина ключа, начиная с offsets[i]:
+    // сдвиги участка, который начинается с позиции ключа p, лежат подряд с p
+    std::vector<unsigned char> shifts;
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> lengths;
+
+public:
+    basicMultiKeyCipher() = delete;
+    explicit basicMultiKeyCipher(const std::vector<std::wstring>& keys);
+    // Количество ключей
+    std::size_t size() const
+    {
+        return lengths.size();
+    }
+    // Матрица шифртекстов в памяти вызывающего (не меньше size() * length
+    // символов): строка i — шифртекст ключом i, строки идут подряд.
+    // Возвращает длину строки; при ошибке текста out не изменяется
+    std::size_t encrypt(const wchar_t* open_text, std::size_t length, wchar_t* out) const;
+    // Та же матрица строкой: длина шифртекста — её длина, делённая на size()
+    std::wstring encrypt(const std::wstring& open_text) const;
 };
 
-class cipher_error : public std::invalid_argument {
+extern template class CharClasses<RussianAlphabet>;
+extern template class CharClasses<LatinAlphabet>;
+extern template class CharClasses<MixedAlphabet>;
+extern template class basicAlphaCipher<RussianAlphabet>;
+extern template class basicAlphaCipher<LatinAlphabet>;
+extern template class basicAlphaCipher<MixedAlphabet>;
+extern template class basicRunningKeyCipher<RussianAlphabet>;
+extern template class basicRunningKeyCipher<LatinAlphabet>;
+extern template class basicRunningKeyCipher<MixedAlphabet>;
+extern template class basicMultiKeyCipher<RussianAlphabet>;
+extern template class basicMultiKeyCipher<LatinAlphabet>;
+extern template class basicMultiKeyCipher<MixedAlphabet>;
+
+typedef basicAlphaCipher<RussianAlphabet> modAlphaCipher;
+typedef basicAlphaCipher<LatinAlphabet> latinAlphaCipher;
+typedef basicAlphaCipher<MixedAlphabet> mixedAlphaCipher;
+typedef basicRunningKeyCipher<RussianAlphabet> runningKeyCipher;
+typedef basicMultiKeyCipher<RussianAlphabet> multiKeyCipher;
+
+// Вид результата encryptView (Encrypt) или decryptView над диапазоном
+// [first, last) символов. Итератор однопроходный, если однопроходен It,
+// иначе прямой (в C++20 — std::forward_iterator с буквой по значению)
+template <class Alphabet>
+template <class It, bool Encrypt>
+class basicAlphaCipher<Alphabet>::View
+#if __cplusplus >= 202002L
+    : public std::ranges::view_interface<View<It, Encrypt>>
+#endif
+{
 public:
-    explicit cipher_error(const std::string& what_arg) :
-        std::invalid_argument(what_arg) {}
-    explicit cipher_error(const char* what_arg) :
-        std::invalid_argument(what_arg) {}
+    class iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+#if __cplusplus >= 202002L
+        typedef std::conditional_t<std::forward_iterator<It>, std::forward_iterator_tag, std::input_iterator_tag>
+            iterator_concept;
+#endif
+        typedef wchar_t value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const wchar_t* pointer;
+        typedef wchar_t reference;
+
+        iterator() = default;
+        iterator(const basicAlphaCipher* cipher, It current, It last)
+            : cipher(cipher), classes(&CharClasses<Alphabet>::shared()), current(current), last(last)
+        {
+            settle();
+        }
+
+        wchar_t operator*() const { return value; }
+        iterator& operator++()
+        {
+            ++current;
+            if (++k == cipher->key.size())
+                k = 0;
+            settle();
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+        friend bool operator==(const iterator& a, const iterator& b) { return a.current == b.current; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return !(a == b); }
+
+    private:
+        const basicAlphaCipher* cipher = nullptr;
+        const CharClasses<Alphabet>* classes = nullptr;
+        It current = It(), last = It();
+        std::size_t k = 0;
+        wchar_t value = 0;
+
+        // Останавливается на очередной букве текста и вычисляет букву результата
+        void settle()
+        {
+            const int size = Table::size;
+            for (; current != last; ++current) {
+                if (Encrypt) {
+                    int index = classes->open(*current);
+                    if (index == notLetter)
+                        continue;
+                    if (index == foreignLetter)
+                        throw cipher_error("Недопустимый символ в тексте");
+                    index += cipher->key[k];
+                    value = Alphabet::letters[index >= size ? index - size : index];
+                } else {
+                    int index = classes->cipher(*current);
+                    if (index == notLetter)
+                        throw cipher_error("Недопустимый символ в шифртексте");
+                    if (index == foreignLetter)
+                        throw cipher_error("Недопустимый символ в тексте");
+                    int shift = cipher->key[k];
+                    value = Alphabet::letters[index < shift ? index + size - shift : index - shift];
+                }
+                return;
+            }
+        }
+    };
+
+    View() = default;
+    View(const basicAlphaCipher* cipher, It first, It last) : cipher(cipher), first(first), last(last) {}
+
+    iterator begin() const { return iterator(cipher, first, last); }
+    iterator end() const { return iterator(cipher, last, last); }
+
+private:
+    const basicAlphaCipher* cipher = nullptr;
+    It first = It(), last = It();
 };
\ No newline at end of file
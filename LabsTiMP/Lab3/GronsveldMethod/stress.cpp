@@ -0,0 +1,229 @@
+#include "modAlphaCipher.h"
+#include "../../Corpus/corpus.h"
+#include "../../Corpus/measure.h"
+
+#include <UnitTest++/UnitTest++.h>
+
+#include <iostream>
+#include <locale>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Допустимый разброс удельных времени и памяти между наименьшим и наибольшим размером
+const double timeTolerance = 4.0;
+const double memoryTolerance = 2.0;
+
+void init_locale()
+{
+    try {
+        locale::global(locale("ru_RU.UTF-8"));
+    } catch(const exception& e) {
+        cerr << "Ошибка установки локали: " << e.what() << endl;
+        locale::global(locale(""));
+    }
+}
+
+// Текст с пробелами, знаками препинания и строчными буквами
+wstring make_text(size_t size, uint64_t seed)
+{
+    CorpusOptions opts;
+    opts.seed = seed;
+    opts.punctuationRate = 0.1;
+    opts.lowercaseRate = 0.3;
+    return CorpusGenerator(opts).generate(size);
+}
+
+// Ожидаемый результат расшифрования: только буквы, прописные
+wstring letters_only(const wstring& s)
+{
+    wstring tmp;
+    for (auto c : s) {
+        if (iswalpha(c))
+            tmp.push_back(towupper(c));
+    }
+    return tmp;
+}
+
+// Размеры входа: от 16K до 4M символов с шагом 4
+vector<size_t> sizes()
+{
+    vector<size_t> v;
+    for (size_t n = 1 << 14; n <= 1 << 22; n *= 4)
+        v.push_back(n);
+    return v;
+}
+
+SUITE(GronsfeldStress)
+{
+    TEST(RoundTripAcrossSizesAndKeys)
+    {
+        const wchar_t* keys[] = { L"Б", L"ЭХО", L"ПРИВЕТ", L"КОРИЧНЕВАЯЛИСАИЛЕНИВАЯСОБАКА" };
+        for (auto key : keys) {
+            modAlphaCipher cipher(key);
+            for (size_t n = 1; n <= 1 << 20; n *= 8) {
+                wstring text = make_text(n + 1, n);
+                wstring open = letters_only(text);
+                if (open.empty())
+                    continue;
+                wstring encrypted = cipher.encrypt(text);
+                CHECK_EQUAL(open.size(), encrypted.size());
+                CHECK(open == cipher.decrypt(encrypted));
+            }
+        }
+    }
+
+    TEST(EncryptTimeAndMemoryAreLinear)
+    {
+        modAlphaCipher cipher(L"ПРИВЕТ");
+        vector<double> time, memory;
+        for (size_t n : sizes()) {
+            wstring text = make_text(n, 1);
+            Measurement m = measure([&] { cipher.encrypt(text); });
+            time.push_back(m.seconds / n);
+            memory.push_back(double(m.peakBytes) / n);
+        }
+        CHECK(spread(time) < timeTolerance);
+        CHECK(spread(memory) < memoryTolerance);
+    }
+
+    // Короткое сообщение и результат на стеке: ни одного обращения к куче
+    TEST(ShortMessagesDoNotAllocate)
+    {
+        modAlphaCipher cipher(L"ПРИВЕТ");
+        for (size_t n : { 1, 16, 64, 128 }) {
+            wstring text = make_text(n - 1, n) + L"Я";
+            wchar_t encrypted[128], decrypted[128];
+            size_t length = 0;
+            Measurement m = measure([&] {
+                length = cipher.encrypt(text.data(), text.size(), encrypted);
+                cipher.decrypt(encrypted, length, decrypted);
+            });
+            CHECK(m.peakBytes == 0);
+            CHECK(letters_only(text) == wstring(decrypted, length));
+        }
+    }
+
+    // Ключ подаётся окнами по 4K символов: время линейно, куча не нужна
+    TEST(RunningKeyStreamsWithoutAllocation)
+    {
+        runningKeyCipher cipher;
+        vector<double> time;
+        for (size_t n : sizes()) {
+            wstring text = make_text(n, 3);
+            wstring key = make_text(2 * n, 4);
+            vector<wchar_t> out(n);
+            size_t written = 0;
+            Measurement m = measure([&] {
+                size_t read = 0, k = 0;
+                written = 0;
+                while (read < text.size() && k < key.size()) {
+                    size_t window = min<size_t>(4096, key.size() - k);
+                    runningKeyCipher::Step step = cipher.encrypt(text.data() + read, text.size() - read,
+                                                                 key.data() + k, window, out.data() + written);
+                    read += step.read;
+                    k += step.keyRead;
+                    written += step.written;
+                }
+            });
+            time.push_back(m.seconds / n);
+            CHECK(m.peakBytes == 0);
+            CHECK(letters_only(text).size() == written);
+        }
+        CHECK(spread(time) < timeTolerance);
+    }
+
+    // Замена 4K букв на месте: время не зависит от длины шифртекста, куча не нужна
+    TEST(PatchTimeIsIndependentOfLength)
+    {
+        modAlphaCipher cipher(L"ПРИВЕТ");
+        wstring patch = make_text(4096, 6);
+        vector<double> time;
+        for (size_t n : sizes()) {
+            wstring encrypted = cipher.encrypt(make_text(n, 5));
+            Measurement m = measure([&] { cipher.patch(encrypted, encrypted.size() / 2, patch); });
+            time.push_back(m.seconds);
+            CHECK(m.peakBytes == 0);
+        }
+        CHECK(spread(time) < timeTolerance);
+    }
+
+    // Результат вида пишется прямо в буфер вывода: время линейно, куча не нужна
+    TEST(EncryptViewStreamsWithoutAllocation)
+    {
+        modAlphaCipher cipher(L"ПРИВЕТ");
+        vector<double> time;
+        for (size_t n : sizes()) {
+            wstring text = make_text(n, 7);
+            wchar_t block[4096];
+            size_t written = 0;
+            Measurement m = measure([&] {
+                size_t used = 0;
+                written = 0;
+                for (wchar_t c : cipher.encryptView(text)) {
+                    block[used++] = c;
+                    if (used == 4096) {
+                        written += used;
+                        used = 0;
+                    }
+                }
+                written += used;
+            });
+            time.push_back(m.seconds / n);
+            CHECK(m.peakBytes == 0);
+            CHECK_EQUAL(letters_only(text).size(), written);
+        }
+        CHECK(spread(time) < timeTolerance);
+    }
+
+    // Тысяча ключей для короткого текста: набор ключей выделяет память
+    // считанное число раз, а цикл modAlphaCipher(key).encrypt(text) — на каждый ключ
+    TEST(MultiKeyAllocatesOncePerKeySet)
+    {
+        vector<wstring> keys;
+        CorpusOptions opts;
+        opts.punctuationRate = 0;
+        opts.lowercaseRate = 0;
+        for (uint64_t i = 0; i < 1000; i++) {
+            opts.seed = i + 1;
+            wstring key = letters_only(CorpusGenerator(opts).generate(4 + i % 29));
+            keys.push_back(key.empty() ? wstring(L"КЛЮЧ") : key);
+        }
+        wstring text = make_text(256, 3);
+        multiKeyCipher cipher(keys);
+        vector<wstring> expected;
+        Measurement loop = measure([&] {
+            expected.clear();
+            for (const wstring& key : keys)
+                expected.push_back(modAlphaCipher(key).encrypt(text));
+        });
+        wstring matrix;
+        Measurement batch = measure([&] { matrix = cipher.encrypt(text); });
+        size_t n = expected[0].size();
+        for (size_t i = 0; i < keys.size(); i++)
+            CHECK(expected[i] == matrix.substr(i * n, n));
+        CHECK(loop.allocations >= keys.size());
+        CHECK(batch.allocations < 10);
+    }
+
+    TEST(DecryptTimeAndMemoryAreLinear)
+    {
+        modAlphaCipher cipher(L"ПРИВЕТ");
+        vector<double> time, memory;
+        for (size_t n : sizes()) {
+            wstring encrypted = cipher.encrypt(make_text(n, 2));
+            Measurement m = measure([&] { cipher.decrypt(encrypted); });
+            time.push_back(m.seconds / n);
+            memory.push_back(double(m.peakBytes) / n);
+        }
+        CHECK(spread(time) < timeTolerance);
+        CHECK(spread(memory) < memoryTolerance);
+    }
+}
+
+int main()
+{
+    init_locale();
+    return UnitTest::RunAllTests();
+}
@@ -0,0 +1,145 @@
+/**
+ * @file keyword_cipher.cpp
+ * @brief Реализация вертикальной перестановки с ключевым словом
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "keyword_cipher.h"
+#include <algorithm>
+
+namespace {
+
+/// Место прописной русской буквы в алфавите (Ё — между Е и Ж)
+int alphabetRank(wchar_t c) {
+    return c == L'Ё' ? 2 * (L'Е' - L'А') + 1 : 2 * (c - L'А');
+}
+
+/// Перенос буквы: при зашифровании — из таблицы в шифртекст, при расшифровании — обратно
+inline void transfer(const wchar_t* cell, wchar_t* letter) {
+    *letter = *cell;
+}
+inline void transfer(wchar_t* cell, const wchar_t* letter) {
+    *cell = *letter;
+}
+
+} // namespace
+
+KeywordCipher::KeywordCipher(const std::wstring& keyword) {
+    if (keyword.empty()) {
+        throw cipher_error("Keyword must not be empty");
+    }
+    std::vector<int> ranks;
+    for (wchar_t c : keyword) {
+        if (!isRussianLetter(c)) {
+            throw cipher_error("Keyword must contain only Russian letters");
+        }
+        ranks.push_back(alphabetRank(toUpperRussian(c)));
+    }
+    // Одинаковые буквы сохраняют порядок столбцов слева направо
+    order.resize(keyword.size());
+    for (std::size_t c = 0; c < order.size(); ++c) {
+        order[c] = static_cast<std::int64_t>(c);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::int64_t a, std::int64_t b) {
+        return ranks[a] < ranks[b];
+    });
+}
+
+std::wstring KeywordCipher::encrypt(const std::wstring& text) const {
+    std::wstring result(text.size(), L'\0');
+    if (text.size() <= shortMessage) {
+        wchar_t letters[shortMessage];
+        result.resize(encryptInto(text.data(), text.size(), &result[0], letters));
+    } else {
+        std::wstring letters(text.size(), L'\0');
+        result.resize(encryptInto(text.data(), text.size(), &result[0], &letters[0]));
+    }
+    return result;
+}
+
+std::wstring KeywordCipher::decrypt(const std::wstring& cipherText) const {
+    std::wstring result(cipherText.size(), L'\0');
+    decrypt(cipherText.data(), cipherText.size(), &result[0]);
+    return result;
+}
+
+std::size_t KeywordCipher::encrypt(const wchar_t* text, std::size_t length, wchar_t* out) const {
+    if (length <= shortMessage) {
+        wchar_t letters[shortMessage];
+        return encryptInto(text, length, out, letters);
+    }
+    std::vector<wchar_t> letters(length);
+    return encryptInto(text, length, out, letters.data());
+}
+
+std::size_t KeywordCipher::decrypt(const wchar_t* cipherText, std::size_t length, wchar_t* out) const {
+    // isRussianLetter принимает буквы обоих регистров: towupper не нужен
+    for (std::size_t k = 0; k < length; ++k) {
+        if (!isRussianLetter(cipherText[k])) {
+            throw cipher_error("Cipher text must contain only Russian letters");
+        }
+    }
+    transpose(out, static_cast<std::int64_t>(length), cipherText);
+    return length;
+}
+
+std::size_t KeywordCipher::encryptInto(const wchar_t* text, std::size_t length, wchar_t* out,
+                                       wchar_t* letters) const {
+    if (length == 0) {
+        return 0;
+    }
+    std::size_t count = 0;
+    for (std::size_t k = 0; k < length; ++k) {
+        wchar_t c = text[k];
+        if (c != L' ') {
+            if (!isRussianLetter(c)) {
+                throw cipher_error("Text must contain only Russian letters and spaces");
+            }
+            letters[count++] = toUpperRussian(c);
+        }
+    }
+    if (count == 0) {
+        throw cipher_error("Text must contain at least one letter");
+    }
+    transpose(static_cast<const wchar_t*>(letters), static_cast<std::int64_t>(count), out);
+    return count;
+}
+
+template <class Table, class Stream>
+void KeywordCipher::transpose(Table* table, std::int64_t length, Stream* stream) const {
+    const std::int64_t columns = this->columns();
+    const std::int64_t rows = length / columns; // Полные строки
+    const std::int64_t rest = length % columns; // Буквы неполной строки
+    std::int64_t tileRows = tileLetters / columns;
+    if (tileRows < lineLetters) {
+        tileRows = lineLetters;
+    }
+
+    // Столбец order[j] начинается в шифртексте после столбцов order[0..j-1]:
+    // в каждом rows букв и ещё одна, если столбец задевает неполную строку
+    for (std::int64_t first = 0; first < rows; first += tileRows) {
+        const std::int64_t count = std::min(tileRows, rows - first);
+        std::int64_t position = 0;
+        for (std::int64_t c : order) {
+            Table* cell = table + first * columns + c;
+            Stream* letter = stream + position + first;
+            for (std::int64_t r = 0; r < count; ++r, cell += columns) {
+                transfer(cell, letter + r);
+            }
+            position += rows + (c < rest ? 1 : 0);
+        }
+    }
+    if (rest > 0) {
+        std::int64_t position = 0;
+        for (std::int64_t c : order) {
+            if (c < rest) {
+                transfer(table + rows * columns + c, stream + position + rows);
+                ++position;
+            }
+            position += rows;
+        }
+    }
+}
@@ -0,0 +1,110 @@
+/**
+ * @file keyword_cipher.h
+ * @brief Вертикальная перестановка с ключевым словом
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Режим табличной перестановки RouteCipher с маршрутом «rows:columns»,
+ * в котором столбцы считываются не слева направо, а в алфавитном порядке
+ * букв ключевого слова. Таблица не строится: перестановка выполняется
+ * блоками строк, которые помещаются в кэш L1, поэтому текст читается и
+ * шифртекст пишется по одному разу.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "cipher.h"
+#include "cipher_error.h"
+#include "route_cipher.h"
+
+/**
+ * @brief Шифр вертикальной перестановки с ключевым словом
+ * @details Текст записывается в таблицу по строкам слева направо; число
+ *          столбцов равно длине ключевого слова, последняя строка может
+ *          быть неполной. Шифртекст — столбцы таблицы сверху вниз в порядке
+ *          букв ключевого слова по алфавиту (Ё — после Е), столбцы с
+ *          одинаковыми буквами — слева направо. Ключевое слово из букв по
+ *          алфавиту даёт тот же шифртекст, что RouteCipher с маршрутом
+ *          «rows:columns». Требования к тексту и шифртексту — как у RouteCipher.
+ * @see CipherInterface — общий интерфейс шифров и цепочки (then)
+ */
+class KeywordCipher : public CipherInterface<KeywordCipher> {
+private:
+    std::vector<std::int64_t> order; ///< Номера столбцов в порядке считывания
+    /// Наибольшая длина текста, буквы которого собираются в буфере на стеке
+    static const std::size_t shortMessage = 128;
+    /// Размер блока строк, символов: блок таблицы помещается в кэш L1
+    static const std::int64_t tileLetters = 4096;
+    /// Наименьшее число строк блока: столбец блока занимает целую строку кэша
+    static const std::int64_t lineLetters = 16;
+    /**
+     * @brief Зашифрование с заданным буфером для букв текста
+     * @param[in] letters Буфер не меньше length символов
+     * @return Длина шифртекста
+     */
+    std::size_t encryptInto(const wchar_t* text, std::size_t length, wchar_t* out, wchar_t* letters) const;
+    /**
+     * @brief Перестановка между таблицей (буквы по строкам) и шифртекстом (по столбцам)
+     * @details Строки обрабатываются блоками по max(lineLetters,
+     *          tileLetters / столбцов): блок читается из кэша, а каждый
+     *          столбец блока пишется (читается) в шифртексте подряд.
+     *          Направление задаёт константность: сторона const wchar_t
+     *          только читается.
+     * @tparam Table, Stream const wchar_t и wchar_t при зашифровании
+     *         (stream[k] = table[at(k)]), wchar_t и const wchar_t при
+     *         расшифровании (table[at(k)] = stream[k])
+     */
+    template <class Table, class Stream>
+    void transpose(Table* table, std::int64_t length, Stream* stream) const;
+public:
+    /**
+     * @brief Конструктор
+     * @param[in] keyword Ключевое слово из русских букв (регистр не учитывается)
+     * @throw cipher_error Если ключевое слово пустое или содержит другие символы
+     */
+    explicit KeywordCipher(const std::wstring& keyword);
+    /**
+     * @brief Зашифрование текста
+     * @param[in] text Текст из русских букв и пробелов
+     * @return Шифртекст (русские прописные буквы)
+     * @throw cipher_error Если текст не содержит букв или содержит недопустимые символы
+     */
+    std::wstring encrypt(const std::wstring& text) const;
+    /**
+     * @brief Расшифрование текста
+     * @param[in] cipherText Шифртекст из русских букв
+     * @return Открытый текст: буквы переставляются без изменения регистра,
+     *         поэтому шифртекст encrypt() даёт прописные буквы
+     * @throw cipher_error Если шифртекст содержит недопустимые символы
+     */
+    std::wstring decrypt(const std::wstring& cipherText) const;
+    /**
+     * @brief Зашифрование в память вызывающего
+     * @details Для текста не длиннее 128 символов промежуточные данные
+     *          находятся на стеке.
+     * @param[out] out Буфер не меньше length символов
+     * @return Длина шифртекста
+     * @throw cipher_error Как у encrypt(const std::wstring&)
+     */
+    std::size_t encrypt(const wchar_t* text, std::size_t length, wchar_t* out) const;
+    /**
+     * @brief Расшифрование в память вызывающего без промежуточных буферов
+     * @param[out] out Буфер не меньше length символов
+     * @return Длина результата (равна length)
+     * @throw cipher_error Как у decrypt(const std::wstring&)
+     */
+    std::size_t decrypt(const wchar_t* cipherText, std::size_t length, wchar_t* out) const;
+    /// Количество столбцов таблицы (длина ключевого слова)
+    std::int64_t columns() const {
+        return static_cast<std::int64_t>(order.size());
+    }
+    /// Номера столбцов в порядке считывания
+    const std::vector<std::int64_t>& columnOrder() const {
+        return order;
+    }
+};
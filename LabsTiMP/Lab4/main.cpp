@@ -32,7 +32,7 @@ int main() {
     setlocale(LC_ALL, "ru_RU.UTF-8");
     
     int choice;
-    int key;
+    long long key;
     wstring text, result;
     
     do {
@@ -15,238 +15,223 @@
 #include <stdexcept>
 #include <locale>
 
-/**
- * @brief Преобразует русскую строчную букву в прописную
- * @param[in] c Символ для преобразования
- * @return Прописной символ или исходный символ, если он не является русской строчной буквой
- */
-wchar_t toUpperRussian(wchar_t c) {
-    if (c >= L'а' && c <= L'п') {
-        return c - (L'а' - L'А');
-    }
-    if (c >= L'р' && c <= L'я') {
-        return c - (L'р' - L'Р');
-    }
-    if (c == L'ё') {
-        return L'Ё';
-    }
-    
-    
-    return c;
-}
-
-/**
- * @brief Проверяет, является ли символ русской буквой
- * @param[in] c Символ для проверки
- * @return true, если символ является русской буквой (прописной или строчной, включая Ё/ё),
- *         false в противном случае
- */
-bool isRussianLetter(wchar_t c) {
-    
-    if ((c >= L'А' && c <= L'Я') || c == L'Ё') {
-        return true;
-    }
-    
-    if ((c >= L'а' && c <= L'я') || c == L'ё') {
-        return true;
-    }
-    return false;
-}
-
 /**
  * @brief Конструктор класса RouteCipher
  * @details Инициализирует количество столбцов таблицы и проверяет корректность ключа
  * @param[in] cols Количество столбцов таблицы
- * @throw cipher_error Если количество столбцов меньше или равно 0
+ * @param[in] routes Маршруты записи и считывания
+ * @throw cipher_error Если количество столбцов меньше или равно 0 или
+ *                     маршрут записи не поддерживается
  */
-RouteCipher::RouteCipher(int cols) : columns(cols) {
+RouteCipher::RouteCipher(std::int64_t cols, const RouteSpec& routes) : columns(cols), spec(routes) {
     if (cols <= 0) {
         throw cipher_error("Columns must be positive");
     }
+    if (!writableRoute(routes.write)) {
+        throw cipher_error(std::string("route cannot be used for writing: ") + routeName(routes.write));
+    }
 }
 
 /**
  * @brief Метод для зашифрования текста
- * @details Реализует алгоритм табличной маршрутной перестановки:
- *          1. Удаление пробелов и преобразование к прописным буквам
- *          2. Заполнение таблицы по горизонтали слева направо, сверху вниз
- *          3. Чтение таблицы по маршруту: сверху вниз, справа налево
+ * @details Таблица не строится: буквы текста без пробелов, приведённые к
+ *          прописным, сжимаются в буфер, и шифртекст выписывается из него в
+ *          порядке обхода route(). Для маршрута по умолчанию (сверху вниз,
+ *          справа налево) обход выполняет route_static::walk, вычисляя номер
+ *          буквы для каждой позиции по числу столбцов и длине текста.
+ *
+ *          Если столбцов больше, чем букв, маршрут даёт текст в обратном порядке
+ *          при любом числе лишних столбцов, поэтому ширина ограничивается
+ *          длиной текста.
  * @param[in] text Текст для зашифрования
  * @return Зашифрованная строка
  * @throw cipher_error Если текст пустой, не содержит русских букв или содержит
  *                     недопустимые символы
  */
 std::wstring RouteCipher::encrypt(const std::wstring& text) {
-    if (text.empty()) {
-        return L"";
+    return encryptText<std::wstring>(text.data(), text.size(), std::wstring::allocator_type());
+}
+
+/**
+ * @brief Метод для расшифрования текста
+ * @details k-я буква шифртекста ставится в позицию открытого текста, которую
+ *          обход route() проходит k-й; для маршрута по умолчанию это
+ *          route_static::walk. Проверка букв выполняется в том же проходе,
+ *          таблица не строится.
+ * @param[in] cipherText Зашифрованный текст
+ * @return Расшифрованная строка
+ * @throw cipher_error Если зашифрованный текст пустой, содержит недопустимые символы
+ *                     или возникла ошибка при расшифровании
+ */
+std::wstring RouteCipher::decrypt(const std::wstring& cipherText) {
+    std::wstring result(cipherText.size(), L'\0');
+    decrypt(cipherText.data(), cipherText.size(), &result[0]);
+    return result;
+}
+
+std::size_t RouteCipher::encrypt(const wchar_t* text, std::size_t length, wchar_t* out) const {
+    if (length <= shortMessage) {
+        wchar_t letters[shortMessage];
+        return encryptInto(text, length, out, letters);
     }
-    
-    std::wstring processedText;
+    std::vector<wchar_t> letters(length);
+    return encryptInto(text, length, out, letters.data());
+}
+
+std::size_t RouteCipher::decrypt(const wchar_t* cipherText, std::size_t length, wchar_t* out) const {
+    // k-я буква шифртекста стоит в ячейке, которую маршрут проходит k-й
+    if (spec != RouteSpec()) {
+        // Проверяем, что зашифрованный текст содержит только русские буквы
+        for (std::size_t k = 0; k < length; ++k) {
+            wchar_t upperChar = std::towupper(cipherText[k]);
+            if (!isRussianLetter(upperChar)) {
+                throw cipher_error("Cipher text must contain only Russian letters");
+            }
+        }
+        plan(static_cast<std::int64_t>(length))->scatter(cipherText, 0, static_cast<std::int64_t>(length), out);
+        return length;
+    }
+    // Маршрут по умолчанию: буквы проверяются в том же проходе, что и
+    // раскладываются по ячейкам, ошибка сообщается после него
+    std::size_t index = 0;
+    bool letters = true;
+    route(static_cast<std::int64_t>(length), [&](std::int64_t i) {
+        wchar_t c = cipherText[index++];
+        letters &= isRussianLetter(static_cast<wchar_t>(std::towupper(c)));
+        out[i] = c;
+    });
+    if (!letters) {
+        throw cipher_error("Cipher text must contain only Russian letters");
+    }
+    
+    return length;
+}
+
+std::size_t RouteCipher::decryptRange(const wchar_t* cipherText, std::size_t length, std::size_t offset,
+                                      std::size_t count, wchar_t* out) const {
+    if (offset > length || count > length - offset) {
+        throw cipher_error("Range is outside the cipher text");
+    }
+    // Буква открытого текста номер i — буква шифртекста номер k
+    std::int64_t from = static_cast<std::int64_t>(offset);
+    cellRange(static_cast<std::int64_t>(length), from, static_cast<std::int64_t>(offset + count), [&](std::int64_t i, std::int64_t k) {
+        wchar_t c = cipherText[k];
+        if (!isRussianLetter(std::towupper(c))) {
+            throw cipher_error("Cipher text must contain only Russian letters");
+        }
+        out[i - from] = c;
+    });
+    return count;
+}
+
+std::wstring RouteCipher::decryptRange(const std::wstring& cipherText, std::size_t offset,
+                                       std::size_t count) const {
+    if (offset > cipherText.size() || count > cipherText.size() - offset) {
+        throw cipher_error("Range is outside the cipher text");
+    }
+    std::wstring result(count, L'\0');
+    decryptRange(cipherText.data(), cipherText.size(), offset, count, &result[0]);
+    return result;
+}
+
+RouteView RouteCipher::encryptView(const std::wstring& text) const {
+    std::shared_ptr<RouteView::Data> data = std::make_shared<RouteView::Data>();
+    data->letters.reserve(text.size());
     for (wchar_t c : text) {
         if (c != L' ') {
-            
             if (!isRussianLetter(c)) {
                 throw cipher_error("Text must contain only Russian letters and spaces");
             }
-            wchar_t upperChar = toUpperRussian(c);
-            processedText += upperChar;
+            data->letters.push_back(toUpperRussian(c));
         }
     }
-    
-    if (processedText.empty()) {
+    if (!text.empty() && data->letters.empty()) {
         throw cipher_error("Text must contain at least one letter");
     }
-    
-    int textLength = processedText.length();
-    int rows = (textLength + columns - 1) / columns;
-    
-    if (rows <= 0) {
-        throw cipher_error("Invalid table dimensions");
-    }
-    
-    std::vector<std::vector<wchar_t>> table(rows, std::vector<wchar_t>(columns, L' '));
-    int index = 0;
-    
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < columns; ++j) {
-            if (index < textLength) {
-                table[i][j] = processedText[index++];
-            }
-        }
-    }
-    
-    std::wstring result;
-    
-    int top = 0, bottom = rows - 1;
-    int left = 0, right = columns - 1;
-    
-    while (top <= bottom && left <= right) {
-        
-        for (int i = top; i <= bottom; ++i) {
-            if (table[i][right] != L' ') {
-                result += table[i][right];
-            }
-        }
-        right--;
-        
-        
-        if (top <= bottom) {
-            for (int j = right; j >= left; --j) {
-                if (table[bottom][j] != L' ') {
-                    result += table[bottom][j];
-                }
-            }
-            bottom--;
-        }
-        
-        
-        if (left <= right) {
-            for (int i = bottom; i >= top; --i) {
-                if (table[i][left] != L' ') {
-                    result += table[i][left];
-                }
-            }
-            left++;
-        }
-    }
-    
-    return result;
+
+    // k-й символ вида — буква, которую маршрут считывания проходит k-й
+    std::int64_t length = static_cast<std::int64_t>(data->letters.size());
+    data->order.reserve(length);
+    route(length, [&](std::int64_t i) {
+        data->order.push_back(i);
+    });
+    return RouteView(data);
 }
 
-/**
- * @brief Метод для расшифрования текста
- * @details Реализует обратный алгоритм табличной маршрутной перестановки:
- *          1. Заполнение таблицы зашифрованным текстом по маршруту чтения
- *          2. Чтение таблицы по строкам слева направо
- * @param[in] cipherText Зашифрованный текст
- * @return Расшифрованная строка
- * @throw cipher_error Если зашифрованный текст пустой, содержит недопустимые символы
- *                     или возникла ошибка при расшифровании
- */
-std::wstring RouteCipher::decrypt(const std::wstring& cipherText) {
-    if (cipherText.empty()) {
-        return L"";
-    }
-    
-    // Проверяем, что зашифрованный текст содержит только русские буквы
+RouteView RouteCipher::decryptView(const std::wstring& cipherText) const {
     for (wchar_t c : cipherText) {
-        wchar_t upperChar = std::towupper(c);
-        if (!isRussianLetter(upperChar)) {
+        if (!isRussianLetter(static_cast<wchar_t>(std::towupper(c)))) {
             throw cipher_error("Cipher text must contain only Russian letters");
         }
     }
-    
-    int textLength = cipherText.length();
-    int rows = (textLength + columns - 1) / columns;
-    
-    if (rows <= 0) {
-        throw cipher_error("Invalid table dimensions for decryption");
+    std::shared_ptr<RouteView::Data> data = std::make_shared<RouteView::Data>();
+    data->letters = cipherText;
+
+    // i-й символ вида — буква шифртекста, которая стоит в i-й ячейке
+    std::int64_t length = static_cast<std::int64_t>(cipherText.size());
+    data->order.resize(length);
+    cellRange(length, 0, length, [&](std::int64_t i, std::int64_t k) {
+        data->order[i] = k;
+    });
+    return RouteView(data);
+}
+
+#if __cplusplus >= 201703L
+std::pmr::wstring RouteCipher::encrypt(std::wstring_view text, std::pmr::memory_resource* resource) const {
+    return encryptText<std::pmr::wstring>(text.data(), text.size(), resource);
+}
+
+std::pmr::wstring RouteCipher::decrypt(std::wstring_view cipherText, std::pmr::memory_resource* resource) const {
+    std::pmr::wstring result(cipherText.size(), L'\0', resource);
+    decrypt(cipherText.data(), cipherText.size(), result.data());
+    return result;
+}
+#endif
+
+std::size_t RouteCipher::encryptInto(const wchar_t* text, std::size_t length, wchar_t* out, wchar_t* letters) const {
+    if (length == 0) {
+        return 0;
     }
     
-    // ВАЖНО: создаем таблицу и сначала определяем, какие ячейки будут заполнены
-    std::vector<std::vector<wchar_t>> table(rows, std::vector<wchar_t>(columns, L' '));
-    std::vector<std::vector<bool>> filled(rows, std::vector<bool>(columns, false));
-    
-    // Сначала заполняем таблицу построчно (как при шифровании)
-    int index = 0;
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < columns; ++j) {
-            if (index < textLength) {
-                filled[i][j] = true;
+    std::size_t count = 0;
+    for (std::size_t k = 0; k < length; ++k) {
+        wchar_t c = text[k];
+        if (c != L' ') {
+            
+            if (!isRussianLetter(c)) {
+                throw cipher_error("Text must contain only Russian letters and spaces");
             }
-            index++;
+            letters[count++] = toUpperRussian(c);
         }
     }
     
-    // Теперь заполняем по спирали только те ячейки, которые должны быть заполнены
-    int top = 0, bottom = rows - 1;
-    int left = 0, right = columns - 1;
-    index = 0;
-    
-    while (top <= bottom && left <= right && index < textLength) {
-        // Правый столбец сверху вниз
-        for (int i = top; i <= bottom && index < textLength; ++i) {
-            if (filled[i][right]) {
-                table[i][right] = cipherText[index++];
-            }
-        }
-        right--;
-        
-        // Нижняя строка справа налево
-        if (top <= bottom) {
-            for (int j = right; j >= left && index < textLength; --j) {
-                if (filled[bottom][j]) {
-                    table[bottom][j] = cipherText[index++];
-                }
-            }
-            bottom--;
-        }
-        
-        // Левый столбец снизу вверх
-        if (left <= right) {
-            for (int i = bottom; i >= top && index < textLength; --i) {
-                if (filled[i][left]) {
-                    table[i][left] = cipherText[index++];
-                }
-            }
-            left++;
-        }
+    if (count == 0) {
+        throw cipher_error("Text must contain at least one letter");
     }
     
-    // Проверяем, что все символы были использованы
-    if (index != textLength) {
-        throw cipher_error("Decryption error: not all characters were placed in table");
+    // Ячейки таблицы читаются по маршруту прямо из буфера букв
+    if (spec != RouteSpec()) {
+        plan(static_cast<std::int64_t>(count))->gather(letters, 0, static_cast<std::int64_t>(count), out);
+        return count;
     }
+    std::size_t index = 0;
+    route(static_cast<std::int64_t>(count), [&](std::int64_t i) {
+        out[index++] = letters[i];
+    });
     
-    // Читаем результат построчно (пропуская пустые ячейки)
-    std::wstring result;
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < columns; ++j) {
-            if (filled[i][j]) {
-                result += table[i][j];
-            }
-        }
+    return count;
+}
+
+template <class String>
+String RouteCipher::encryptText(const wchar_t* text, std::size_t length,
+                                const typename String::allocator_type& alloc) const {
+    String result(length, L'\0', alloc);
+    if (length <= shortMessage) {
+        wchar_t letters[shortMessage];
+        result.resize(encryptInto(text, length, &result[0], letters));
+    } else {
+        String letters(length, L'\0', alloc);
+        result.resize(encryptInto(text, length, &result[0], &letters[0]));
     }
-    
     return result;
-}
\ No newline at end of file
+}
@@ -8,30 +8,179 @@
  * @warning Это реализация шифра табличной маршрутной перестановки
  * 
  * Данный файл содержит объявление класса RouteCipher, реализующего шифрование
- * методом табличной маршрутной перестановки, а также класса исключения cipher_error.
+ * методом табличной маршрутной перестановки. Класс исключения cipher_error
+ * определён в cipher_error.h.
  */
 
 #pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <stdexcept>
+#include <vector>
+#include "cipher.h"
+#include "cipher_error.h"
+#include "route_plan.h"
+#include "route_static.h"
+#if __cplusplus >= 201703L
+#include <memory_resource>
+#include <string_view>
+#endif
+#if __cplusplus >= 202002L
+#include <ranges>
+#endif
+
+/**
+ * @brief Преобразует русскую строчную букву в прописную
+ * @param[in] c Символ для преобразования
+ * @return Прописной символ или исходный символ, если он не является русской строчной буквой
+ */
+inline wchar_t toUpperRussian(wchar_t c) {
+    return route_static::toUpper(c);
+}
+
+/**
+ * @brief Проверяет, является ли символ русской буквой
+ * @param[in] c Символ для проверки
+ * @return true, если символ является русской буквой (прописной или строчной, включая Ё/ё)
+ */
+inline bool isRussianLetter(wchar_t c) {
+    return route_static::isLetter(c);
+}
+
+/**
+ * @brief Ленивый вид результата шифрования с произвольным доступом
+ * @details k-й символ вида — letters[order[k]]: буквы текста хранятся один
+ *          раз, перестановка вычисляется при создании вида, а символы
+ *          результата не копируются. Вид можно обходить в любом порядке,
+ *          передавать в итератор вывода или адаптерам диапазонов (в C++20 —
+ *          std::ranges::random_access_range и std::ranges::view).
+ *          Копирование вида не копирует данные. Итераторы действительны,
+ *          пока существует вид или его копия.
+ */
+class RouteView
+#if __cplusplus >= 202002L
+    : public std::ranges::view_interface<RouteView>
+#endif
+{
+public:
+    /// Буквы текста и перестановка
+    struct Data {
+        std::wstring letters;   ///< Буквы текста (нормализованного открытого или шифртекста)
+        std::vector<std::int64_t> order; ///< Номер буквы letters для каждой позиции вида
+    };
+
+    /**
+     * @brief Итератор произвольного доступа по символам вида
+     */
+    class iterator {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef wchar_t value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const wchar_t* pointer;
+        typedef const wchar_t& reference;
+
+        iterator() : data(nullptr), pos(0) {}
+        iterator(const Data* data, difference_type pos) : data(data), pos(pos) {}
+
+        reference operator*() const { return data->letters[data->order[pos]]; }
+        pointer operator->() const { return &**this; }
+        reference operator[](difference_type n) const { return data->letters[data->order[pos + n]]; }
+
+        iterator& operator++() { ++pos; return *this; }
+        iterator operator++(int) { iterator old = *this; ++pos; return old; }
+        iterator& operator--() { --pos; return *this; }
+        iterator operator--(int) { iterator old = *this; --pos; return old; }
+        iterator& operator+=(difference_type n) { pos += n; return *this; }
+        iterator& operator-=(difference_type n) { pos -= n; return *this; }
+        friend iterator operator+(iterator it, difference_type n) { return it += n; }
+        friend iterator operator+(difference_type n, iterator it) { return it += n; }
+        friend iterator operator-(iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const iterator& a, const iterator& b) { return a.pos - b.pos; }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.pos == b.pos; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return a.pos != b.pos; }
+        friend bool operator<(const iterator& a, const iterator& b) { return a.pos < b.pos; }
+        friend bool operator>(const iterator& a, const iterator& b) { return a.pos > b.pos; }
+        friend bool operator<=(const iterator& a, const iterator& b) { return a.pos <= b.pos; }
+        friend bool operator>=(const iterator& a, const iterator& b) { return a.pos >= b.pos; }
+
+    private:
+        const Data* data;
+        difference_type pos;
+    };
+
+    RouteView() {}
+    explicit RouteView(std::shared_ptr<const Data> data) : data(std::move(data)) {}
+
+    iterator begin() const { return iterator(data.get(), 0); }
+    iterator end() const { return iterator(data.get(), static_cast<std::ptrdiff_t>(size())); }
+    /// Количество символов
+    std::size_t size() const { return data ? data->order.size() : 0; }
+    bool empty() const { return size() == 0; }
+    /// Символ номер k, 0 <= k < size()
+    const wchar_t& operator[](std::size_t k) const { return data->letters[data->order[k]]; }
+
+private:
+    std::shared_ptr<const Data> data;
+};
 
 /**
  * @brief Класс для шифрования методом табличной маршрутной перестановки
  * @details Реализует шифр табличной маршрутной перестановки для русского текста.
  *          Ключом является количество столбцов таблицы. Маршрут записи: по горизонтали 
  *          слева направо, сверху вниз. Маршрут считывания: сверху вниз, справа налево.
+ *          Другие маршруты записи и считывания задаются RouteSpec; для них
+ *          перестановка компилируется в RoutePlan для каждой длины текста,
+ *          последний план используется повторно.
  * @warning Реализация поддерживает только русские буквы и пробелы
+ * @see CipherInterface — общий интерфейс шифров и цепочки (then)
  */
-class RouteCipher {
+class RouteCipher : public CipherInterface<RouteCipher> {
 private:
-    int columns; ///< Количество столбцов таблицы (ключ шифрования)
+    std::int64_t columns; ///< Количество столбцов таблицы (ключ шифрования)
+    RouteSpec spec; ///< Маршруты записи и считывания
+    /// Последний построенный план; читается и заменяется через std::atomic_load/atomic_store
+    mutable std::shared_ptr<const RoutePlan> lastPlan;
+    /// Наибольшая длина текста, буквы которого собираются в буфере на стеке
+    static const std::size_t shortMessage = 128;
+    /**
+     * @brief Зашифрование с заданным буфером для букв текста
+     * @details Буквы переписываются в letters, шифртекст собирается из них
+     *          обходом route() без построения таблицы.
+     * @param[in] letters Буфер не меньше length символов
+     * @return Длина шифртекста
+     */
+    std::size_t encryptInto(const wchar_t* text, std::size_t length, wchar_t* out, wchar_t* letters) const;
+    /**
+     * @brief Общая реализация encrypt() для строк с любым распределителем памяти
+     * @details Буквы короткого текста собираются на стеке, длинного — в строке
+     *          с распределителем alloc.
+     */
+    template <class String>
+    String encryptText(const wchar_t* text, std::size_t length, const typename String::allocator_type& alloc) const;
 public:
     /**
      * @brief Конструктор класса RouteCipher
      * @param[in] cols Количество столбцов таблицы (должно быть положительным числом)
-     * @throw cipher_error Если количество столбцов меньше или равно 0
+     * @param[in] routes Маршруты записи и считывания
+     * @throw cipher_error Если количество столбцов меньше или равно 0 или
+     *                     маршрут записи не поддерживается (writableRoute)
      */
-    RouteCipher(int cols);
+    RouteCipher(std::int64_t cols, const RouteSpec& routes = RouteSpec());
+    /// Копия разделяет с оригиналом последний построенный план
+    RouteCipher(const RouteCipher& other)
+        : columns(other.columns), spec(other.spec), lastPlan(std::atomic_load(&other.lastPlan)) {}
+    RouteCipher& operator=(const RouteCipher& other) {
+        columns = other.columns;
+        spec = other.spec;
+        std::atomic_store(&lastPlan, std::atomic_load(&other.lastPlan));
+        return *this;
+    }
     /**
      * @brief Метод для зашифрования текста
      * @param[in] text Текст для зашифрования. Может содержать русские буквы и пробелы.
@@ -49,19 +198,161 @@ public:
      *                     символы или возникла ошибка при расшифровании
      */
     std::wstring decrypt(const std::wstring& cipherText);
-};
-
-/**
- * @brief Класс исключения для ошибок шифрования
- * @details Производный класс от std::invalid_argument для обработки ошибок,
- *          возникающих при шифровании и расшифровании
- */
-class cipher_error : public std::invalid_argument {
-public:
     /**
-     * @brief Конструктор класса cipher_error
-     * @param[in] message Сообщение об ошибке
+     * @brief Зашифрование в память вызывающего
+     * @details Для текста не длиннее 128 символов и маршрута по умолчанию
+     *          промежуточные данные находятся на стеке, поэтому при выходном
+     *          буфере на стеке вызов не обращается к куче.
+     * @param[in] text Текст для зашифрования
+     * @param[in] length Длина текста, символов
+     * @param[out] out Буфер не меньше length символов
+     * @return Длина шифртекста
+     * @throw cipher_error Как у encrypt(const std::wstring&)
+     */
+    std::size_t encrypt(const wchar_t* text, std::size_t length, wchar_t* out) const;
+    /**
+     * @brief Расшифрование в память вызывающего без промежуточных буферов
+     * @param[in] cipherText Зашифрованный текст
+     * @param[in] length Длина текста, символов
+     * @param[out] out Буфер не меньше length символов
+     * @return Длина результата (равна length)
+     * @throw cipher_error Как у decrypt(const std::wstring&)
+     */
+    std::size_t decrypt(const wchar_t* cipherText, std::size_t length, wchar_t* out) const;
+    /**
+     * @brief Расшифрование части текста: буквы открытого текста с номерами offset..offset+count-1
+     * @details Из шифртекста читаются (и проверяются) только count букв,
+     *          номера которых даёт cellRange(), таблица не строится. Для
+     *          маршрута по умолчанию время не зависит от длины шифртекста.
+     * @param[in] cipherText Весь шифртекст
+     * @param[in] length Длина шифртекста, символов
+     * @param[in] offset Номер первой буквы открытого текста
+     * @param[in] count Количество букв
+     * @param[out] out Буфер не меньше count символов
+     * @return Длина результата (равна count)
+     * @throw cipher_error Если диапазон выходит за пределы шифртекста или
+     *                     прочитанная буква недопустима
+     */
+    std::size_t decryptRange(const wchar_t* cipherText, std::size_t length, std::size_t offset, std::size_t count,
+                             wchar_t* out) const;
+    /**
+     * @brief Расшифрование части текста
+     * @param[in] cipherText Весь шифртекст
+     * @param[in] offset Номер первой буквы открытого текста
+     * @param[in] count Количество букв
+     * @return Буквы открытого текста с номерами offset..offset+count-1
+     * @throw cipher_error Как у decryptRange(const wchar_t*, std::size_t, std::size_t, std::size_t, wchar_t*)
+     */
+    std::wstring decryptRange(const std::wstring& cipherText, std::size_t offset, std::size_t count) const;
+    /**
+     * @brief Ленивое зашифрование: вид шифртекста с произвольным доступом
+     * @details Буквы текста проверяются и переписываются один раз, k-й
+     *          символ вида — буква, которую маршрут считывания проходит k-й.
+     *          Строка шифртекста не создаётся.
+     * @param[in] text Текст для зашифрования
+     * @return Вид, символы которого совпадают с encrypt(text)
+     * @throw cipher_error Как у encrypt(const std::wstring&)
+     */
+    RouteView encryptView(const std::wstring& text) const;
+    /**
+     * @brief Ленивое расшифрование: вид открытого текста с произвольным доступом
+     * @param[in] cipherText Зашифрованный текст
+     * @return Вид, символы которого совпадают с decrypt(cipherText)
+     * @throw cipher_error Как у decrypt(const std::wstring&)
      */
-    explicit cipher_error(const std::string& message) 
-        : std::invalid_argument(message) {}
-};
\ No newline at end of file
+    RouteView decryptView(const std::wstring& cipherText) const;
+#if __cplusplus >= 201703L
+    /**
+     * @brief Зашифрование с памятью из заданного источника
+     * @details Все буферы и результат выделяются из resource, поэтому служба
+     *          может выделить каждому запросу арену и освободить её целиком.
+     * @param[in] text Текст для зашифрования
+     * @param[in] resource Источник памяти
+     * @return Зашифрованная строка в памяти resource
+     * @throw cipher_error Как у encrypt(const std::wstring&)
+     */
+    std::pmr::wstring encrypt(std::wstring_view text, std::pmr::memory_resource* resource) const;
+    /**
+     * @brief Расшифрование с памятью из заданного источника
+     * @param[in] cipherText Зашифрованный текст
+     * @param[in] resource Источник памяти
+     * @return Расшифрованная строка в памяти resource
+     * @throw cipher_error Как у decrypt(const std::wstring&)
+     */
+    std::pmr::wstring decrypt(std::wstring_view cipherText, std::pmr::memory_resource* resource) const;
+#endif
+    /**
+     * @brief Обходит маршрут считывания без построения таблицы
+     * @details Вызывает visit(i) для номеров букв открытого текста в том порядке,
+     *          в котором они образуют шифртекст: k-й вызов соответствует k-й букве
+     *          шифртекста. Ячейка таблицы занята, если её номер при построчной
+     *          записи меньше textLength, поэтому обход не требует памяти и
+     *          позволяет собирать шифртекст прямо из исходного буфера.
+     * @param[in] textLength Количество букв текста
+     * @param[in] visit Функция, принимающая номер буквы открытого текста
+     */
+    template <class Visit>
+    void route(std::int64_t textLength, Visit visit) const {
+        routeRange(textLength, 0, textLength, visit);
+    }
+    /**
+     * @brief Обходит часть маршрута: буквы шифртекста с номерами from..to-1
+     * @details Маршрут по умолчанию обходит route_static::walk: длина каждого
+     *          отрезка витка вычисляется за O(1), поэтому начало диапазона
+     *          находится без обхода предыдущих букв, а независимые диапазоны
+     *          можно обходить параллельно. Прочие маршруты обходит RoutePlan.
+     * @param[in] textLength Количество букв текста
+     * @param[in] from Номер первой буквы шифртекста
+     * @param[in] to Номер буквы шифртекста за последней
+     * @param[in] visit Функция, принимающая номер буквы открытого текста
+     */
+    template <class Visit>
+    void routeRange(std::int64_t textLength, std::int64_t from, std::int64_t to, Visit visit) const {
+        if (spec == RouteSpec()) {
+            route_static::walk(columns, textLength, from, to, visit);
+        } else {
+            plan(textLength)->visit(from, to, visit);
+        }
+    }
+    /**
+     * @brief Обходит буквы открытого текста с номерами from..to-1 и сообщает,
+     *        где каждая стоит в шифртексте
+     * @details Вызывает visit(i, k), где k — номер буквы шифртекста, которая
+     *          при расшифровании становится i-й буквой открытого текста.
+     *          Для маршрута по умолчанию номер вычисляется за O(1) по геометрии
+     *          витков (route_static::cells), вызовы идут по порядку i; для
+     *          прочих маршрутов используется RoutePlan::cells, порядок не определён.
+     * @param[in] textLength Количество букв текста
+     * @param[in] from Номер первой буквы открытого текста
+     * @param[in] to Номер буквы открытого текста за последней
+     * @param[in] visit Функция, принимающая номера буквы открытого текста и шифртекста
+     */
+    template <class Visit>
+    void cellRange(std::int64_t textLength, std::int64_t from, std::int64_t to, Visit visit) const {
+        if (spec == RouteSpec()) {
+            route_static::cells(columns, textLength, from, to, visit);
+        } else {
+            plan(textLength)->cells(from, to, visit);
+        }
+    }
+    /**
+     * @brief План перестановки для текста из textLength букв
+     * @details Последний построенный план хранится в шифре и возвращается
+     *          повторно, пока длина текста не меняется, поэтому encrypt,
+     *          decrypt, routeRange() и cellRange() для текстов одной длины
+     *          компилируют его один раз. Вызов из нескольких потоков безопасен:
+     *          план неизменяем, при разных длинах потоки строят свои планы.
+     */
+    std::shared_ptr<const RoutePlan> plan(std::int64_t textLength) const {
+        std::shared_ptr<const RoutePlan> last = std::atomic_load(&lastPlan);
+        if (!last || last->length() != textLength) {
+            last = std::make_shared<const RoutePlan>(spec, columns, textLength);
+            std::atomic_store(&lastPlan, last);
+        }
+        return last;
+    }
+    /// Маршруты записи и считывания
+    const RouteSpec& routes() const {
+        return spec;
+    }
+};
@@ -0,0 +1,423 @@
+/**
+ * @file route_plan.cpp
+ * @brief Файл реализации маршрутов таблицы и плана перестановки
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "route_plan.h"
+
+namespace {
+
+const char* const names[] = {"rows",     "reversed-rows", "row-snake", "columns",
+                             "column-snake", "diagonal",  "spiral",    "counter-spiral"};
+const int routeCount = sizeof(names) / sizeof(names[0]);
+
+/// Перенос буквы: при сборе — из таблицы в поток, при раскладке — обратно
+inline void transfer(const wchar_t* cell, wchar_t* item) {
+    *item = *cell;
+}
+inline void transfer(wchar_t* cell, const wchar_t* item) {
+    *cell = *item;
+}
+
+/**
+ * @brief Строка из count ячеек table[j * stride] и поток stream[j]
+ * @tparam Table, Stream Читаемая сторона — const wchar_t
+ * @tparam Stride Шаг, известный при компиляции, или 0 — шаг stride
+ */
+template <class Table, class Stream>
+struct Line {
+    Table* table;
+    std::int64_t stride;
+    std::int64_t count;
+    Stream* stream;
+
+    template <int Stride>
+    void run() const {
+        const std::int64_t s = Stride ? Stride : stride;
+        Table* q = table;
+        std::int64_t j = 0;
+        for (; j + 4 <= count; j += 4, q += 4 * s) {
+            transfer(q, stream + j);
+            transfer(q + s, stream + j + 1);
+            transfer(q + 2 * s, stream + j + 2);
+            transfer(q + 3 * s, stream + j + 3);
+        }
+        for (; j < count; ++j, q += s) {
+            transfer(q, stream + j);
+        }
+    }
+};
+
+/**
+ * @brief rows строк по Count ячеек: строка o начинается с table[o * step]
+ * @tparam Count Длина строки от 1 до 8; внутренний цикл разворачивается полностью
+ */
+template <class Table, class Stream>
+struct Block {
+    Table* table;
+    std::int64_t stride;
+    std::int64_t step;
+    std::int64_t rows;
+    Stream* stream;
+
+    template <int Count>
+    void run() const {
+        Table* q = table;
+        Stream* item = stream;
+        for (std::int64_t o = 0; o < rows; ++o, q += step, item += Count) {
+            for (int j = 0; j < Count; ++j) {
+                transfer(q + j * stride, item + j);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Выбирает ядро строки по шагу
+ * @details Шаги ±1 (строки таблицы) и ±2..±8 (столбцы узких таблиц)
+ *          получают ядра с шагом-константой, остальные — общее ядро.
+ */
+template <class Kernel>
+void byStride(const Kernel& kernel, std::int64_t stride) {
+    switch (stride) {
+    case 1: kernel.template run<1>(); break;
+    case -1: kernel.template run<-1>(); break;
+    case 2: kernel.template run<2>(); break;
+    case -2: kernel.template run<-2>(); break;
+    case 3: kernel.template run<3>(); break;
+    case -3: kernel.template run<-3>(); break;
+    case 4: kernel.template run<4>(); break;
+    case -4: kernel.template run<-4>(); break;
+    case 5: kernel.template run<5>(); break;
+    case -5: kernel.template run<-5>(); break;
+    case 6: kernel.template run<6>(); break;
+    case -6: kernel.template run<-6>(); break;
+    case 7: kernel.template run<7>(); break;
+    case -7: kernel.template run<-7>(); break;
+    case 8: kernel.template run<8>(); break;
+    case -8: kernel.template run<-8>(); break;
+    default: kernel.template run<0>(); break;
+    }
+}
+
+/**
+ * @brief Выбирает ядро блока по длине строки (от 1 до 8)
+ */
+template <class Kernel>
+void byCount(const Kernel& kernel, std::int64_t count) {
+    switch (count) {
+    case 1: kernel.template run<1>(); break;
+    case 2: kernel.template run<2>(); break;
+    case 3: kernel.template run<3>(); break;
+    case 4: kernel.template run<4>(); break;
+    case 5: kernel.template run<5>(); break;
+    case 6: kernel.template run<6>(); break;
+    case 7: kernel.template run<7>(); break;
+    default: kernel.template run<8>(); break;
+    }
+}
+
+/// Наибольшая длина строки блока, для которой есть развёрнутое ядро
+const int unrolledCount = 8;
+
+} // namespace
+
+const char* routeName(Route route) {
+    return names[static_cast<int>(route)];
+}
+
+Route parseRoute(const std::string& name) {
+    for (int i = 0; i < routeCount; ++i) {
+        if (name == names[i]) {
+            return static_cast<Route>(i);
+        }
+    }
+    throw std::invalid_argument("unknown route: " + name);
+}
+
+bool writableRoute(Route route) {
+    return route == Route::Rows || route == Route::ReversedRows || route == Route::RowSnake ||
+           route == Route::Columns || route == Route::ColumnSnake;
+}
+
+RouteSpec parseRouteSpec(const std::string& spec) {
+    RouteSpec result;
+    std::size_t colon = spec.find(':');
+    if (colon == std::string::npos) {
+        result.read = parseRoute(spec);
+    } else {
+        result.write = parseRoute(spec.substr(0, colon));
+        result.read = parseRoute(spec.substr(colon + 1));
+    }
+    if (!writableRoute(result.write)) {
+        throw std::invalid_argument(std::string("route cannot be used for writing: ") + routeName(result.write));
+    }
+    return result;
+}
+
+RoutePlan::RoutePlan(const RouteSpec& spec, std::int64_t columns, std::int64_t textLength) : total(0) {
+    if (columns <= 0) {
+        throw std::invalid_argument("Columns must be positive");
+    }
+    if (!writableRoute(spec.write)) {
+        throw std::invalid_argument(std::string("route cannot be used for writing: ") + routeName(spec.write));
+    }
+    if (textLength <= 0) {
+        return;
+    }
+    const std::int64_t n = textLength;
+    const std::int64_t cols = std::min(columns, n);
+    const std::int64_t rows = (n + cols - 1) / cols;
+
+    // Номер ячейки при записи
+    auto written = [&](std::int64_t r, std::int64_t c) -> std::int64_t {
+        switch (spec.write) {
+        case Route::ReversedRows: return r * cols + cols - 1 - c;
+        case Route::RowSnake: return r * cols + (r % 2 ? cols - 1 - c : c);
+        case Route::Columns: return c * rows + r;
+        case Route::ColumnSnake: return c * rows + (c % 2 ? rows - 1 - r : r);
+        default: return r * cols + c;
+        }
+    };
+
+    // Прямая линия из length ячеек от (r, c) с шагом (dr, dc): занятые
+    // ячейки линии идут подряд, если номер при записи меняется вдоль линии
+    // линейно, иначе линия разбирается по ячейкам
+    auto line = [&](std::int64_t r, std::int64_t c, std::int64_t dr, std::int64_t dc, std::int64_t length) {
+        if (length <= 0) {
+            return;
+        }
+        // Змейка поперёк линии: номер меняется с периодом 2, поэтому пары
+        // соседних ячеек образуют блок; поверх диагонали — по ячейке
+        bool paired = (spec.write == Route::RowSnake && dr != 0) || (spec.write == Route::ColumnSnake && dc != 0);
+        if (paired) {
+            // Змейка заполняет строки (столбцы) по порядку, и линия
+            // пересекает каждую один раз, поэтому незаполненные ячейки
+            // линии находятся с одного её края
+            auto cell = [&](std::int64_t j) { return written(r + j * dr, c + j * dc); };
+            std::int64_t from = 0, to = length;
+            while (from < to && cell(from) >= n) {
+                from++;
+            }
+            while (from < to && cell(to - 1) >= n) {
+                to--;
+            }
+            bool periodic = (spec.write == Route::RowSnake ? dc : dr) == 0;
+            if (periodic && to - from >= 4) {
+                std::int64_t pairs = (to - from) / 2;
+                append(cell(from), cell(from + 1) - cell(from), 2, cell(from + 2) - cell(from), pairs);
+                from += 2 * pairs;
+            }
+            for (std::int64_t j = from; j < to; ++j) {
+                append(cell(j), 0, 1);
+            }
+            return;
+        }
+        std::int64_t w = written(r, c);
+        std::int64_t step = length > 1 ? written(r + dr, c + dc) - w : 0;
+        std::int64_t from = 0, to = length;
+        if (step > 0) {
+            to = w < n ? std::min(length, (n - w + step - 1) / step) : 0;
+        } else if (step < 0) {
+            from = w < n ? 0 : (w - n) / -step + 1;
+        } else if (w >= n) {
+            to = 0;
+        }
+        if (from < to) {
+            append(w + from * step, step, to - from);
+        }
+    };
+
+    // count параллельных линий одной длины, t-я начинается в (r + t * tr, c + t * tc).
+    // При линейной записи номера концов линии линейны и по t, поэтому
+    // целиком занятые линии образуют промежуток и дают один блок без обхода
+    // линий по одной — так компилируются строки узких таблиц
+    auto lines = [&](std::int64_t count, std::int64_t r, std::int64_t c, std::int64_t tr, std::int64_t tc, std::int64_t dr, std::int64_t dc, std::int64_t length) {
+        bool linear = spec.write == Route::Rows || spec.write == Route::ReversedRows || spec.write == Route::Columns;
+        std::int64_t low = 0, high = count;
+        if (linear && count >= 2) {
+            for (std::int64_t j = 0; j < length; j += std::max<std::int64_t>(length - 1, 1)) {
+                std::int64_t w = written(r + j * dr, c + j * dc);
+                std::int64_t step = written(r + tr + j * dr, c + tc + j * dc) - w;
+                if (step > 0) {
+                    high = std::min(high, w < n ? (n - w + step - 1) / step : 0);
+                } else if (step < 0) {
+                    low = std::max(low, w < n ? 0 : (w - n) / -step + 1);
+                } else if (w >= n) {
+                    high = 0;
+                }
+            }
+        } else {
+            high = 0;
+        }
+        if (high - low < 2) {
+            low = high = count;
+        }
+        for (std::int64_t t = 0; t < low; ++t) {
+            line(r + t * tr, c + t * tc, dr, dc, length);
+        }
+        if (low < high) {
+            std::int64_t w = written(r + low * tr, c + low * tc);
+            std::int64_t stride = length > 1 ? written(r + low * tr + dr, c + low * tc + dc) - w : 0;
+            append(w, stride, length, written(r + (low + 1) * tr, c + (low + 1) * tc) - w, high - low);
+        }
+        for (std::int64_t t = high; t < count; ++t) {
+            line(r + t * tr, c + t * tc, dr, dc, length);
+        }
+    };
+
+    switch (spec.read) {
+    case Route::Rows:
+    case Route::ReversedRows:
+        lines(rows, 0, spec.read == Route::Rows ? 0 : cols - 1, 1, 0, 0, spec.read == Route::Rows ? 1 : -1, cols);
+        break;
+    case Route::RowSnake:
+        for (std::int64_t r = 0; r < rows; ++r) {
+            line(r, r % 2 ? cols - 1 : 0, 0, r % 2 ? -1 : 1, cols);
+        }
+        break;
+    case Route::Columns:
+        lines(cols, 0, 0, 0, 1, 1, 0, rows);
+        break;
+    case Route::ColumnSnake:
+        for (std::int64_t c = 0; c < cols; ++c) {
+            line(c % 2 ? rows - 1 : 0, c, c % 2 ? -1 : 1, 0, rows);
+        }
+        break;
+    case Route::Diagonal: {
+        // Диагонали полной длины min(rows, cols) идут подряд со сдвигом на
+        // строку (высокая таблица) или на столбец (широкая)
+        std::int64_t shortSide = std::min(rows, cols);
+        std::int64_t middle = shortSide - 1, last = std::max(rows, cols) - 1;
+        for (std::int64_t d = 0; d < middle; ++d) {
+            line(0, d, 1, -1, d + 1);
+        }
+        std::int64_t top = std::max<std::int64_t>(0, middle - (cols - 1));
+        lines(last - middle + 1, top, middle - top, rows >= cols ? 1 : 0, rows >= cols ? 0 : 1, 1, -1, shortSide);
+        for (std::int64_t d = last + 1; d < rows + cols - 1; ++d) {
+            top = std::max<std::int64_t>(0, d - (cols - 1));
+            line(top, d - top, 1, -1, std::min(d, rows - 1) - top + 1);
+        }
+        break;
+    }
+    case Route::Spiral:
+    case Route::CounterSpiral: {
+        // Витки как в route_static::walk; обратный виток — его зеркальное отражение
+        bool mirror = spec.read == Route::CounterSpiral;
+        auto column = [&](std::int64_t c) { return mirror ? cols - 1 - c : c; };
+        std::int64_t dc = mirror ? 1 : -1;
+        std::int64_t bottom = rows - 1, left = 0, right = cols - 1;
+        while (bottom >= 0 && left <= right) {
+            line(0, column(right), 1, 0, bottom + 1);
+            right--;
+            line(bottom, column(right), 0, dc, right - left + 1);
+            bottom--;
+            if (left <= right) {
+                line(bottom, column(left), -1, 0, bottom + 1);
+                left++;
+            }
+        }
+        break;
+    }
+    }
+}
+
+void RoutePlan::append(std::int64_t start, std::int64_t stride, std::int64_t count, std::int64_t step, std::int64_t repeat) {
+    // Блок из строк в одну ячейку или из строк, идущих подряд, — это отрезок
+    if (repeat > 1 && count == 1) {
+        stride = step;
+        count = repeat;
+        repeat = 1;
+    } else if (repeat > 1 && step == count * stride) {
+        count *= repeat;
+        repeat = 1;
+    }
+    if (count == 1) {
+        stride = 0;
+    }
+    if (repeat == 1) {
+        step = 0;
+    }
+    if (!segments.empty()) {
+        Segment& last = segments.back();
+        // Продолжение отрезка
+        if (repeat == 1 && last.repeat == 1 && (last.count == 1 || last.start + last.count * last.stride == start) &&
+            (count == 1 || stride == (last.count == 1 ? start - last.start : last.stride))) {
+            last.stride = last.count == 1 ? start - last.start : last.stride;
+            last.count += count;
+            total += count;
+            return;
+        }
+        // Продолжение блока строками той же формы
+        std::int64_t lastStep = last.repeat == 1 ? start - last.start : last.step;
+        if (last.count == count && last.stride == stride && start == last.start + last.repeat * lastStep &&
+            (repeat == 1 || step == lastStep)) {
+            last.step = lastStep;
+            last.repeat += repeat;
+            total += count * repeat;
+            return;
+        }
+    }
+    Segment segment = {total, start, stride, count, step, repeat};
+    segments.push_back(segment);
+    total += count * repeat;
+}
+
+std::size_t RoutePlan::first(std::int64_t position) const {
+    std::size_t low = 0, high = segments.size();
+    while (high - low > 1) {
+        std::size_t middle = (low + high) / 2;
+        if (segments[middle].position <= position) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+template <class Table, class Stream>
+void RoutePlan::move(Table* table, std::int64_t from, std::int64_t to, Stream* stream) const {
+    from = std::max<std::int64_t>(from, 0);
+    to = std::min(to, total);
+    for (std::size_t s = first(from); from < to; ++s) {
+        const Segment& segment = segments[s];
+        std::int64_t j = from - segment.position;
+        std::int64_t end = std::min(segment.count * segment.repeat, to - segment.position);
+        std::int64_t row = j / segment.count, i = j % segment.count;
+        while (j < end) {
+            Table* cell = table + segment.start + row * segment.step + i * segment.stride;
+            if (i == 0 && segment.count <= unrolledCount && end - j >= 2 * segment.count) {
+                // Целые строки узкой таблицы
+                std::int64_t rows = (end - j) / segment.count;
+                Block<Table, Stream> kernel = {cell, segment.stride, segment.step, rows, stream};
+                byCount(kernel, segment.count);
+                j += rows * segment.count;
+                stream += rows * segment.count;
+                row += rows;
+            } else {
+                // Строка или её часть
+                std::int64_t k = std::min(segment.count - i, end - j);
+                Line<Table, Stream> kernel = {cell, segment.stride, k, stream};
+                byStride(kernel, segment.stride);
+                j += k;
+                stream += k;
+                i = 0;
+                ++row;
+            }
+        }
+        from = segment.position + end;
+    }
+}
+
+void RoutePlan::gather(const wchar_t* letters, std::int64_t from, std::int64_t to, wchar_t* out) const {
+    move(letters, from, to, out);
+}
+
+void RoutePlan::scatter(const wchar_t* cipherText, std::int64_t from, std::int64_t to, wchar_t* out) const {
+    move(out, from, to, cipherText);
+}
@@ -0,0 +1,227 @@
+/**
+ * @file route_plan.h
+ * @brief Маршруты записи и считывания таблицы и их компиляция в план перестановки
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Маршрут описывается парой RouteSpec (маршрут записи, маршрут считывания).
+ * Для заданных ширины таблицы и длины текста пара компилируется в RoutePlan —
+ * список блоков арифметических прогрессий номеров букв открытого текста.
+ * Строки блока копируются ядрами, специализированными шаблоном для длины
+ * строки от 1 до 8 (узкие таблицы) и для шагов ±1..±8; прочие длины и шаги
+ * обрабатывает общее ядро сбора по индексу. Заголовок не определяет
+ * cipher_error: ошибки описания маршрута сообщаются исключением
+ * std::invalid_argument. Номера букв, длины и шаги плана — 64-битные.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Порядок обхода ячеек таблицы
+ */
+enum class Route {
+    Rows,          ///< По строкам слева направо, сверху вниз
+    ReversedRows,  ///< По строкам справа налево, сверху вниз
+    RowSnake,      ///< Змейкой по строкам: чётные слева направо, нечётные справа налево
+    Columns,       ///< По столбцам сверху вниз, слева направо
+    ColumnSnake,   ///< Змейкой по столбцам: чётные сверху вниз, нечётные снизу вверх
+    Diagonal,      ///< По диагоналям (справа сверху налево вниз), начиная с левого верхнего угла
+    Spiral,        ///< Витками по часовой стрелке: правый столбец вниз, нижняя строка влево, левый столбец вверх
+    CounterSpiral  ///< Зеркальный Spiral: левый столбец вниз, нижняя строка вправо, правый столбец вверх
+};
+
+/**
+ * @brief Маршруты записи и считывания
+ * @details По умолчанию — маршрут класса RouteCipher: запись по строкам,
+ *          считывание витками по часовой стрелке.
+ */
+struct RouteSpec {
+    Route write = Route::Rows;  ///< Маршрут записи (Rows, ReversedRows, RowSnake, Columns или ColumnSnake)
+    Route read = Route::Spiral; ///< Маршрут считывания (любой)
+
+    bool operator==(const RouteSpec& other) const { return write == other.write && read == other.read; }
+    bool operator!=(const RouteSpec& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Имя маршрута: rows, reversed-rows, row-snake, columns, column-snake,
+ *        diagonal, spiral или counter-spiral
+ */
+const char* routeName(Route route);
+
+/**
+ * @brief Маршрут по имени
+ * @throw std::invalid_argument Если имя неизвестно
+ */
+Route parseRoute(const std::string& name);
+
+/**
+ * @brief Пара маршрутов по описанию «ЗАПИСЬ:СЧИТЫВАНИЕ» или «СЧИТЫВАНИЕ»
+ *        (запись по строкам)
+ * @throw std::invalid_argument Если имя неизвестно или маршрут записи не поддерживается
+ */
+RouteSpec parseRouteSpec(const std::string& spec);
+
+/**
+ * @brief Можно ли записывать таблицу маршрутом route
+ * @details Номер ячейки при записи должен выражаться через строку и столбец
+ *          без обхода таблицы, поэтому диагональ и витки доступны только для считывания.
+ */
+bool writableRoute(Route route);
+
+/**
+ * @brief Перестановка букв текста заданной длины, скомпилированная из RouteSpec
+ * @details Таблица имеет min(columns, textLength) столбцов и столько строк,
+ *          сколько нужно для textLength букв; занятые ячейки — первые
+ *          textLength ячеек маршрута записи. k-я буква шифртекста — буква
+ *          открытого текста номер at(k), где at — k-я по порядку ячейка
+ *          маршрута считывания среди занятых.
+ *
+ *          Маршрут разбивается на прямые линии (строки, столбцы, диагонали).
+ *          Занятые ячейки линии дают отрезок арифметической прогрессии
+ *          номеров, а одинаковые отрезки подряд (строки узкой таблицы)
+ *          сливаются в блок, поэтому план содержит O(строк + столбцов)
+ *          записей, для узких таблиц — O(1) блоков. Змейка записи поперёк
+ *          линии даёт блоки по две ячейки, диагональ поверх змейки — по
+ *          отрезку на ячейку. План неизменяем и может использоваться
+ *          несколькими потоками.
+ */
+class RoutePlan {
+public:
+    /**
+     * @param[in] spec Маршруты записи и считывания
+     * @param[in] columns Количество столбцов (положительное)
+     * @param[in] textLength Количество букв текста
+     * @throw std::invalid_argument При неположительном числе столбцов или
+     *        маршруте записи, для которого !writableRoute()
+     */
+    RoutePlan(const RouteSpec& spec, std::int64_t columns, std::int64_t textLength);
+
+    /// Количество букв текста
+    std::int64_t length() const { return total; }
+
+    /**
+     * @brief Собирает буквы шифртекста с номерами from..to-1: out[k - from] = letters[at(k)]
+     */
+    void gather(const wchar_t* letters, std::int64_t from, std::int64_t to, wchar_t* out) const;
+
+    /**
+     * @brief Раскладывает буквы шифртекста с номерами from..to-1: out[at(k)] = cipherText[k - from]
+     */
+    void scatter(const wchar_t* cipherText, std::int64_t from, std::int64_t to, wchar_t* out) const;
+
+    /**
+     * @brief Вызывает visit(at(k)) для k от from до to-1
+     */
+    template <class Visit>
+    void visit(std::int64_t from, std::int64_t to, Visit&& visit) const {
+        from = std::max<std::int64_t>(from, 0);
+        to = std::min(to, total);
+        for (std::size_t s = first(from); from < to; ++s) {
+            const Segment& segment = segments[s];
+            std::int64_t j = from - segment.position;
+            std::int64_t end = std::min(segment.count * segment.repeat, to - segment.position);
+            std::int64_t row = j / segment.count, i = j % segment.count;
+            while (j < end) {
+                std::int64_t cell = segment.start + row * segment.step + i * segment.stride;
+                for (; i < segment.count && j < end; ++i, ++j, cell += segment.stride) {
+                    visit(cell);
+                }
+                i = 0;
+                ++row;
+            }
+            from = segment.position + end;
+        }
+    }
+
+    /**
+     * @brief Вызывает visit(i, k) для ячеек i от from до to-1, где at(k) = i
+     * @details Порядок вызовов не определён. Пересечение строки блока с
+     *          диапазоном и строки блока, пересекающие диапазон, находятся
+     *          арифметически, поэтому время — O(записей плана + строк блоков,
+     *          задевающих диапазон + to - from) без обхода остальных букв.
+     */
+    template <class Visit>
+    void cells(std::int64_t from, std::int64_t to, Visit&& visit) const {
+        from = std::max<std::int64_t>(from, 0);
+        to = std::min(to, total);
+        if (from >= to) {
+            return;
+        }
+        for (const Segment& segment : segments) {
+            std::int64_t span = (segment.count - 1) * segment.stride;
+            std::int64_t low = std::min<std::int64_t>(0, span), high = std::max<std::int64_t>(0, span);
+            // Строки o, у которых [start + o * step + low, start + o * step + high] задевает [from, to)
+            std::int64_t o0 = 0, o1 = segment.repeat - 1;
+            if (segment.step > 0) {
+                o0 = std::max(o0, ceilDiv(from - high - segment.start, segment.step));
+                o1 = std::min(o1, floorDiv(to - 1 - low - segment.start, segment.step));
+            } else if (segment.step < 0) {
+                o0 = std::max(o0, ceilDiv(segment.start + low - (to - 1), -segment.step));
+                o1 = std::min(o1, floorDiv(segment.start + high - from, -segment.step));
+            }
+            for (std::int64_t o = o0; o <= o1; ++o) {
+                std::int64_t base = segment.start + o * segment.step;
+                std::int64_t j0 = 0, j1 = segment.count - 1;
+                if (segment.stride > 0) {
+                    j0 = std::max(j0, ceilDiv(from - base, segment.stride));
+                    j1 = std::min(j1, floorDiv(to - 1 - base, segment.stride));
+                } else if (segment.stride < 0) {
+                    j0 = std::max(j0, ceilDiv(base - (to - 1), -segment.stride));
+                    j1 = std::min(j1, floorDiv(base - from, -segment.stride));
+                } else if (base < from || base >= to) {
+                    continue;
+                }
+                std::int64_t k = segment.position + o * segment.count + j0;
+                for (std::int64_t j = j0, cell = base + j0 * segment.stride; j <= j1; ++j, cell += segment.stride) {
+                    visit(cell, k++);
+                }
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief Блок из repeat строк по count ячеек
+     * @details Буквы at(position)..at(position + count * repeat - 1) — это
+     *          start + o * step + j * stride для o < repeat, j < count.
+     */
+    struct Segment {
+        std::int64_t position;
+        std::int64_t start;
+        std::int64_t stride;
+        std::int64_t count;
+        std::int64_t step;
+        std::int64_t repeat;
+    };
+
+    std::vector<Segment> segments;
+    std::int64_t total;
+
+    /// Добавляет блок, продолжая последний отрезок или блок, если возможно
+    void append(std::int64_t start, std::int64_t stride, std::int64_t count, std::int64_t step = 0, std::int64_t repeat = 1);
+    /// Номер записи, содержащей букву шифртекста номер position
+    std::size_t first(std::int64_t position) const;
+    /// Деление с округлением вниз и вверх при положительном делителе
+    static std::int64_t floorDiv(std::int64_t a, std::int64_t b) {
+        return a >= 0 ? a / b : -((-a + b - 1) / b);
+    }
+    static std::int64_t ceilDiv(std::int64_t a, std::int64_t b) {
+        return a >= 0 ? (a + b - 1) / b : -(-a / b);
+    }
+    /**
+     * @brief Общая часть gather() и scatter()
+     * @details Направление задаёт константность: gather() читает таблицу
+     *          (const wchar_t* table), scatter() — поток (const wchar_t* stream).
+     */
+    template <class Table, class Stream>
+    void move(Table* table, std::int64_t from, std::int64_t to, Stream* stream) const;
+};
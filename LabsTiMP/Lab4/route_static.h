@@ -0,0 +1,328 @@
+/**
+ * @file route_static.h
+ * @brief Ядро шифра табличной маршрутной перестановки, пригодное для вычислений во время компиляции
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Обход маршрута и преобразование букв используются и классом RouteCipher,
+ * и функциями route_static::encrypt/decrypt. Начиная с C++14 они constexpr,
+ * а с C++17 строковую константу можно зашифровать при компиляции:
+ * @code
+ * constexpr auto secret = route_static::encrypt(7, L"СЕКРЕТНАЯ СТРОКА");
+ * std::wstring open = route_static::decrypt(7, secret).str();
+ * @endcode
+ * Заголовок не определяет cipher_error: ошибки во время выполнения
+ * сообщаются исключением std::invalid_argument с тем же текстом, что и у
+ * RouteCipher, а при вычислении во время компиляции дают ошибку компиляции.
+ * Номера букв, длины и число столбцов — 64-битные, поэтому обход не
+ * переполняется на текстах длиннее 2^31 букв.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#if __cplusplus >= 201402L
+#define ROUTE_CONSTEXPR constexpr
+#else
+#define ROUTE_CONSTEXPR inline
+#endif
+
+namespace route_static {
+
+/**
+ * @brief Преобразует русскую строчную букву в прописную
+ * @param[in] c Символ для преобразования
+ * @return Прописной символ или исходный символ, если он не является русской строчной буквой
+ */
+ROUTE_CONSTEXPR wchar_t toUpper(wchar_t c) {
+    if (c >= L'а' && c <= L'я') {
+        return c - (L'а' - L'А');
+    }
+    if (c == L'ё') {
+        return L'Ё';
+    }
+    return c;
+}
+
+/**
+ * @brief Проверяет, является ли символ русской буквой (прописной или строчной, включая Ё/ё)
+ */
+ROUTE_CONSTEXPR bool isLetter(wchar_t c) {
+    return (c >= L'А' && c <= L'я') || c == L'Ё' || c == L'ё';
+}
+
+/**
+ * @brief Обходит часть маршрута считывания: буквы шифртекста с номерами from..to-1
+ * @details Маршрут состоит из витков (правый столбец, нижняя строка, левый
+ *          столбец), занятые ячейки каждого отрезка витка идут подряд,
+ *          поэтому длина отрезка вычисляется за O(1), а начало диапазона
+ *          находится пропуском целых отрезков. Независимые диапазоны можно
+ *          обходить параллельно.
+ * @param[in] columns Количество столбцов (положительное)
+ * @param[in] textLength Количество букв текста
+ * @param[in] from Номер первой буквы шифртекста
+ * @param[in] to Номер буквы шифртекста за последней
+ * @param[in] visit Функция, принимающая номер буквы открытого текста
+ */
+template <class Visit>
+ROUTE_CONSTEXPR void walk(std::int64_t columns, std::int64_t textLength, std::int64_t from, std::int64_t to,
+                          Visit&& visit) {
+    from = std::max<std::int64_t>(from, 0);
+    to = std::min(to, textLength);
+    if (textLength <= 0 || from >= to) {
+        return;
+    }
+    columns = std::min(columns, textLength);
+    std::int64_t rows = (textLength + columns - 1) / columns;
+    std::int64_t last = textLength - 1;
+    std::int64_t bottom = rows - 1;
+    std::int64_t left = 0, right = columns - 1;
+    std::int64_t position = 0;
+
+    while (bottom >= 0 && left <= right && position < to) {
+        // Правый столбец сверху вниз: заняты строки 0..count-1
+        std::int64_t count = right <= last ? std::min(bottom, (last - right) / columns) + 1 : 0;
+        for (std::int64_t m = std::max<std::int64_t>(from - position, 0); m < count && position + m < to; ++m) {
+            visit(m * columns + right);
+        }
+        position += count;
+        right--;
+
+        // Нижняя строка справа налево: заняты столбцы first..left
+        std::int64_t first = std::min(right, last - bottom * columns);
+        count = first >= left ? first - left + 1 : 0;
+        for (std::int64_t m = std::max<std::int64_t>(from - position, 0); m < count && position + m < to; ++m) {
+            visit(bottom * columns + first - m);
+        }
+        position += count;
+        bottom--;
+
+        // Левый столбец снизу вверх: заняты строки first..0
+        if (left <= right) {
+            first = left <= last ? std::min(bottom, (last - left) / columns) : -1;
+            count = first + 1;
+            for (std::int64_t m = std::max<std::int64_t>(from - position, 0); m < count && position + m < to; ++m) {
+                visit((first - m) * columns + left);
+            }
+            position += count;
+            left++;
+        }
+    }
+}
+
+/**
+ * @brief Номер буквы шифртекста в ячейке (r, c) таблицы из rows строк
+ * @details Ячейка принадлежит витку t = min(c, columns - 1 - c, rows - 1 - r):
+ *          витки с меньшими номерами занимают столбцы левее t и правее
+ *          columns - 1 - t и строки ниже rows - 1 - t. Перед витком t в
+ *          шифртексте стоят все занятые ячейки вне его прямоугольника.
+ *          Занятость задаётся последним занятым столбцом нижней строки
+ *          lastColumn: столбцы до него имеют rows занятых ячеек, остальные
+ *          rows - 1, поэтому номер вычисляется без деления.
+ */
+ROUTE_CONSTEXPR std::int64_t cipherIndexAt(std::int64_t columns, std::int64_t rows, std::int64_t lastColumn,
+                                           std::int64_t r, std::int64_t c) {
+    std::int64_t t = std::min(std::min(c, columns - 1 - c), rows - 1 - r);
+    std::int64_t bottom = rows - 1 - t, left = t, right = columns - 1 - t;
+
+    // Занятые ячейки прямоугольника строк 0..bottom и столбцов left..right
+    std::int64_t inner = (std::min(bottom, rows - 2) + 1) * (right - left + 1);
+    if (bottom == rows - 1) {
+        inner += std::max<std::int64_t>(0, std::min(right, lastColumn) - left + 1);
+    }
+    std::int64_t position = (rows - 1) * columns + lastColumn + 1 - inner;
+
+    // Правый столбец сверху вниз
+    if (c == right) {
+        return position + r;
+    }
+    position += std::min(bottom + 1, right <= lastColumn ? rows : rows - 1);
+    // Нижняя строка справа налево от first
+    std::int64_t first = bottom == rows - 1 ? std::min(right - 1, lastColumn) : right - 1;
+    if (r == bottom) {
+        return position + first - c;
+    }
+    position += first >= left ? first - left + 1 : 0;
+    // Левый столбец снизу вверх от строки top
+    std::int64_t top = std::min(bottom - 1, left <= lastColumn ? rows - 1 : rows - 2);
+    return position + top - r;
+}
+
+/**
+ * @brief Номер буквы шифртекста, стоящей в ячейке cell (обращение walk)
+ * @param[in] columns Количество столбцов (положительное)
+ * @param[in] textLength Количество букв текста
+ * @param[in] cell Номер буквы открытого текста, 0 <= cell < textLength
+ */
+ROUTE_CONSTEXPR std::int64_t cipherIndex(std::int64_t columns, std::int64_t textLength, std::int64_t cell) {
+    columns = std::min(columns, textLength);
+    std::int64_t rows = (textLength + columns - 1) / columns;
+    return cipherIndexAt(columns, rows, textLength - 1 - (rows - 1) * columns, cell / columns, cell % columns);
+}
+
+/**
+ * @brief Обходит ячейки from..to-1 по порядку и сообщает номер буквы шифртекста в каждой
+ * @details Вызывает visit(i, cipherIndex(i)) за O(1) на ячейку. Занятые
+ *          ячейки нижней строки витка стоят в шифртексте подряд в обратном
+ *          порядке, поэтому внутри такого отрезка номер только уменьшается.
+ * @param[in] columns Количество столбцов (положительное)
+ * @param[in] textLength Количество букв текста
+ * @param[in] from Номер первой ячейки (буквы открытого текста)
+ * @param[in] to Номер ячейки за последней
+ * @param[in] visit Функция, принимающая номер ячейки и номер буквы шифртекста
+ */
+template <class Visit>
+ROUTE_CONSTEXPR void cells(std::int64_t columns, std::int64_t textLength, std::int64_t from, std::int64_t to,
+                           Visit&& visit) {
+    from = std::max<std::int64_t>(from, 0);
+    to = std::min(to, textLength);
+    if (textLength <= 0 || from >= to) {
+        return;
+    }
+    columns = std::min(columns, textLength);
+    std::int64_t rows = (textLength + columns - 1) / columns;
+    std::int64_t lastColumn = textLength - 1 - (rows - 1) * columns;
+    std::int64_t r = from / columns, c = from % columns;
+    for (std::int64_t i = from; i < to;) {
+        std::int64_t k = cipherIndexAt(columns, rows, lastColumn, r, c);
+        visit(i++, k);
+        std::int64_t t = rows - 1 - r;
+        if (t <= c && c < columns - 1 - t) {
+            // Столбцы c + 1..columns - 2 - t — та же нижняя строка витка t
+            std::int64_t end = std::min(to - i, columns - 2 - t - c);
+            for (std::int64_t m = 0; m < end; ++m) {
+                visit(i++, --k);
+            }
+            c += end;
+        }
+        if (++c == columns) {
+            c = 0;
+            ++r;
+        }
+    }
+}
+
+#if __cplusplus >= 201703L
+
+/**
+ * @brief Результат шифрования постоянной длины
+ * @tparam N Размер массива вместе с завершающим нулём
+ */
+template <std::size_t N>
+struct Text {
+    wchar_t data[N] = {}; ///< Символы результата, за ними нули
+    std::size_t size = 0; ///< Длина результата
+
+    constexpr const wchar_t* c_str() const { return data; }
+    std::wstring str() const { return std::wstring(data, size); }
+    /// Совпадает ли результат со строковой константой
+    template <std::size_t M>
+    constexpr bool equals(const wchar_t (&other)[M]) const {
+        if (size != M - 1) {
+            return false;
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            if (data[i] != other[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Зашифрование в память вызывающего (семантика RouteCipher::encrypt)
+ * @param[in] columns Количество столбцов
+ * @param[in] text Текст из русских букв и пробелов
+ * @param[in] length Длина текста
+ * @param[out] letters Буфер не меньше length символов для букв текста
+ * @param[out] out Буфер не меньше length символов для шифртекста
+ * @return Длина шифртекста
+ * @throw std::invalid_argument При недопустимом ключе или тексте
+ */
+constexpr std::size_t encryptInto(std::int64_t columns, const wchar_t* text, std::size_t length, wchar_t* letters,
+                                  wchar_t* out) {
+    if (columns <= 0) {
+        throw std::invalid_argument("Columns must be positive");
+    }
+    if (length == 0) {
+        return 0;
+    }
+    std::size_t count = 0;
+    for (std::size_t k = 0; k < length; ++k) {
+        if (text[k] != L' ') {
+            if (!isLetter(text[k])) {
+                throw std::invalid_argument("Text must contain only Russian letters and spaces");
+            }
+            letters[count++] = toUpper(text[k]);
+        }
+    }
+    if (count == 0) {
+        throw std::invalid_argument("Text must contain at least one letter");
+    }
+    std::size_t index = 0;
+    walk(columns, static_cast<std::int64_t>(count), 0, static_cast<std::int64_t>(count), [&](std::int64_t i) {
+        out[index++] = letters[i];
+    });
+    return count;
+}
+
+/**
+ * @brief Расшифрование в память вызывающего (семантика RouteCipher::decrypt)
+ * @param[in] columns Количество столбцов
+ * @param[in] cipherText Шифртекст из русских букв
+ * @param[in] length Длина шифртекста
+ * @param[out] out Буфер не меньше length символов
+ * @return Длина результата (равна length)
+ * @throw std::invalid_argument При недопустимом ключе или шифртексте
+ */
+constexpr std::size_t decryptInto(std::int64_t columns, const wchar_t* cipherText, std::size_t length, wchar_t* out) {
+    if (columns <= 0) {
+        throw std::invalid_argument("Columns must be positive");
+    }
+    for (std::size_t k = 0; k < length; ++k) {
+        if (!isLetter(cipherText[k])) {
+            throw std::invalid_argument("Cipher text must contain only Russian letters");
+        }
+    }
+    std::size_t index = 0;
+    walk(columns, static_cast<std::int64_t>(length), 0, static_cast<std::int64_t>(length), [&](std::int64_t i) {
+        out[i] = cipherText[index++];
+    });
+    return length;
+}
+
+/**
+ * @brief Шифртекст строковой константы
+ * @param[in] columns Количество столбцов
+ * @param[in] text Строковая константа из русских букв и пробелов
+ */
+template <std::size_t N>
+constexpr Text<N> encrypt(std::int64_t columns, const wchar_t (&text)[N]) {
+    Text<N> result;
+    wchar_t letters[N] = {};
+    result.size = encryptInto(columns, text, N - 1, letters, result.data);
+    return result;
+}
+
+/**
+ * @brief Открытый текст по шифртексту, полученному encrypt()
+ * @param[in] columns Количество столбцов
+ * @param[in] cipherText Результат encrypt()
+ */
+template <std::size_t N>
+constexpr Text<N> decrypt(std::int64_t columns, const Text<N>& cipherText) {
+    Text<N> result;
+    result.size = decryptInto(columns, cipherText.data, cipherText.size, result.data);
+    return result;
+}
+
+#endif
+
+} // namespace route_static
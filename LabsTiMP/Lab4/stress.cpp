@@ -0,0 +1,377 @@
+/**
+ * @file stress.cpp
+ * @brief Нагрузочные тесты шифра табличной маршрутной перестановки
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Тесты прогоняют шифрование и расшифрование на геометрически растущих
+ * размерах текста и количествах столбцов и проверяют, что время и пиковая
+ * память растут линейно с размером текста, а короткие сообщения шифруются
+ * без обращений к куче. Маршруты RouteSpec проверяются на совпадение с
+ * эталонной таблицей reference::routeOrder, обратимость, известных примерах
+ * и линейность времени, decryptRange — на совпадение с decrypt и
+ * независимость времени окна от длины шифртекста, виды encryptView и
+ * decryptView — на совпадение с encrypt и decrypt. Номера ячеек проверяются
+ * на текстах длиннее 2^31 букв без построения таблицы.
+ * KeywordCipher проверяется на известных примерах, совпадение с маршрутом
+ * «rows:columns», обратимость и линейность времени и памяти.
+ */
+
+#include <UnitTest++/UnitTest++.h>
+#include <string>
+#include <vector>
+#include "route_cipher.h"
+#include "keyword_cipher.h"
+#include "../Corpus/corpus.h"
+#include "../Corpus/measure.h"
+#include "../Fuzz/reference.h"
+
+/// Допустимый разброс удельного времени между наименьшим и наибольшим размером
+const double timeTolerance = 4.0;
+/// Допустимый разброс удельной памяти между наименьшим и наибольшим размером
+const double memoryTolerance = 2.0;
+
+/**
+ * @brief Генерирует текст из русских букв и пробелов
+ * @param[in] size Количество символов
+ * @param[in] seed Зерно генератора
+ */
+std::wstring makeText(std::size_t size, uint64_t seed) {
+    CorpusOptions opts;
+    opts.seed = seed;
+    opts.lowercaseRate = 0.3;
+    return CorpusGenerator(opts).generate(size);
+}
+
+/**
+ * @brief Ожидаемый результат расшифрования: текст без пробелов в верхнем регистре
+ * @param[in] text Исходный текст
+ */
+std::wstring normalize(const std::wstring& text) {
+    std::wstring result;
+    for (wchar_t c : text) {
+        if (c == L' ') {
+            continue;
+        }
+        if (c >= L'а' && c <= L'я') {
+            c -= L'а' - L'А';
+        } else if (c == L'ё') {
+            c = L'Ё';
+        }
+        result += c;
+    }
+    return result;
+}
+
+/**
+ * @brief Ожидаемый шифртекст по эталонной таблице reference::routeOrder
+ * @param[in] open Нормализованный открытый текст
+ * @param[in] write Имя маршрута записи
+ * @param[in] read Имя маршрута считывания
+ */
+std::wstring expected(const std::wstring& open, const std::string& write, const std::string& read, int columns) {
+    std::vector<std::int64_t> order = reference::routeOrder(write, read, columns, static_cast<std::int64_t>(open.size()));
+    std::wstring result;
+    for (std::int64_t k : order) {
+        result += open[k];
+    }
+    return result;
+}
+
+/// Размеры входа: от 16K до 4M символов с шагом 4
+std::vector<std::size_t> sizes() {
+    std::vector<std::size_t> v;
+    for (std::size_t n = 1 << 14; n <= 1 << 22; n *= 4) {
+        v.push_back(n);
+    }
+    return v;
+}
+
+SUITE(RouteCipherStress) {
+    TEST(RoundTripAcrossSizesAndColumns) {
+        for (std::size_t n = 1; n <= 1 << 20; n *= 8) {
+            std::wstring text = makeText(n + 1, n);
+            std::wstring open = normalize(text);
+            if (open.empty()) {
+                continue;
+            }
+            for (int columns = 1; columns <= 1 << 24; columns *= 16) {
+                RouteCipher cipher(columns);
+                std::wstring encrypted = cipher.encrypt(text);
+                CHECK_EQUAL(open.size(), encrypted.size());
+                CHECK(open == cipher.decrypt(encrypted));
+            }
+        }
+    }
+
+    TEST(EncryptTimeAndMemoryAreLinear) {
+        const int columns[] = { 1, 7, 100, 5000 };
+        for (int c : columns) {
+            RouteCipher cipher(c);
+            std::vector<double> time, memory;
+            for (std::size_t n : sizes()) {
+                std::wstring text = makeText(n, c);
+                Measurement m = measure([&] { cipher.encrypt(text); });
+                time.push_back(m.seconds / n);
+                memory.push_back(double(m.peakBytes) / n);
+            }
+            CHECK(spread(time) < timeTolerance);
+            CHECK(spread(memory) < memoryTolerance);
+        }
+    }
+
+    TEST(DecryptTimeAndMemoryAreLinear) {
+        const int columns[] = { 1, 7, 100, 5000 };
+        for (int c : columns) {
+            RouteCipher cipher(c);
+            std::vector<double> time, memory;
+            for (std::size_t n : sizes()) {
+                std::wstring encrypted = cipher.encrypt(makeText(n, c));
+                Measurement m = measure([&] { cipher.decrypt(encrypted); });
+                time.push_back(m.seconds / encrypted.size());
+                memory.push_back(double(m.peakBytes) / encrypted.size());
+            }
+            CHECK(spread(time) < timeTolerance);
+            CHECK(spread(memory) < memoryTolerance);
+        }
+    }
+
+    // Все пары маршрутов: шифртекст совпадает с эталонной таблицей, расшифрование обращает зашифрование
+    TEST(CustomRoutesRoundTrip) {
+        const Route routes[] = { Route::Rows, Route::ReversedRows, Route::RowSnake, Route::Columns,
+                                 Route::ColumnSnake, Route::Diagonal, Route::Spiral, Route::CounterSpiral };
+        std::wstring text = makeText(5000, 11);
+        std::wstring open = normalize(text);
+        for (int columns : { 1, 3, 8, 9, 70, 10000 }) {
+            CHECK(RouteCipher(columns).encrypt(text) == expected(open, "rows", "spiral", columns));
+            for (int write = 0; write < 5; ++write) {
+                for (Route read : routes) {
+                    RouteSpec spec;
+                    spec.write = routes[write];
+                    spec.read = read;
+                    RouteCipher cipher(columns, spec);
+                    std::wstring encrypted = cipher.encrypt(text);
+                    CHECK(encrypted == expected(open, routeName(spec.write), routeName(read), columns));
+                    CHECK(open == cipher.decrypt(encrypted));
+                }
+            }
+        }
+    }
+
+    TEST(CustomRoutesKnownVectors) {
+        // ПРИ / ВЕТ / МИР
+        CHECK(RouteCipher(3, parseRouteSpec("columns")).encrypt(L"ПРИВЕТ МИР") == L"ПВМРЕИИТР");
+        CHECK(RouteCipher(3, parseRouteSpec("reversed-rows")).encrypt(L"ПРИВЕТ МИР") == L"ИРПТЕВРИМ");
+        CHECK(RouteCipher(3, parseRouteSpec("diagonal")).encrypt(L"ПРИВЕТ МИР") == L"ПРВИЕМТИР");
+        // Запись по столбцам: ПВМ / РЕИ / ИТР
+        CHECK(RouteCipher(3, parseRouteSpec("columns:rows")).encrypt(L"ПРИВЕТ МИР") == L"ПВМРЕИИТР");
+        CHECK_THROW(RouteCipher(3, parseRouteSpec("diagonal:rows")), std::invalid_argument);
+        CHECK_THROW(parseRouteSpec("zigzag"), std::invalid_argument);
+    }
+
+    // Скомпилированный план не медленнее обхода маршрута по умолчанию
+    TEST(CustomRoutesAreLinear) {
+        const char* specs[] = { "rows:spiral", "row-snake:columns", "column-snake:diagonal", "columns:counter-spiral" };
+        for (const char* s : specs) {
+            for (int c : { 3, 100 }) {
+                RouteCipher cipher(c, parseRouteSpec(s));
+                std::vector<double> time;
+                for (std::size_t n : sizes()) {
+                    std::wstring text = makeText(n, c);
+                    time.push_back(measure([&] { cipher.encrypt(text); }).seconds / n);
+                }
+                CHECK(spread(time) < timeTolerance);
+            }
+        }
+    }
+
+    TEST(DecryptRangeMatchesDecrypt) {
+        for (int c : { 1, 3, 100, 5000 }) {
+            for (const char* s : { "rows:spiral", "columns:diagonal", "row-snake:counter-spiral" }) {
+                RouteCipher cipher(c, parseRouteSpec(s));
+                std::wstring encrypted = cipher.encrypt(makeText(100000, c));
+                std::wstring open = cipher.decrypt(encrypted);
+                for (std::size_t offset = 0; offset < open.size(); offset += 9973) {
+                    std::size_t count = std::min<std::size_t>(4096, open.size() - offset);
+                    CHECK(open.substr(offset, count) == cipher.decryptRange(encrypted, offset, count));
+                }
+            }
+        }
+        CHECK_THROW(RouteCipher(3).decryptRange(L"ПРИВЕТ", 5, 2), cipher_error);
+    }
+
+    TEST(ViewsMatchEncryptDecrypt) {
+        for (int c : { 1, 3, 100, 5000 }) {
+            for (const char* s : { "rows:spiral", "columns:diagonal", "row-snake:counter-spiral" }) {
+                RouteCipher cipher(c, parseRouteSpec(s));
+                std::wstring text = makeText(100000, c);
+                std::wstring encrypted = cipher.encrypt(text);
+                RouteView view = cipher.encryptView(text);
+                CHECK(std::wstring(view.begin(), view.end()) == encrypted);
+                RouteView open = cipher.decryptView(encrypted);
+                std::wstring decrypted = cipher.decrypt(encrypted);
+                CHECK_EQUAL(decrypted.size(), open.size());
+                // Произвольный доступ в обратном порядке
+                for (std::size_t k = open.size(); k > 0; k -= std::min<std::size_t>(k, 997)) {
+                    CHECK(open[k - 1] == decrypted[k - 1]);
+                }
+            }
+        }
+        CHECK_THROW(RouteCipher(3).encryptView(L"ПРИВЕТ1"), cipher_error);
+        CHECK_THROW(RouteCipher(3).decryptView(L"ПРИ ВЕТ"), cipher_error);
+    }
+
+    // Окно в 4096 букв маршрута по умолчанию расшифровывается за время, не зависящее от длины шифртекста
+    TEST(DecryptRangeTimeIsIndependentOfLength) {
+        for (int c : { 3, 100, 5000 }) {
+            RouteCipher cipher(c);
+            std::vector<double> time;
+            wchar_t out[4096];
+            for (std::size_t n : sizes()) {
+                std::wstring encrypted = cipher.encrypt(makeText(n, c));
+                Measurement m = measure([&] {
+                    cipher.decryptRange(encrypted.data(), encrypted.size(), encrypted.size() / 2, 4096, out);
+                });
+                time.push_back(m.seconds);
+                CHECK(m.peakBytes == 0);
+            }
+            CHECK(spread(time) < timeTolerance);
+        }
+    }
+
+    // Количество столбцов много больше длины текста: память не должна зависеть от ключа
+    TEST(WideTableMemoryIsBoundedByText) {
+        std::wstring text = normalize(makeText(1000, 3));
+        const std::size_t limit = 64 * text.size();
+        for (int shift = 10; shift <= 62; shift += 4) {
+            RouteCipher cipher(std::int64_t(1) << shift);
+            std::wstring encrypted;
+            Measurement enc = measure([&] { encrypted = cipher.encrypt(text); }, 1);
+            Measurement dec = measure([&] { cipher.decrypt(encrypted); }, 1);
+            CHECK(enc.peakBytes < limit);
+            CHECK(dec.peakBytes < limit);
+        }
+    }
+
+    // Текст длиннее 2^31 букв: номера ячеек и шифртекста не переполняются, обход не требует памяти
+    TEST(IndicesBeyond32Bits) {
+        const std::int64_t length = 3000000000LL;
+        for (std::int64_t c : { std::int64_t(7), std::int64_t(100000), std::int64_t(1) << 40 }) {
+            for (const char* s : { "rows:spiral", "rows:column-snake", "columns:counter-spiral" }) {
+                RouteCipher cipher(c, parseRouteSpec(s));
+                std::shared_ptr<const RoutePlan> plan = cipher.plan(length);
+                CHECK_EQUAL(length, plan->length());
+                CHECK(plan == cipher.plan(length));
+                for (std::int64_t from : { std::int64_t(0), length / 2 + 12345, length - 64 }) {
+                    int found = 0;
+                    cipher.cellRange(length, from, from + 64, [&](std::int64_t i, std::int64_t k) {
+                        CHECK(i >= from && i < from + 64 && k >= 0 && k < length);
+                        plan->visit(k, k + 1, [&](std::int64_t cell) { CHECK_EQUAL(i, cell); });
+                        ++found;
+                    });
+                    CHECK_EQUAL(64, found);
+                }
+            }
+        }
+    }
+
+    // Короткое сообщение и результат на стеке: ни одного обращения к куче
+    TEST(ShortMessagesDoNotAllocate) {
+        RouteCipher cipher(7);
+        for (std::size_t n : { 1, 16, 64, 128 }) {
+            std::wstring text = makeText(n - 1, n) + L"Я";
+            wchar_t encrypted[128], decrypted[128];
+            std::size_t length = 0;
+            Measurement m = measure([&] {
+                length = cipher.encrypt(text.data(), text.size(), encrypted);
+                cipher.decrypt(encrypted, length, decrypted);
+            });
+            CHECK(m.peakBytes == 0);
+            CHECK(normalize(text) == std::wstring(decrypted, length));
+        }
+    }
+}
+
+/**
+ * @brief Ключевое слово из length букв алфавита подряд, по кругу
+ * @param[in] length Длина слова
+ */
+std::wstring sortedKeyword(std::size_t length) {
+    const std::wstring alphabet = L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ";
+    std::wstring keyword;
+    for (std::size_t i = 0; i < length; ++i) {
+        keyword += alphabet[i * alphabet.size() / length];
+    }
+    return keyword;
+}
+
+SUITE(KeywordCipherStress) {
+    TEST(KnownVectors) {
+        // ПРИ / ВЕТ / МИР, столбцы в порядке А, Б, В
+        CHECK(KeywordCipher(L"ВАБ").encrypt(L"ПРИВЕТ МИР") == L"РЕИИТРПВМ");
+        CHECK(KeywordCipher(L"ваб").decrypt(L"РЕИИТРПВМ") == L"ПРИВЕТМИР");
+        // Одинаковые буквы — слева направо, Ё — после Е
+        CHECK(KeywordCipher(L"ЕЁЕ").encrypt(L"ПРИВЕТ МИР") == L"ПВМИТРРЕИ");
+        // Неполная строка: ПРИВ / ЕТ
+        CHECK(KeywordCipher(L"ГВБА").encrypt(L"ПРИВЕТ") == L"ВИРТПЕ");
+        CHECK(KeywordCipher(L"ГВБА").decrypt(L"ВИРТПЕ") == L"ПРИВЕТ");
+        CHECK_THROW(KeywordCipher(L""), cipher_error);
+        CHECK_THROW(KeywordCipher(L"КЛЮЧ1"), cipher_error);
+        CHECK_THROW(KeywordCipher(L"KEY"), cipher_error);
+        CHECK_THROW(KeywordCipher(L"КЛЮЧ").encrypt(L"ПРИВЕТ, МИР"), cipher_error);
+        CHECK_THROW(KeywordCipher(L"КЛЮЧ").decrypt(L"ПРИ ВЕТ"), cipher_error);
+    }
+
+    // Слово из букв по алфавиту не переставляет столбцы
+    TEST(SortedKeywordMatchesRowsColumns) {
+        std::wstring text = makeText(5000, 5);
+        for (std::size_t n : { 1, 2, 7, 33, 100, 4000, 10000 }) {
+            KeywordCipher keyword(sortedKeyword(n));
+            RouteCipher route(static_cast<std::int64_t>(n), parseRouteSpec("rows:columns"));
+            CHECK(route.encrypt(text) == keyword.encrypt(text));
+        }
+    }
+
+    TEST(RoundTrip) {
+        for (const wchar_t* k : { L"КЛЮЧ", L"Шифрование", L"ЯЮЭЬЫЪЩШЧЦХФУТСРПОНМЛКЙИЗЖЁЕДГВБА" }) {
+            KeywordCipher cipher(k);
+            for (std::size_t n : { 1, 5, 33, 1000, 100003 }) {
+                std::wstring text = makeText(n, n) + L"Я";
+                std::wstring encrypted = cipher.encrypt(text);
+                CHECK(normalize(text) == cipher.decrypt(encrypted));
+            }
+        }
+        std::wstring text = makeText(100000, 9);
+        std::wstring wide = makeText(2000, 3);
+        KeywordCipher cipher(normalize(wide));
+        CHECK(normalize(text) == cipher.decrypt(cipher.encrypt(text)));
+    }
+
+    // Блоки строк: время и память на букву не зависят от длины текста и ширины таблицы
+    TEST(TimeAndMemoryAreLinear) {
+        for (std::size_t c : { 3, 10, 100, 1000 }) {
+            KeywordCipher cipher(normalize(makeText(4 * c, c)).substr(0, c));
+            std::vector<double> encryptTime, decryptTime, memory;
+            for (std::size_t n : sizes()) {
+                std::wstring text = makeText(n, c), encrypted;
+                Measurement m = measure([&] { encrypted = cipher.encrypt(text); });
+                encryptTime.push_back(m.seconds / n);
+                memory.push_back(double(m.peakBytes) / n);
+                decryptTime.push_back(measure([&] { cipher.decrypt(encrypted); }).seconds / n);
+            }
+            CHECK(spread(encryptTime) < timeTolerance);
+            CHECK(spread(decryptTime) < timeTolerance);
+            CHECK(spread(memory) < memoryTolerance);
+        }
+    }
+}
+
+/**
+ * @brief Запуск нагрузочных тестов
+ * @return Количество непрошедших тестов
+ */
+int main() {
+    return UnitTest::RunAllTests();
+}
@@ -0,0 +1,118 @@
+/**
+ * @file cipher.h
+ * @brief Общий интерфейс шифров и цепочка шифров со статической диспетчеризацией
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * modAlphaCipher (и другие basicAlphaCipher), RouteCipher и KeywordCipher наследуют
+ * CipherInterface<своего класса> (CRTP). Интерфейс не содержит виртуальных
+ * функций и данных: вызов через него и через цепочку разрешается при
+ * компиляции и может быть встроен, а размер шифра не меняется.
+ * @code
+ * modAlphaCipher gronsfeld(L"КЛЮЧ");
+ * RouteCipher route(5);
+ * auto chain = gronsfeld.then(route);          // сначала Гронсфельд, затем перестановка
+ * std::wstring c = chain.encrypted(L"ПРИВЕТ"); // route.encrypt(gronsfeld.encrypt(...))
+ * std::wstring p = chain.decrypted(c);         // в обратном порядке
+ * @endcode
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+template <class First, class Second> class CipherChain;
+
+namespace cipher_detail {
+
+/// Промежуточный буфер цепочки: на стеке для коротких сообщений, иначе в куче
+class Buffer {
+public:
+    explicit Buffer(std::size_t length) : heap(length > shortMessage ? length : 0) {}
+    wchar_t* data() {
+        return heap.empty() ? local : heap.data();
+    }
+
+private:
+    static const std::size_t shortMessage = 128;
+    wchar_t local[shortMessage];
+    std::vector<wchar_t> heap;
+};
+
+} // namespace cipher_detail
+
+/**
+ * @brief Общий интерфейс шифров (CRTP)
+ * @details Класс Derived должен определять
+ * @code
+ * std::size_t encrypt(const wchar_t* text, std::size_t length, wchar_t* out) const;
+ * std::size_t decrypt(const wchar_t* text, std::size_t length, wchar_t* out) const;
+ * @endcode
+ *          Оба метода пишут в out не больше length символов, возвращают длину
+ *          результата и сообщают об ошибках исключением cipher_error.
+ *          Результат состоит из прописных букв, поэтому его можно передать
+ *          следующему шифру цепочки.
+ */
+template <class Derived>
+class CipherInterface {
+public:
+    /**
+     * @brief Цепочка: сначала этот шифр, затем next
+     * @details Цепочка хранит копии шифров и сама реализует интерфейс,
+     *          поэтому цепочки можно продолжать: a.then(b).then(c).
+     */
+    template <class Next>
+    CipherChain<Derived, Next> then(const Next& next) const {
+        return CipherChain<Derived, Next>(self(), next);
+    }
+    /// Зашифрование строки через encrypt() в буфер
+    std::wstring encrypted(const std::wstring& text) const {
+        std::wstring out(text.size(), L'\0');
+        out.resize(self().encrypt(text.data(), text.size(), &out[0]));
+        return out;
+    }
+    /// Расшифрование строки через decrypt() в буфер
+    std::wstring decrypted(const std::wstring& text) const {
+        std::wstring out(text.size(), L'\0');
+        out.resize(self().decrypt(text.data(), text.size(), &out[0]));
+        return out;
+    }
+
+protected:
+    CipherInterface() {}
+    ~CipherInterface() {}
+
+    const Derived& self() const {
+        return static_cast<const Derived&>(*this);
+    }
+};
+
+/**
+ * @brief Последовательное применение двух шифров
+ * @details Зашифрование — second(first(текст)), расшифрование — в обратном
+ *          порядке. Промежуточный результат сообщения не длиннее 128 символов
+ *          находится на стеке.
+ */
+template <class First, class Second>
+class CipherChain : public CipherInterface<CipherChain<First, Second> > {
+public:
+    CipherChain(const First& first, const Second& second) : first(first), second(second) {}
+
+    std::size_t encrypt(const wchar_t* text, std::size_t length, wchar_t* out) const {
+        cipher_detail::Buffer buffer(length);
+        std::size_t n = first.encrypt(text, length, buffer.data());
+        return second.encrypt(buffer.data(), n, out);
+    }
+    std::size_t decrypt(const wchar_t* text, std::size_t length, wchar_t* out) const {
+        cipher_detail::Buffer buffer(length);
+        std::size_t n = second.decrypt(text, length, buffer.data());
+        return first.decrypt(buffer.data(), n, out);
+    }
+
+private:
+    First first;
+    Second second;
+};
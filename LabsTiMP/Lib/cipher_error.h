@@ -0,0 +1,37 @@
+/**
+ * @file cipher_error.h
+ * @brief Класс исключения, общий для всех шифров библиотеки
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * modAlphaCipher.h и route_cipher.h подключают этот файл, а не определяют
+ * cipher_error каждый у себя, поэтому оба шифра можно использовать в одной
+ * единице трансляции и перехватывать их ошибки одним обработчиком.
+ */
+
+#pragma once
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Класс исключения для ошибок шифрования
+ * @details Производный класс от std::invalid_argument для обработки ошибок,
+ *          возникающих при создании шифра, зашифровании и расшифровании
+ */
+class cipher_error : public std::invalid_argument {
+public:
+    /**
+     * @brief Конструктор класса cipher_error
+     * @param[in] what_arg Сообщение об ошибке
+     */
+    explicit cipher_error(const std::string& what_arg) :
+        std::invalid_argument(what_arg) {}
+    /**
+     * @brief Конструктор класса cipher_error
+     * @param[in] what_arg Сообщение об ошибке
+     */
+    explicit cipher_error(const char* what_arg) :
+        std::invalid_argument(what_arg) {}
+};
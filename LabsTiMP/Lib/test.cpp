@@ -0,0 +1,89 @@
+/**
+ * @file test.cpp
+ * @brief Тесты библиотеки шифров: все шифры и их цепочки в одной программе
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "modAlphaCipher.h"
+#include "route_cipher.h"
+#include "keyword_cipher.h"
+
+#include <UnitTest++/UnitTest++.h>
+
+#include <codecvt>
+#include <iostream>
+#include <locale>
+#include <string>
+
+using namespace std;
+
+void init_locale()
+{
+    try {
+        locale::global(locale("ru_RU.UTF-8"));
+    } catch(const exception& e) {
+        cerr << "Ошибка установки локали: " << e.what() << endl;
+        locale::global(locale(""));
+    }
+}
+
+// Конвертация wide → UTF-8 string
+string to_utf8(const wstring& wstr)
+{
+    wstring_convert<codecvt_utf8<wchar_t>> conv;
+    return conv.to_bytes(wstr);
+}
+
+SUITE(ChainTest)
+{
+    TEST(GronsfeldThenRoute) {
+        modAlphaCipher gronsfeld(L"КЛЮЧ");
+        RouteCipher route(4);
+        wstring text = L"ШИФРТАБЛИЧНОЙПЕРЕСТАНОВКИ";
+        CHECK_EQUAL(to_utf8(route.encrypt(gronsfeld.encrypt(text))),
+                    to_utf8(gronsfeld.then(route).encrypted(text)));
+        CHECK_EQUAL(to_utf8(gronsfeld.encrypt(route.encrypt(text))),
+                    to_utf8(route.then(gronsfeld).encrypted(text)));
+    }
+    TEST(DecryptInvertsChain) {
+        auto chain = modAlphaCipher(L"КЛЮЧ").then(RouteCipher(3, RouteSpec{ Route::RowSnake, Route::Spiral }));
+        wstring text = L"ПРИВЕТМИР";
+        CHECK_EQUAL(to_utf8(text), to_utf8(chain.decrypted(chain.encrypted(text))));
+    }
+    TEST(NestedChainOfLongMessage) {
+        // Промежуточный буфер длинного сообщения — в куче
+        auto chain = modAlphaCipher(L"КЛЮЧ").then(RouteCipher(7)).then(modAlphaCipher(L"ШИФР"));
+        wstring text;
+        for (int i = 0; i < 1000; i++)
+            text += L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ"[i * 7 % 33];
+        wstring cipher_text = chain.encrypted(text);
+        CHECK_EQUAL(text.size(), cipher_text.size());
+        CHECK_EQUAL(to_utf8(text), to_utf8(chain.decrypted(cipher_text)));
+    }
+    TEST(KeywordTranspositionInChain) {
+        // Двойная перестановка: маршрут, затем столбцы в порядке ключевого слова
+        auto chain = modAlphaCipher(L"КЛЮЧ").then(RouteCipher(5)).then(KeywordCipher(L"ШИФР"));
+        wstring text = L"ШИФРТАБЛИЧНОЙПЕРЕСТАНОВКИ";
+        CHECK_EQUAL(to_utf8(KeywordCipher(L"ШИФР").encrypt(RouteCipher(5).encrypt(modAlphaCipher(L"КЛЮЧ").encrypt(text)))),
+                    to_utf8(chain.encrypted(text)));
+        CHECK_EQUAL(to_utf8(text), to_utf8(chain.decrypted(chain.encrypted(text))));
+        CHECK_THROW(KeywordCipher(L"KEY"), cipher_error);
+    }
+    TEST(ErrorsOfBothCiphersHaveOneType) {
+        auto chain = modAlphaCipher(L"КЛЮЧ").then(RouteCipher(4));
+        CHECK_THROW(chain.encrypted(L""), cipher_error);
+        CHECK_THROW(chain.encrypted(L"ПРИВЕТW"), cipher_error);
+        CHECK_THROW(RouteCipher(0), cipher_error);
+        CHECK_THROW(modAlphaCipher(L"1"), cipher_error);
+        CHECK_THROW(RouteCipher(4).then(modAlphaCipher(L"КЛЮЧ")).decrypted(L"привет"), std::invalid_argument);
+    }
+}
+
+int main()
+{
+    init_locale();
+    return UnitTest::RunAllTests();
+}
@@ -0,0 +1,67 @@
+/**
+ * @file chunked_mode.cpp
+ * @brief Весь вход — одно сообщение шифра Гронсфельда, обрабатываемое фрагментами
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "modes.h"
+#include "pipeline.h"
+#include <iostream>
+
+namespace {
+
+/// Фрагмент конвейера для сообщения, обрабатываемого по частям
+struct TextChunk {
+    std::wstring text;
+    uint64_t offset = 0; ///< Количество букв сообщения перед фрагментом
+    std::string out;     ///< Результат в UTF-8
+    std::string error;
+};
+
+} // namespace
+
+uint64_t processChunked(Engine& engine, Input& in, Output& out, const Options& opts)
+{
+    uint64_t offset = 0;
+    bool newline = false, failed = false;
+    Pipeline<TextChunk> pipeline(opts.threads, pipelineDepth, opts.pin);
+    pipeline.run(
+        [&](TextChunk& chunk) {
+            chunk.text.clear();
+            if (!in.read(chunk.text, opts.chunk))
+                return false;
+            if (in.done())
+                newline = stripNewline(chunk.text);
+            chunk.offset = offset;
+            offset += engine.letters(chunk.text);
+            return true;
+        },
+        [&](TextChunk& chunk) {
+            chunk.out.clear();
+            Result r = guarded([&] { return engine.transformChunk(chunk.text, chunk.offset); });
+            chunk.error = r.error;
+            appendUtf8(chunk.out, r.text);
+        },
+        [&](TextChunk& chunk) {
+            if (!chunk.error.empty()) {
+                std::cerr << "Error: " << chunk.error << std::endl;
+                failed = true;
+                return false;
+            }
+            out.writeEncoded(chunk.out);
+            return true;
+        });
+    if (failed)
+        return 1;
+    Result r = guarded([&] { engine.finish(offset); return std::wstring(); });
+    if (!r.error.empty()) {
+        std::cerr << "Error: " << r.error << std::endl;
+        return 1;
+    }
+    if (newline)
+        out.put(L'\n');
+    return 0;
+}
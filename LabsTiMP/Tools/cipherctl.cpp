@@ -0,0 +1,186 @@
+/**
+ * @file cipherctl.cpp
+ * @brief Клиент командной строки локальной службы шифрования
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Использование:
+ * @code
+ * cipherctl -s СОКЕТ -c gronsfeld|route -k КЛЮЧ (-e|-d) [--bench N [--connections C]]
+ * cipherctl -s СОКЕТ --stats
+ * @endcode
+ * Каждая строка стандартного ввода отправляется службе отдельным запросом,
+ * результаты печатаются построчно; строка с ошибкой выводится пустой, ошибка —
+ * в стандартный поток ошибок. С --bench строки ввода служат образцами
+ * сообщений: C соединений отправляют по N запросов, печатаются пропускная
+ * способность и процентили задержки на стороне клиента.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "client.h"
+#include "histogram.h"
+
+using namespace std;
+
+namespace {
+
+struct Options {
+    string socket;
+    protocol::Request request;
+    bool modeSet = false;
+    string cipher;
+    bool stats = false;
+    unsigned long bench = 0;
+    unsigned connections = 1;
+};
+
+Options parseOptions(int argc, char** argv)
+{
+    Options opts;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if ((arg == "-s" || arg == "--socket") && hasValue)
+            opts.socket = argv[++i];
+        else if ((arg == "-c" || arg == "--cipher") && hasValue)
+            opts.cipher = argv[++i];
+        else if ((arg == "-k" || arg == "--key") && hasValue)
+            opts.request.key = argv[++i];
+        else if (arg == "-e" || arg == "--encrypt" || arg == "-d" || arg == "--decrypt") {
+            opts.request.op = arg == "-e" || arg == "--encrypt" ? protocol::Op::Encrypt : protocol::Op::Decrypt;
+            opts.modeSet = true;
+        } else if (arg == "--stats")
+            opts.stats = true;
+        else if (arg == "--bench" && hasValue)
+            opts.bench = stoul(argv[++i]);
+        else if (arg == "--connections" && hasValue)
+            opts.connections = stoul(argv[++i]);
+        else
+            throw invalid_argument("unknown option: " + arg);
+    }
+    if (opts.socket.empty())
+        throw invalid_argument("socket path is required");
+    if (opts.stats) {
+        opts.request.op = protocol::Op::Stats;
+        return opts;
+    }
+    if (opts.cipher != "gronsfeld" && opts.cipher != "route")
+        throw invalid_argument("cipher must be gronsfeld or route");
+    opts.request.kind = opts.cipher == "gronsfeld" ? protocol::Kind::Gronsfeld : protocol::Kind::Route;
+    if (opts.request.key.empty())
+        throw invalid_argument("key is required");
+    if (!opts.modeSet)
+        throw invalid_argument("one of --encrypt or --decrypt is required");
+    if (opts.connections == 0)
+        throw invalid_argument("number of connections must be positive");
+    return opts;
+}
+
+vector<string> readLines()
+{
+    vector<string> lines;
+    string line;
+    while (getline(cin, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+int benchmark(const Options& opts, const vector<string>& samples)
+{
+    if (samples.empty())
+        throw invalid_argument("benchmark needs sample messages on standard input");
+    vector<LatencyHistogram> histograms(opts.connections);
+    vector<unsigned long> failures(opts.connections, 0);
+    vector<thread> threads;
+    auto start = chrono::steady_clock::now();
+    for (unsigned t = 0; t < opts.connections; t++) {
+        threads.emplace_back([&, t] {
+            Client client(opts.socket);
+            protocol::Request request = opts.request;
+            for (unsigned long i = 0; i < opts.bench; i++) {
+                request.text = samples[(t + i * opts.connections) % samples.size()];
+                auto begin = chrono::steady_clock::now();
+                protocol::Response response = client.call(request);
+                histograms[t].record(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - begin).count());
+                if (response.status != protocol::Status::Ok)
+                    failures[t]++;
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    LatencyHistogram all;
+    unsigned long failed = 0;
+    for (unsigned t = 0; t < opts.connections; t++) {
+        all.merge(histograms[t]);
+        failed += failures[t];
+    }
+    double s = max(elapsed.count(), 1e-9);
+    printf("%llu requests over %u connection(s) in %.3f s: %.0f requests/s, %lu failed\n",
+           static_cast<unsigned long long>(all.count()), opts.connections, s, all.count() / s, failed);
+    printf("latency us: p50 %.1f, p99 %.1f, p999 %.1f, max %.1f\n", all.percentile(0.5) / 1e3,
+           all.percentile(0.99) / 1e3, all.percentile(0.999) / 1e3, all.max() / 1e3);
+    return 0;
+}
+
+} // namespace
+
+/**
+ * @brief Главная функция клиента
+ * @return 0 при успехе, 1 при ошибке параметров, соединения или шифра
+ */
+int main(int argc, char** argv)
+{
+    Options opts;
+    try {
+        opts = parseOptions(argc, argv);
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        cerr << "Usage: " << argv[0] << " -s SOCKET (-c gronsfeld|route -k KEY (-e|-d) [--bench N"
+             << " [--connections C]] | --stats)" << endl;
+        return 1;
+    }
+
+    try {
+        if (opts.stats) {
+            Client client(opts.socket);
+            cout << client.call(opts.request).body;
+            return 0;
+        }
+        vector<string> lines = readLines();
+        if (opts.bench)
+            return benchmark(opts, lines);
+
+        Client client(opts.socket);
+        protocol::Request request = opts.request;
+        unsigned long errors = 0;
+        for (size_t i = 0; i < lines.size(); i++) {
+            request.text = lines[i];
+            protocol::Response response = client.call(request);
+            if (response.status != protocol::Status::Ok) {
+                cerr << "line " << i + 1 << ": " << response.body << endl;
+                errors++;
+                cout << '\n';
+            } else {
+                cout << response.body << '\n';
+            }
+        }
+        return errors ? 1 : 0;
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+}
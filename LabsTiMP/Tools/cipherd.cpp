@@ -0,0 +1,114 @@
+/**
+ * @file cipherd.cpp
+ * @brief Локальная служба шифрования (демон)
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Использование:
+ * @code
+ * cipherd -s СОКЕТ [--workers N] [--max-connections N] [--queue N] [--batch N] [--cache N]
+ *         [--arena БАЙТ]
+ * @endcode
+ * Служба работает до SIGINT или SIGTERM, затем печатает статистику в
+ * стандартный поток ошибок. Протокол описан в protocol.h, клиент — cipherctl.
+ * --arena задаёт буфер арены запроса в каждом потоке шифрования (по умолчанию
+ * 1 МиБ); запросы, которым его не хватает, учитываются в статистике.
+ */
+
+#include <csignal>
+#include <exception>
+#include <iostream>
+#include <locale>
+#include <string>
+#include "server.h"
+
+using namespace std;
+
+namespace {
+
+Server* running = nullptr;
+
+void onSignal(int)
+{
+    if (running)
+        running->stop();
+}
+
+ServerOptions parseOptions(int argc, char** argv)
+{
+    ServerOptions opts;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if ((arg == "-s" || arg == "--socket") && hasValue)
+            opts.path = argv[++i];
+        else if (arg == "--workers" && hasValue)
+            opts.workers = stoul(argv[++i]);
+        else if (arg == "--max-connections" && hasValue)
+            opts.maxConnections = stoul(argv[++i]);
+        else if (arg == "--queue" && hasValue)
+            opts.queueLimit = stoul(argv[++i]);
+        else if (arg == "--batch" && hasValue)
+            opts.maxBatch = stoul(argv[++i]);
+        else if (arg == "--cache" && hasValue)
+            opts.cacheSize = stoul(argv[++i]);
+        else if (arg == "--arena" && hasValue)
+            opts.arenaSize = stoul(argv[++i]);
+        else
+            throw invalid_argument("unknown option: " + arg);
+    }
+    if (opts.path.empty())
+        throw invalid_argument("socket path is required");
+    if (opts.workers == 0 || opts.maxConnections == 0 || opts.queueLimit == 0 || opts.maxBatch == 0)
+        throw invalid_argument("workers, connections, queue and batch limits must be positive");
+    return opts;
+}
+
+void init_locale()
+{
+    try {
+        locale::global(locale("ru_RU.UTF-8"));
+    } catch (const exception& e) {
+        cerr << "Ошибка установки локали: " << e.what() << endl;
+        locale::global(locale(""));
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Главная функция службы
+ * @return 0 после штатной остановки, 1 при ошибке параметров или сокета
+ */
+int main(int argc, char** argv)
+{
+    init_locale();
+
+    ServerOptions opts;
+    try {
+        opts = parseOptions(argc, argv);
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        cerr << "Usage: " << argv[0] << " -s SOCKET [--workers N] [--max-connections N] [--queue N]"
+             << " [--batch N] [--cache N] [--arena BYTES]" << endl;
+        return 1;
+    }
+
+    Server server(opts);
+    running = &server;
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+    signal(SIGPIPE, SIG_IGN);
+    try {
+        server.run();
+    } catch (const exception& e) {
+        running = nullptr;
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    running = nullptr;
+    cerr << server.statistics();
+    return 0;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file client.cpp
+ * @brief Файл реализации клиента локальной службы шифрования
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "client.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+Client::Client(const std::string& path)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path))
+        throw std::runtime_error("invalid socket path: " + path);
+    std::strcpy(address.sun_path, path.c_str());
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        int error = errno;
+        close(fd);
+        throw std::runtime_error("connect " + path + ": " + std::strerror(error));
+    }
+}
+
+Client::~Client()
+{
+    close(fd);
+}
+
+protocol::Response Client::call(const protocol::Request& request)
+{
+    protocol::sendAll(fd, protocol::encode(request));
+    std::string payload = protocol::receiveFrame(fd);
+    protocol::Response response;
+    if (!protocol::decode(payload.data(), payload.size(), response))
+        throw std::runtime_error("malformed response");
+    return response;
+}
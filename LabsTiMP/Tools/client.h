@@ -0,0 +1,33 @@
+/**
+ * @file client.h
+ * @brief Клиент локальной службы шифрования
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#pragma once
+#include <string>
+#include "protocol.h"
+
+/**
+ * @brief Соединение со службой cipherd
+ * @details Запросы выполняются по одному и синхронно; для параллельных
+ *          запросов нужно несколько соединений. Ошибки соединения сообщаются
+ *          исключением std::runtime_error, ошибки шифра — состоянием ответа.
+ */
+class Client {
+public:
+    /// Подключается к Unix-сокету path
+    explicit Client(const std::string& path);
+    ~Client();
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+
+    /// Отправляет запрос и ждёт ответа
+    protocol::Response call(const protocol::Request& request);
+
+private:
+    int fd = -1;
+};
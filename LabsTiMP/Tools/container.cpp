@@ -0,0 +1,319 @@
+/**
+ * @file container.cpp
+ * @brief Запись и разбор контейнера шифртекста, разметка фрагментов
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "container.h"
+#include <cstring>
+#include <cwctype>
+#include <stdexcept>
+#include "utf8.h"
+
+namespace container {
+
+namespace {
+
+const char headerMagic[8] = { 'T', 'I', 'M', 'P', 'C', 'N', 'T', 'R' };
+const char trailerMagic[8] = { 'T', 'I', 'M', 'P', 'I', 'N', 'D', 'X' };
+const uint8_t version = 1;
+const std::size_t headerSize = 24;
+const std::size_t entrySize = 32;
+const std::size_t trailerSize = 24;
+
+/// Флаги заголовка и окончания
+const uint8_t layoutFlag = 1;
+const uint8_t newlineFlag = 1;
+
+void put(char* p, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+        p[i] = static_cast<char>(v >> (8 * i));
+}
+
+uint64_t get(const char* p, int bytes)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++)
+        v |= uint64_t(static_cast<uint8_t>(p[i])) << (8 * i);
+    return v;
+}
+
+void putVarint(std::string& out, uint64_t v)
+{
+    while (v >= 0x80) {
+        out += static_cast<char>(v | 0x80);
+        v >>= 7;
+    }
+    out += static_cast<char>(v);
+}
+
+[[noreturn]] void corrupt(const char* what)
+{
+    throw std::invalid_argument(std::string("corrupt container: ") + what);
+}
+
+/// Последовательное чтение разметки с проверкой границ
+class Cursor {
+public:
+    explicit Cursor(std::string_view data) : data(data) {}
+
+    uint64_t varint()
+    {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos == data.size())
+                corrupt("truncated layout");
+            uint8_t b = static_cast<uint8_t>(data[pos++]);
+            v |= uint64_t(b & 0x7F) << shift;
+            if (!(b & 0x80))
+                return v;
+        }
+        corrupt("bad number in layout");
+    }
+
+    std::string_view bytes(uint64_t n)
+    {
+        if (n > data.size() - pos)
+            corrupt("truncated layout");
+        std::string_view s = data.substr(pos, n);
+        pos += n;
+        return s;
+    }
+
+    bool done() const { return pos == data.size(); }
+
+private:
+    std::string_view data;
+    std::size_t pos = 0;
+};
+
+} // namespace
+
+Writer::Writer(FILE* file, const Header& header) : file(file)
+{
+    char buf[headerSize] = {};
+    std::memcpy(buf, headerMagic, 8);
+    buf[8] = static_cast<char>(version);
+    buf[9] = static_cast<char>(header.cipher);
+    buf[10] = static_cast<char>(header.layout ? layoutFlag : 0);
+    buf[11] = static_cast<char>(header.routes.write);
+    buf[12] = static_cast<char>(header.routes.read);
+    put(buf + 16, header.chunkSize, 4);
+    write(buf, sizeof(buf));
+}
+
+void Writer::append(std::string_view cipherText, uint64_t letters, std::string_view layout)
+{
+    if (cipherText.size() > UINT32_MAX || layout.size() > UINT32_MAX)
+        throw std::invalid_argument("container chunk is larger than 4 GB");
+    Chunk chunk;
+    chunk.position = position;
+    chunk.cipherSize = static_cast<uint32_t>(cipherText.size());
+    chunk.layoutSize = static_cast<uint32_t>(layout.size());
+    chunk.offset = total;
+    chunk.letters = letters;
+    write(cipherText.data(), cipherText.size());
+    write(layout.data(), layout.size());
+    index.push_back(chunk);
+    total += letters;
+}
+
+void Writer::finish(bool newline)
+{
+    uint64_t indexPosition = position;
+    char buf[entrySize];
+    for (const Chunk& chunk : index) {
+        put(buf, chunk.position, 8);
+        put(buf + 8, chunk.cipherSize, 4);
+        put(buf + 12, chunk.layoutSize, 4);
+        put(buf + 16, chunk.offset, 8);
+        put(buf + 24, chunk.letters, 8);
+        write(buf, sizeof(buf));
+    }
+    char trailer[trailerSize];
+    put(trailer, indexPosition, 8);
+    // Число фрагментов — 7 байт, за ним байт флагов
+    put(trailer + 8, index.size(), 7);
+    trailer[15] = static_cast<char>(newline ? newlineFlag : 0);
+    std::memcpy(trailer + 16, trailerMagic, 8);
+    write(trailer, sizeof(trailer));
+    if (fflush(file) != 0)
+        throw std::runtime_error("cannot write container");
+}
+
+void Writer::write(const void* data, std::size_t size)
+{
+    if (size && fwrite(data, 1, size, file) != size)
+        throw std::runtime_error("cannot write container");
+    position += size;
+}
+
+Reader::Reader(const char* data, std::size_t size) : data(data)
+{
+    if (size < headerSize + trailerSize || std::memcmp(data, headerMagic, 8) != 0)
+        throw std::invalid_argument("not a cipher container");
+    if (static_cast<uint8_t>(data[8]) != version)
+        throw std::invalid_argument("unsupported container version");
+    uint8_t cipher = static_cast<uint8_t>(data[9]);
+    if (cipher < uint8_t(Cipher::Gronsfeld) || cipher > uint8_t(Cipher::Route))
+        corrupt("unknown cipher");
+    uint8_t flags = static_cast<uint8_t>(data[10]);
+    uint8_t write = static_cast<uint8_t>(data[11]), read = static_cast<uint8_t>(data[12]);
+    if ((flags & ~layoutFlag) || write > uint8_t(Route::CounterSpiral) || read > uint8_t(Route::CounterSpiral))
+        corrupt("bad header");
+    head.cipher = static_cast<Cipher>(cipher);
+    head.layout = flags & layoutFlag;
+    head.routes.write = static_cast<Route>(write);
+    head.routes.read = static_cast<Route>(read);
+    head.chunkSize = static_cast<uint32_t>(get(data + 16, 4));
+    if (head.cipher == Cipher::Route && !writableRoute(head.routes.write))
+        corrupt("bad header");
+
+    const char* trailer = data + size - trailerSize;
+    if (std::memcmp(trailer + 16, trailerMagic, 8) != 0)
+        corrupt("missing index");
+    uint64_t indexPosition = get(trailer, 8);
+    uint64_t count = get(trailer + 8, 7);
+    uint8_t trailerFlags = static_cast<uint8_t>(trailer[15]);
+    if (trailerFlags & ~newlineFlag)
+        corrupt("bad index");
+    trailingNewline = trailerFlags & newlineFlag;
+    uint64_t end = size - trailerSize;
+    if (indexPosition < headerSize || indexPosition > end || (end - indexPosition) / entrySize != count ||
+        (end - indexPosition) % entrySize != 0)
+        corrupt("bad index");
+
+    index.resize(count);
+    uint64_t offset = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        const char* p = data + indexPosition + i * entrySize;
+        Chunk& chunk = index[i];
+        chunk.position = get(p, 8);
+        chunk.cipherSize = static_cast<uint32_t>(get(p + 8, 4));
+        chunk.layoutSize = static_cast<uint32_t>(get(p + 12, 4));
+        chunk.offset = get(p + 16, 8);
+        chunk.letters = get(p + 24, 8);
+        if (chunk.position < headerSize || chunk.position > indexPosition ||
+            uint64_t(chunk.cipherSize) + chunk.layoutSize > indexPosition - chunk.position)
+            corrupt("chunk outside the file");
+        if (chunk.offset != offset || chunk.letters > chunk.cipherSize)
+            corrupt("bad letter offsets");
+        if (!head.layout && chunk.layoutSize)
+            corrupt("unexpected layout");
+        offset += chunk.letters;
+    }
+}
+
+std::string_view Reader::cipherText(std::size_t i) const
+{
+    return std::string_view(data + index[i].position, index[i].cipherSize);
+}
+
+std::string_view Reader::layout(std::size_t i) const
+{
+    return std::string_view(data + index[i].position + index[i].cipherSize, index[i].layoutSize);
+}
+
+std::wstring split(const std::wstring& text, std::string& layout)
+{
+    std::wstring letters;
+    letters.reserve(text.size());
+    // Участки небукв: (букв после прошлого участка, длина в UTF-8, байты)
+    std::string runs, lower;
+    uint64_t runCount = 0, lowerCount = 0;
+    uint64_t sinceRun = 0, sinceLower = 0, lowerLength = 0;
+    std::string bytes(4 * text.size(), '\0');
+    for (std::size_t i = 0; i < text.size();) {
+        wchar_t c = text[i];
+        if (std::iswalpha(c)) {
+            bool isLower = static_cast<wchar_t>(std::towupper(c)) != c;
+            if (isLower) {
+                lowerLength++;
+            } else if (lowerLength) {
+                putVarint(lower, sinceLower);
+                putVarint(lower, lowerLength);
+                lowerCount++;
+                sinceLower = 0;
+                lowerLength = 0;
+            }
+            if (!isLower)
+                sinceLower++;
+            letters += c;
+            sinceRun++;
+            i++;
+            continue;
+        }
+        std::size_t end = i;
+        while (end < text.size() && !std::iswalpha(text[end]))
+            end++;
+        std::size_t n = utf8::encode(text.data() + i, end - i, &bytes[0]);
+        putVarint(runs, sinceRun);
+        putVarint(runs, n);
+        runs.append(bytes.data(), n);
+        runCount++;
+        sinceRun = 0;
+        i = end;
+    }
+    if (lowerLength) {
+        putVarint(lower, sinceLower);
+        putVarint(lower, lowerLength);
+        lowerCount++;
+    }
+    layout.clear();
+    putVarint(layout, runCount);
+    layout += runs;
+    putVarint(layout, lowerCount);
+    layout += lower;
+    return letters;
+}
+
+std::wstring merge(const std::wstring& letters, std::string_view layout)
+{
+    // Сначала регистр: он записан после участков небукв
+    Cursor in(layout);
+    uint64_t runCount = in.varint();
+    for (uint64_t r = 0; r < runCount; r++) {
+        in.varint();
+        in.bytes(in.varint());
+    }
+    std::wstring cased = letters;
+    uint64_t lowerCount = in.varint(), pos = 0;
+    for (uint64_t r = 0; r < lowerCount; r++) {
+        uint64_t gap = in.varint(), length = in.varint();
+        if (gap > cased.size() - pos || length > cased.size() - pos - gap)
+            corrupt("layout does not match the letters");
+        pos += gap;
+        for (uint64_t end = pos + length; pos < end; pos++)
+            cased[pos] = std::towlower(cased[pos]);
+    }
+    if (!in.done())
+        corrupt("trailing bytes in layout");
+
+    Cursor runs(layout);
+    runs.varint();
+    std::wstring text;
+    text.reserve(letters.size() + layout.size());
+    std::vector<wchar_t> chars;
+    pos = 0;
+    for (uint64_t r = 0; r < runCount; r++) {
+        uint64_t gap = runs.varint();
+        if (gap > cased.size() - pos)
+            corrupt("layout does not match the letters");
+        text.append(cased, pos, gap);
+        pos += gap;
+        std::string_view bytes = runs.bytes(runs.varint());
+        chars.resize(bytes.size() + 2);
+        utf8::Decoder decoder;
+        std::size_t n = decoder.decode(bytes.data(), bytes.size(), chars.data());
+        n += decoder.finish(chars.data() + n);
+        text.append(chars.data(), n);
+    }
+    text.append(cased, pos, std::wstring::npos);
+    return text;
+}
+
+} // namespace container
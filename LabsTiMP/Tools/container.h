@@ -0,0 +1,165 @@
+/**
+ * @file container.h
+ * @brief Контейнер шифртекста с независимыми фрагментами и индексом
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Шифртекст modAlphaCipher и RouteCipher — сплошная строка прописных букв:
+ * по ней нельзя найти начало части сообщения, а пробелы, знаки и регистр
+ * исходного текста теряются. Контейнер хранит сообщение фрагментами:
+ * @code
+ * заголовок (24 байта)
+ * фрагмент 0: шифртекст в UTF-8, затем разметка
+ * ...
+ * индекс: по 32 байта на фрагмент
+ * окончание (24 байта): положение индекса, число фрагментов, флаги
+ * @endcode
+ * Все числа записываются в порядке little-endian. Заголовок содержит шифр,
+ * маршруты маршрутной перестановки и размер фрагмента, но не ключ. Каждый
+ * фрагмент расшифровывается отдельно: для шифра Гронсфельда индекс хранит
+ * количество букв сообщения перед фрагментом (позицию ключа), при
+ * маршрутной перестановке фрагмент зашифрован как отдельное сообщение.
+ * Индекс в конце файла позволяет писать контейнер последовательно (в том
+ * числе в канал), а читать — с любого фрагмента.
+ *
+ * Разметка фрагмента (если в заголовке есть флаг layout) хранит символы,
+ * которые не попали в шифр, и строчные буквы, поэтому расшифрованный
+ * фрагмент в точности совпадает с исходным текстом. Разметка раскрывает
+ * расположение пробелов и знаков, но не буквы.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../Lab4/route_plan.h"
+
+namespace container {
+
+/// Шифр сообщения в контейнере
+enum class Cipher : uint8_t {
+    Gronsfeld = 1,  ///< modAlphaCipher с числовым ключом
+    RunningKey = 2, ///< runningKeyCipher с бегущим ключом из файла
+    Route = 3       ///< RouteCipher
+};
+
+/// Параметры контейнера, записанные в заголовок
+struct Header {
+    Cipher cipher = Cipher::Gronsfeld;
+    RouteSpec routes;       ///< Маршруты (для Cipher::Route)
+    bool layout = false;    ///< Фрагменты содержат разметку
+    uint32_t chunkSize = 0; ///< Символов исходного текста во фрагменте (последний может быть короче)
+};
+
+/// Запись индекса
+struct Chunk {
+    uint64_t position = 0;   ///< Начало фрагмента в файле, байт
+    uint32_t cipherSize = 0; ///< Длина шифртекста, байт
+    uint32_t layoutSize = 0; ///< Длина разметки за шифртекстом, байт
+    uint64_t offset = 0;     ///< Количество букв сообщения перед фрагментом
+    uint64_t letters = 0;    ///< Количество букв фрагмента
+};
+
+/**
+ * @brief Последовательная запись контейнера
+ * @details Ошибки записи сообщаются исключением std::runtime_error.
+ */
+class Writer {
+public:
+    /**
+     * @brief Записывает заголовок
+     * @param[in] file Открытый для записи файл
+     * @param[in] header Параметры контейнера
+     */
+    Writer(FILE* file, const Header& header);
+
+    /**
+     * @brief Дописывает фрагмент
+     * @param[in] cipherText Шифртекст фрагмента в UTF-8
+     * @param[in] letters Количество букв шифртекста
+     * @param[in] layout Разметка (пустая, если в заголовке нет флага layout)
+     * @throw std::invalid_argument Если фрагмент длиннее 4 ГБ
+     */
+    void append(std::string_view cipherText, uint64_t letters, std::string_view layout);
+
+    /**
+     * @brief Записывает индекс и окончание
+     * @param[in] newline Сообщение оканчивалось переводом строки, не вошедшим в фрагменты
+     */
+    void finish(bool newline);
+
+    /// Количество букв во всех фрагментах
+    uint64_t letters() const { return total; }
+    /// Записано байт
+    uint64_t bytesWritten() const { return position; }
+
+private:
+    FILE* file;
+    std::vector<Chunk> index;
+    uint64_t position = 0;
+    uint64_t total = 0;
+
+    void write(const void* data, std::size_t size);
+};
+
+/**
+ * @brief Разбор контейнера, отображённого в память
+ * @details Конструктор проверяет заголовок, окончание и индекс: фрагменты
+ *          лежат между заголовком и индексом, позиции букв идут подряд.
+ *          Повреждённый файл даёт std::invalid_argument, а не чтение за
+ *          пределами буфера. Объект не копирует данные и только читает их,
+ *          поэтому фрагменты можно расшифровывать из нескольких потоков.
+ */
+class Reader {
+public:
+    /**
+     * @param[in] data Содержимое файла
+     * @param[in] size Длина файла, байт
+     * @throw std::invalid_argument Если данные не являются контейнером или повреждены
+     */
+    Reader(const char* data, std::size_t size);
+
+    const Header& header() const { return head; }
+    /// Количество фрагментов
+    std::size_t chunks() const { return index.size(); }
+    /// Запись индекса фрагмента i
+    const Chunk& chunk(std::size_t i) const { return index[i]; }
+    /// Шифртекст фрагмента i в UTF-8
+    std::string_view cipherText(std::size_t i) const;
+    /// Разметка фрагмента i
+    std::string_view layout(std::size_t i) const;
+    /// Сообщение оканчивалось переводом строки
+    bool newline() const { return trailingNewline; }
+
+private:
+    const char* data;
+    Header head;
+    std::vector<Chunk> index;
+    bool trailingNewline = false;
+};
+
+/**
+ * @brief Отделяет буквы от остального текста
+ * @details Буквы (iswalpha в текущей локали) возвращаются как есть и
+ *          передаются шифру; прочие символы и положение строчных букв
+ *          записываются в разметку.
+ * @param[in] text Фрагмент исходного текста
+ * @param[out] layout Разметка фрагмента
+ * @return Буквы фрагмента
+ */
+std::wstring split(const std::wstring& text, std::string& layout);
+
+/**
+ * @brief Восстанавливает исходный текст по буквам и разметке (обращение split)
+ * @param[in] letters Буквы фрагмента, как их вернул шифр (прописные)
+ * @param[in] layout Разметка фрагмента
+ * @throw std::invalid_argument Если разметка повреждена или не соответствует числу букв
+ */
+std::wstring merge(const std::wstring& letters, std::string_view layout);
+
+} // namespace container
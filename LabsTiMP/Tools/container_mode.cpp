@@ -0,0 +1,189 @@
+/**
+ * @file container_mode.cpp
+ * @brief Режим --container: запись и параллельное расшифрование контейнера шифртекста
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "modes.h"
+#include "container.h"
+#include "mapped_file.h"
+#include "pipeline.h"
+#include "scheduler.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+/// Шифр контейнера, соответствующий параметрам командной строки
+container::Cipher containerCipher(const Options& opts)
+{
+    if (opts.cipher == "route")
+        return container::Cipher::Route;
+    return opts.runningKey.empty() ? container::Cipher::Gronsfeld : container::Cipher::RunningKey;
+}
+
+/// Фрагмент конвейера при записи контейнера
+struct ContainerChunk {
+    std::wstring text;
+    uint64_t offset = 0;  ///< Количество букв сообщения перед фрагментом
+    std::string out;      ///< Шифртекст в UTF-8
+    uint64_t letters = 0; ///< Количество букв шифртекста
+    std::string layout;
+    std::string error;
+};
+
+} // namespace
+
+uint64_t processContainerEncrypt(Engine& engine, Input& in, FILE* file, const Options& opts, uint64_t& bytesOut)
+{
+    try {
+        container::Header header;
+        header.cipher = containerCipher(opts);
+        if (header.cipher == container::Cipher::Route)
+            header.routes = routeSpec(opts);
+        header.layout = opts.layout;
+        header.chunkSize = static_cast<uint32_t>(opts.chunk);
+        container::Writer writer(file, header);
+
+        uint64_t offset = 0;
+        bool newline = false;
+        std::string error;
+        Pipeline<ContainerChunk> pipeline(opts.threads, pipelineDepth, opts.pin);
+        pipeline.run(
+            [&](ContainerChunk& chunk) {
+                chunk.text.clear();
+                if (!in.read(chunk.text, opts.chunk))
+                    return false;
+                // С разметкой перевод строки сохраняется в ней, как и прочие небуквы
+                if (in.done() && !opts.layout)
+                    newline = stripNewline(chunk.text);
+                chunk.offset = offset;
+                offset += engine.letters(chunk.text);
+                return true;
+            },
+            [&](ContainerChunk& chunk) {
+                chunk.out.clear();
+                chunk.layout.clear();
+                Result r = guarded([&] {
+                    std::wstring letters = opts.layout ? container::split(chunk.text, chunk.layout) : chunk.text;
+                    if (engine.chunked())
+                        return engine.transformChunk(letters, chunk.offset);
+                    // Фрагмент маршрутной перестановки без букв остаётся пустым
+                    if (letters.find_first_not_of(L' ') == std::wstring::npos)
+                        return std::wstring();
+                    return engine.transform(letters);
+                });
+                chunk.error = r.error;
+                chunk.letters = r.text.size();
+                appendUtf8(chunk.out, r.text);
+            },
+            [&](ContainerChunk& chunk) {
+                if (chunk.error.empty()) {
+                    Result r = guarded([&] {
+                        writer.append(chunk.out, chunk.letters, chunk.layout);
+                        return std::wstring();
+                    });
+                    chunk.error = r.error;
+                }
+                error = chunk.error;
+                return error.empty();
+            });
+        if (!error.empty())
+            throw std::runtime_error(error);
+        if (engine.chunked())
+            engine.finish(writer.letters());
+        else if (writer.letters() == 0)
+            engine.transform(std::wstring());
+        writer.finish(newline);
+        bytesOut = writer.bytesWritten();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+uint64_t processContainerDecrypt(Engine& engine, const Options& opts, Scheduler* scheduler, uint64_t& bytesIn,
+                                 uint64_t& bytesOut)
+{
+    try {
+        MappedFile in = MappedFile::openRead(opts.input);
+        container::Reader reader(in.data(), in.size());
+        const container::Header& header = reader.header();
+        if (header.cipher != containerCipher(opts))
+            throw std::invalid_argument("container was written with another cipher");
+        if (header.cipher == container::Cipher::Route && header.routes != routeSpec(opts))
+            throw std::invalid_argument(std::string("container uses --route ") + routeName(header.routes.write) + ":" +
+                                        routeName(header.routes.read));
+        if (opts.chunkFirst > reader.chunks())
+            throw std::invalid_argument("chunk range is outside the container");
+        std::size_t first = static_cast<std::size_t>(opts.chunkFirst);
+        std::size_t last = reader.chunks() - first < opts.chunkCount ? reader.chunks() : first + opts.chunkCount;
+        if (opts.chunks.empty())
+            in.adviseSequential();
+        else
+            in.adviseRandom();
+
+        FILE* file = opts.output.empty() ? stdout : fopen(opts.output.c_str(), "wb");
+        if (!file)
+            throw std::runtime_error("cannot open " + opts.output + ": " + strerror(errno));
+        Output out(file);
+        auto decrypt = [&](std::size_t i) {
+            const container::Chunk& chunk = reader.chunk(i);
+            std::string_view bytes = reader.cipherText(i);
+            std::vector<wchar_t> chars(bytes.size() + 2);
+            utf8::Decoder decoder;
+            std::size_t n = decoder.decode(bytes.data(), bytes.size(), chars.data());
+            n += decoder.finish(chars.data() + n);
+            std::wstring cipherText(chars.data(), n), letters;
+            if (engine.chunked())
+                letters = engine.transformChunk(cipherText, chunk.offset);
+            else if (!cipherText.empty())
+                letters = engine.transform(cipherText);
+            return header.layout ? container::merge(letters, reader.layout(i)) : letters;
+        };
+
+        // Пачка фрагментов расшифровывается параллельно и выводится по порядку
+        std::size_t batch = scheduler ? 4 * opts.threads : 1;
+        std::vector<Result> results;
+        std::string error;
+        for (std::size_t b = first; b < last && error.empty(); b += batch) {
+            results.assign(std::min(batch, last - b), Result());
+            auto body = [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++)
+                    results[i] = guarded([&] { return decrypt(b + i); });
+            };
+            if (scheduler)
+                scheduler->parallelFor(results.size(), 1, body);
+            else
+                body(0, results.size());
+            for (std::size_t i = 0; i < results.size() && error.empty(); i++) {
+                const container::Chunk& chunk = reader.chunk(b + i);
+                bytesIn += chunk.cipherSize + chunk.layoutSize;
+                if (results[i].error.empty())
+                    out.write(results[i].text);
+                else
+                    error = "chunk " + std::to_string(b + i) + ": " + results[i].error;
+            }
+        }
+        if (error.empty() && last == reader.chunks() && reader.newline())
+            out.put(L'\n');
+        bool written = out.flush();
+        bytesOut = out.bytesWritten();
+        if (file != stdout)
+            written = fclose(file) == 0 && written;
+        if (!error.empty())
+            throw std::runtime_error(error);
+        if (!written)
+            throw std::runtime_error("cannot write output");
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
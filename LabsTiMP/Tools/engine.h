@@ -0,0 +1,189 @@
+/**
+ * @file engine.h
+ * @brief Единый интерфейс шифров для утилит пакетной обработки
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Реализации для modAlphaCipher и RouteCipher находятся в
+ * gronsfeld_engine.cpp и route_engine.cpp, сами шифры берутся из библиотеки
+ * Lib/libtimpcipher.a. Ошибки шифров передаются наружу как есть
+ * (cipher_error из Lib/cipher_error.h наследует std::invalid_argument).
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "../Lab4/route_plan.h"
+
+class Scheduler;
+
+/// Направление преобразования
+enum class Mode { Encrypt, Decrypt };
+
+/**
+ * @brief Шифр с выбранным ключом и направлением
+ */
+class Engine {
+public:
+    virtual ~Engine() {}
+
+    /**
+     * @brief Преобразует сообщение целиком (семантика исходного класса шифра)
+     * @param[in] text Сообщение
+     * @return Результат зашифрования или расшифрования
+     * @throw std::invalid_argument При ошибке шифра
+     */
+    virtual std::wstring transform(const std::wstring& text) = 0;
+
+    /**
+     * @brief Преобразует сообщение целиком, выделяя память из resource
+     * @details Промежуточные буферы шифра и результат размещаются в resource,
+     *          например в арене запроса, освобождаемой целиком. Результат и
+     *          ошибки совпадают с transform(const std::wstring&).
+     * @param[in] text Сообщение
+     * @param[in] resource Источник памяти
+     * @throw std::invalid_argument При ошибке шифра
+     */
+    virtual std::pmr::wstring transform(std::wstring_view text, std::pmr::memory_resource* resource) = 0;
+
+    /**
+     * @brief Можно ли обрабатывать одно сообщение независимыми фрагментами
+     * @details Для шифра Гронсфельда результат для буквы зависит только от её
+     *          номера в сообщении, для маршрутной перестановки — от всего текста.
+     */
+    virtual bool chunked() const = 0;
+
+    /**
+     * @brief Количество букв фрагмента, которые сдвигают позицию ключа
+     * @param[in] chunk Фрагмент сообщения
+     */
+    virtual uint64_t letters(const std::wstring& chunk) const = 0;
+
+    /**
+     * @brief Преобразует фрагмент сообщения (только если chunked())
+     * @details Фрагмент без букв даёт пустой результат; ошибка «пустое сообщение»
+     *          проверяется для всего сообщения методом finish().
+     * @param[in] chunk Фрагмент сообщения
+     * @param[in] offset Количество букв сообщения перед фрагментом
+     * @throw std::invalid_argument При ошибке шифра
+     */
+    virtual std::wstring transformChunk(const std::wstring& chunk, uint64_t offset) = 0;
+
+    /**
+     * @brief Завершает сообщение, обработанное фрагментами
+     * @param[in] total Общее количество букв сообщения
+     * @throw std::invalid_argument Та же ошибка, что и у transform() для сообщения без букв
+     */
+    virtual void finish(uint64_t total) = 0;
+
+    /**
+     * @brief Преобразует сообщение, отображённое в память, целиком
+     * @details Вход читается последовательно, результат пишется прямо в
+     *          отображённый выходной файл, без промежуточной std::wstring
+     *          для всего сообщения. Результат совпадает с transform() для
+     *          того же сообщения в UTF-8 и никогда не длиннее входа.
+     * @param[in] in Сообщение в UTF-8
+     * @param[in] size Длина сообщения, байт
+     * @param[out] out Буфер не менее size байт
+     * @return Длина результата, байт
+     * @throw std::invalid_argument При ошибке шифра
+     */
+    virtual std::size_t transformMapped(const char* in, std::size_t size, char* out) = 0;
+
+    /**
+     * @brief Расшифровывает часть шифртекста, отображённого в память
+     * @details Шифртекст обоих шифров состоит из русских прописных букв,
+     *          каждая из которых занимает в UTF-8 два байта, поэтому буква
+     *          номер k начинается с байта 2k и читаются только нужные буквы.
+     *          Результат совпадает с частью transform() для всего шифртекста.
+     * @param[in] in Шифртекст в UTF-8
+     * @param[in] size Длина шифртекста, байт (чётная)
+     * @param[in] offset Номер первой буквы открытого текста
+     * @param[in] count Количество букв, offset + count <= size / 2
+     * @return Буквы открытого текста с номерами offset..offset+count-1
+     * @throw std::invalid_argument При ошибке шифра или букве не из двух байт
+     */
+    virtual std::wstring decryptMappedRange(const char* in, std::size_t size, uint64_t offset, std::size_t count) = 0;
+
+    /**
+     * @brief Преобразует сообщение целиком, разбивая работу на задачи планировщика
+     * @details Сообщение длиной не более grain символов преобразуется одной
+     *          задачей. Результат и ошибки совпадают с transform(). Части
+     *          буфера out пишут задачи, которые их вычисляют, поэтому буфер,
+     *          ещё не заполненный (PageBuffer), размещается в памяти их узлов NUMA.
+     * @param[in] text Сообщение
+     * @param[in] length Длина сообщения, символов
+     * @param[out] out Буфер не меньше length символов
+     * @param[in] scheduler Планировщик задач
+     * @param[in] grain Наибольшая длина части сообщения для одной задачи, символов
+     * @return Длина результата
+     * @throw std::invalid_argument При ошибке шифра
+     * @throw std::length_error Если результат длиннее сообщения
+     */
+    virtual std::size_t transformTasks(const wchar_t* text, std::size_t length, wchar_t* out, Scheduler& scheduler,
+                                       std::size_t grain)
+    {
+        (void)scheduler;
+        (void)grain;
+        return copyResult(transform(std::wstring(text, length)), length, out);
+    }
+
+    /// Преобразует сообщение задачами планировщика в новую строку
+    std::wstring transformTasks(const std::wstring& text, Scheduler& scheduler, std::size_t grain)
+    {
+        std::wstring result(text.size(), L'\0');
+        result.resize(transformTasks(text.data(), text.size(), &result[0], scheduler, grain));
+        return result;
+    }
+
+protected:
+    /**
+     * @brief Копирует результат transform() в буфер transformTasks()
+     * @param[in] capacity Размер буфера, символов
+     * @return Длина результата
+     * @throw std::length_error Если результат не помещается
+     */
+    static std::size_t copyResult(const std::wstring& result, std::size_t capacity, wchar_t* out)
+    {
+        if (result.size() > capacity)
+            throw std::length_error("result is longer than the message");
+        std::copy(result.begin(), result.end(), out);
+        return result.size();
+    }
+};
+
+/**
+ * @brief Создаёт шифр Гронсфельда (modAlphaCipher)
+ * @param[in] key Ключ
+ * @param[in] mode Направление преобразования
+ * @throw std::invalid_argument Если ключ недопустим
+ */
+std::unique_ptr<Engine> makeGronsfeldEngine(const std::wstring& key, Mode mode);
+
+/**
+ * @brief Создаёт шифр Гронсфельда с бегущим ключом (runningKeyCipher)
+ * @details Файл ключа (UTF-8) отображается в память и читается по мере
+ *          шифрования; буквы ключа не из алфавита и небуквы пропускаются.
+ * @param[in] keyPath Путь к файлу ключа
+ * @param[in] keyOffset Количество букв ключа, пропускаемых перед сообщением
+ * @param[in] mode Направление преобразования
+ * @throw std::runtime_error Если файл ключа не удаётся отобразить
+ */
+std::unique_ptr<Engine> makeRunningKeyEngine(const std::string& keyPath, uint64_t keyOffset, Mode mode);
+
+/**
+ * @brief Создаёт шифр табличной маршрутной перестановки (RouteCipher)
+ * @param[in] columns Количество столбцов
+ * @param[in] mode Направление преобразования
+ * @param[in] routes Маршруты записи и считывания
+ * @throw std::invalid_argument Если количество столбцов или маршрут записи недопустимы
+ */
+std::unique_ptr<Engine> makeRouteEngine(std::int64_t columns, Mode mode, const RouteSpec& routes = RouteSpec());
@@ -0,0 +1,416 @@
+/**
+ * @file gronsfeld_engine.cpp
+ * @brief Адаптеры шифра Гронсфельда (modAlphaCipher, runningKeyCipher) к интерфейсу Engine
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "engine.h"
+#include "mapped_file.h"
+#include "scheduler.h"
+#include "utf8.h"
+#include "../Lab3/GronsveldMethod/modAlphaCipher.h"
+#include <algorithm>
+#include <cstdint>
+#include <cwctype>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+/// Окно обработки отображённого сообщения, байт
+const std::size_t mappedWindow = 4 << 20;
+/// Блок однопроходной обработки отображённого сообщения, байт (буфер блока — на стеке)
+const std::size_t fusedBlock = 4 << 10;
+/// Окно декодирования бегущего ключа, байт
+const std::size_t keyWindow = 64 << 10;
+/// Расстояние между опорными точками бегущего ключа, байт
+const std::size_t keyCheckpoint = 1 << 20;
+
+/// Длина символов в UTF-8, байт
+std::size_t utf8Length(const wchar_t* s, std::size_t size)
+{
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < size; i++)
+        n += s[i] < 0x80 ? 1 : s[i] < 0x800 ? 2 : s[i] < 0x10000 ? 3 : 4;
+    return n;
+}
+
+/// Длина строки в UTF-8, байт
+std::size_t utf8Length(const std::wstring& s)
+{
+    return utf8Length(s.data(), s.size());
+}
+
+/**
+ * @brief Шифр Гронсфельда, обрабатывающий сообщение по фрагментам
+ * @details Общая часть обычного и бегущего ключа: результат для буквы
+ *          зависит только от её номера в сообщении, поэтому отображённое
+ *          сообщение обрабатывается окнами, а длинное — задачами планировщика.
+ */
+class ChunkedEngine : public Engine {
+public:
+    explicit ChunkedEngine(Mode mode) : mode(mode) {}
+
+    bool chunked() const override { return true; }
+
+    uint64_t letters(const std::wstring& chunk) const override
+    {
+        if (mode == Mode::Decrypt)
+            return chunk.size();
+        uint64_t n = 0;
+        for (wchar_t c : chunk) {
+            if (iswalpha(c))
+                n++;
+        }
+        return n;
+    }
+
+    std::size_t transformMapped(const char* in, std::size_t size, char* out) override
+    {
+        // Окна по mappedWindow байт: в памяти находится только текущее окно
+        std::vector<wchar_t> chars(mappedWindow + 1);
+        utf8::Decoder decoder;
+        uint64_t offset = 0;
+        std::size_t written = 0, pos = 0;
+        do {
+            std::size_t n = std::min(mappedWindow, size - pos);
+            std::size_t count = decoder.decode(in + pos, n, chars.data());
+            pos += n;
+            if (pos == size)
+                count += decoder.finish(chars.data() + count);
+            std::wstring chunk(chars.data(), count);
+            std::wstring result = transformChunk(chunk, offset);
+            offset += letters(chunk);
+            if (written + utf8Length(result) > size)
+                throw std::length_error("result is longer than the mapped output");
+            written += utf8::encode(result.data(), result.size(), out + written);
+        } while (pos < size);
+        finish(offset);
+        return written;
+    }
+
+    std::wstring decryptMappedRange(const char* in, std::size_t, uint64_t offset, std::size_t count) override
+    {
+        // Сдвиг ключа зависит только от номера буквы: часть — это фрагмент со смещением offset
+        std::vector<wchar_t> chars(2 * count + 1);
+        utf8::Decoder decoder;
+        std::size_t n = decoder.decode(in + 2 * offset, 2 * count, chars.data());
+        n += decoder.finish(chars.data() + n);
+        if (n != count)
+            throw std::invalid_argument("cipher text must consist of two-byte UTF-8 letters");
+        return transformChunk(std::wstring(chars.data(), n), offset);
+    }
+
+    std::size_t transformTasks(const wchar_t* text, std::size_t length, wchar_t* out, Scheduler& scheduler,
+                               std::size_t grain) override
+    {
+        auto whole = [&] { return copyResult(transform(std::wstring(text, length)), length, out); };
+        auto part = [&](std::size_t i) { return std::wstring(text + i * grain, std::min(grain, length - i * grain)); };
+        if (length <= grain)
+            return whole();
+        // Части по grain символов: подсчёт букв, префиксные суммы, затем
+        // независимое преобразование каждой части со своим сдвигом ключа
+        std::size_t parts = (length + grain - 1) / grain;
+        std::vector<uint64_t> offsets(parts + 1, 0);
+        scheduler.parallelFor(parts, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++)
+                offsets[i + 1] = letters(part(i));
+        });
+        for (std::size_t i = 0; i < parts; i++)
+            offsets[i + 1] += offsets[i];
+        if (offsets[parts] == 0)
+            return whole();
+
+        std::vector<std::wstring> results(parts);
+        try {
+            scheduler.parallelFor(parts, 1, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++)
+                    results[i] = transformChunk(part(i), offsets[i]);
+            });
+        } catch (const cipher_error&) {
+            // Ошибка с тем же текстом, что и для сообщения целиком
+            return whole();
+        }
+
+        std::vector<std::size_t> positions(parts + 1, 0);
+        for (std::size_t i = 0; i < parts; i++)
+            positions[i + 1] = positions[i] + results[i].size();
+        if (positions[parts] > length)
+            throw std::length_error("result is longer than the message");
+        scheduler.parallelFor(parts, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++)
+                std::copy(results[i].begin(), results[i].end(), out + positions[i]);
+        });
+        return positions[parts];
+    }
+
+protected:
+    Mode mode;
+};
+
+/**
+ * @brief Шифр Гронсфельда с повторяющимся ключом
+ * @details Фрагмент, перед которым в сообщении стоит offset букв,
+ *          преобразуется с позиции ключа offset % длина ключа
+ *          (modAlphaCipher::encryptAt/decryptAt). Все фрагменты и задачи
+ *          используют один экземпляр шифра без блокировок.
+ */
+class GronsfeldEngine : public ChunkedEngine {
+public:
+    GronsfeldEngine(const std::wstring& key, Mode mode) : ChunkedEngine(mode), cipher(key) {}
+
+    std::wstring transform(const std::wstring& text) override
+    {
+        return mode == Mode::Encrypt ? cipher.encrypt(text) : cipher.decrypt(text);
+    }
+
+    std::pmr::wstring transform(std::wstring_view text, std::pmr::memory_resource* resource) override
+    {
+        return mode == Mode::Encrypt ? cipher.encrypt(text, resource) : cipher.decrypt(text, resource);
+    }
+
+    /**
+     * @brief Преобразование отображённого сообщения за один проход
+     * @details Блок в fusedBlock байт декодируется в буфер на стеке,
+     *          преобразуется в нём же (encryptBlock/decryptBlock: проверка,
+     *          приведение, номер буквы и сдвиг) и сразу кодируется в выход,
+     *          поэтому каждый байт входа читается и каждый байт выхода
+     *          пишется один раз. Ошибки копятся в modAlphaCipher::Stream и
+     *          сообщаются после последнего блока с тем же текстом, что и для
+     *          сообщения целиком; после ошибки блоки только проверяются.
+     */
+    std::size_t transformMapped(const char* in, std::size_t size, char* out) override
+    {
+        modAlphaCipher::Stream stream;
+        wchar_t chars[fusedBlock + 1];
+        utf8::Decoder decoder;
+        std::size_t written = 0, pos = 0;
+        do {
+            std::size_t n = std::min(fusedBlock, size - pos);
+            std::size_t count = decoder.decode(in + pos, n, chars);
+            pos += n;
+            if (pos == size)
+                count += decoder.finish(chars + count);
+            count = mode == Mode::Encrypt ? cipher.encryptBlock(chars, count, stream, chars)
+                                          : cipher.decryptBlock(chars, count, stream, chars);
+            // Небуква в шифртексте — окончательная ошибка
+            if (stream.invalid)
+                break;
+            if (stream.foreign)
+                continue;
+            if (written + utf8Length(chars, count) > size)
+                throw std::length_error("result is longer than the mapped output");
+            written += utf8::encode(chars, count, out + written);
+        } while (pos < size);
+        if (mode == Mode::Encrypt)
+            modAlphaCipher::finishEncrypt(stream);
+        else
+            modAlphaCipher::finishDecrypt(stream);
+        return written;
+    }
+
+    std::wstring transformChunk(const std::wstring& chunk, uint64_t offset) override
+    {
+        // Фрагмент без букв допустим; пустое сообщение проверяет finish()
+        std::wstring result(chunk.size(), L'\0');
+        result.resize(mode == Mode::Encrypt ? cipher.encryptAt(chunk.data(), chunk.size(), offset, &result[0])
+                                            : cipher.decryptAt(chunk.data(), chunk.size(), offset, &result[0]));
+        return result;
+    }
+
+    void finish(uint64_t total) override
+    {
+        if (total == 0)
+            transform(std::wstring());
+    }
+
+private:
+    modAlphaCipher cipher;
+};
+
+/**
+ * @brief Шифр Гронсфельда с бегущим ключом из отображённого файла
+ * @details Ключ (UTF-8) декодируется окнами по keyWindow байт в ногу с
+ *          текстом; в памяти находится только текущее окно ключа. Для
+ *          перехода к букве ключа с заданным номером (смещение ключа,
+ *          фрагменты, задачи) запоминаются опорные точки через каждые
+ *          keyCheckpoint байт: номер байта и количество букв перед ним.
+ *          Точки строятся по мере продвижения по ключу, поэтому переход
+ *          к букве читает не более keyCheckpoint байт сверх уже просмотренных.
+ *          Позиция после последнего фрагмента запоминается, и
+ *          последовательные фрагменты продолжают чтение ключа без поиска.
+ */
+class RunningKeyEngine : public ChunkedEngine {
+public:
+    RunningKeyEngine(const std::string& path, uint64_t keyOffset, Mode mode) :
+        ChunkedEngine(mode), key(MappedFile::openRead(path)), keyOffset(keyOffset)
+    {
+        key.adviseSequential();
+        checkpoints.push_back({ 0, 0 });
+    }
+
+    std::wstring transform(const std::wstring& text) override
+    {
+        std::wstring result = transformChunk(text, 0);
+        finish(text.empty() ? 0 : letters(text));
+        return result;
+    }
+
+    std::pmr::wstring transform(std::wstring_view text, std::pmr::memory_resource* resource) override
+    {
+        std::pmr::wstring result(text.size(), L'\0', resource);
+        if (!text.empty()) {
+            Cursor cursor = seek(keyOffset);
+            result.resize(run(cursor, text.data(), text.size(), result.data()));
+        }
+        finish(mode == Mode::Encrypt ? result.size() : text.size());
+        return result;
+    }
+
+    std::wstring transformChunk(const std::wstring& chunk, uint64_t offset) override
+    {
+        if (chunk.empty())
+            return std::wstring();
+        std::wstring result(chunk.size(), L'\0');
+        Cursor cursor = seek(keyOffset + offset);
+        result.resize(run(cursor, chunk.data(), chunk.size(), &result[0]));
+        park(std::move(cursor), keyOffset + offset + (mode == Mode::Encrypt ? result.size() : chunk.size()));
+        return result;
+    }
+
+    void finish(uint64_t total) override
+    {
+        if (total == 0)
+            throw cipher_error(mode == Mode::Encrypt ? "Пустой открытый текст" : "Пустой шифртекст");
+    }
+
+private:
+    /// Опорная точка: байт ключа на границе символа и количество букв перед ним
+    struct Checkpoint {
+        std::size_t byte;
+        uint64_t letters;
+    };
+
+    /// Позиция чтения ключа: декодированное окно и следующий байт файла
+    struct Cursor {
+        std::size_t byte = 0;
+        utf8::Decoder decoder;
+        std::vector<wchar_t> chars;
+        std::size_t pos = 0, count = 0;
+    };
+
+    MappedFile key;
+    uint64_t keyOffset;
+    runningKeyCipher cipher;
+    std::vector<Checkpoint> checkpoints;
+    Cursor parked;
+    uint64_t parkedLetter = 0;
+    bool hasParked = false;
+    std::mutex lock;
+
+    /// Декодирует следующее окно ключа; false, если ключ исчерпан
+    bool refill(Cursor& cursor) const
+    {
+        if (cursor.byte == key.size())
+            return false;
+        std::size_t n = std::min(keyWindow, key.size() - cursor.byte);
+        cursor.chars.resize(keyWindow + 1);
+        cursor.count = cursor.decoder.decode(key.data() + cursor.byte, n, cursor.chars.data());
+        cursor.byte += n;
+        if (cursor.byte == key.size())
+            cursor.count += cursor.decoder.finish(cursor.chars.data() + cursor.count);
+        cursor.pos = 0;
+        return true;
+    }
+
+    /// Позиция перед буквой ключа номер letter (или конец ключа, если букв меньше)
+    Cursor seek(uint64_t letter)
+    {
+        Checkpoint from;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (hasParked && parkedLetter == letter) {
+                hasParked = false;
+                return std::move(parked);
+            }
+            while (checkpoints.back().letters <= letter && checkpoints.back().byte < key.size())
+                extend();
+            auto next = std::upper_bound(checkpoints.begin(), checkpoints.end(), letter,
+                                         [](uint64_t l, const Checkpoint& c) { return l < c.letters; });
+            from = *(next - 1);
+        }
+        Cursor cursor;
+        cursor.byte = from.byte;
+        uint64_t remaining = letter - from.letters;
+        while (remaining > 0 && (cursor.pos < cursor.count || refill(cursor)))
+            cursor.pos += cipher.skip(cursor.chars.data() + cursor.pos, cursor.count - cursor.pos, remaining);
+        return cursor;
+    }
+
+    /// Запоминает позицию после фрагмента для следующего фрагмента
+    void park(Cursor&& cursor, uint64_t letter)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        parked = std::move(cursor);
+        parkedLetter = letter;
+        hasParked = true;
+    }
+
+    /// Добавляет опорную точку через keyCheckpoint байт после последней (под lock)
+    void extend()
+    {
+        const Checkpoint& last = checkpoints.back();
+        std::size_t end = std::min(key.size(), last.byte + keyCheckpoint);
+        while (end < key.size() && (key.data()[end] & 0xC0) == 0x80)
+            end++;
+        Cursor cursor;
+        cursor.byte = last.byte;
+        uint64_t remaining = UINT64_MAX;
+        while (cursor.byte < end) {
+            std::size_t n = std::min(keyWindow, end - cursor.byte);
+            cursor.chars.resize(keyWindow + 1);
+            std::size_t count = cursor.decoder.decode(key.data() + cursor.byte, n, cursor.chars.data());
+            cursor.byte += n;
+            if (cursor.byte == end)
+                count += cursor.decoder.finish(cursor.chars.data() + count);
+            cipher.skip(cursor.chars.data(), count, remaining);
+        }
+        checkpoints.push_back({ end, last.letters + (UINT64_MAX - remaining) });
+    }
+
+    /// Преобразует текст, продвигая позицию ключа; возвращает длину результата
+    std::size_t run(Cursor& cursor, const wchar_t* text, std::size_t length, wchar_t* out) const
+    {
+        std::size_t read = 0, written = 0;
+        for (;;) {
+            const wchar_t* window = cursor.chars.data() + cursor.pos;
+            std::size_t available = cursor.count - cursor.pos;
+            runningKeyCipher::Step step = mode == Mode::Encrypt
+                ? cipher.encrypt(text + read, length - read, window, available, out + written)
+                : cipher.decrypt(text + read, length - read, window, available, out + written);
+            read += step.read;
+            cursor.pos += step.keyRead;
+            written += step.written;
+            if (read == length)
+                return written;
+            if (!refill(cursor))
+                throw cipher_error("Бегущий ключ короче текста");
+        }
+    }
+};
+
+} // namespace
+
+std::unique_ptr<Engine> makeGronsfeldEngine(const std::wstring& key, Mode mode)
+{
+    return std::unique_ptr<Engine>(new GronsfeldEngine(key, mode));
+}
+
+std::unique_ptr<Engine> makeRunningKeyEngine(const std::string& keyPath, uint64_t keyOffset, Mode mode)
+{
+    return std::unique_ptr<Engine>(new RunningKeyEngine(keyPath, keyOffset, mode));
+}
@@ -0,0 +1,96 @@
+/**
+ * @file histogram.h
+ * @brief Гистограмма задержек с логарифмическими интервалами
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Гистограмма значений от 0 до 2^64 - 1 с относительной точностью 1/16
+ * @details Значения меньше 16 хранятся точно, остальные попадают в один из
+ *          16 равных интервалов между соседними степенями двойки. Запись —
+ *          O(1) без выделения памяти; процентиль возвращает нижнюю границу
+ *          интервала. Не потокобезопасна.
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram() : counts(bucketCount, 0) {}
+
+    void record(uint64_t value)
+    {
+        counts[bucket(value)]++;
+        total++;
+        if (value > maxValue)
+            maxValue = value;
+    }
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return maxValue; }
+
+    /**
+     * @brief Значение, не превышаемое долей q записей
+     * @param[in] q Доля от 0 до 1 (0.5 — медиана, 0.999 — p999)
+     */
+    uint64_t percentile(double q) const
+    {
+        if (total == 0)
+            return 0;
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (unsigned i = 0; i < bucketCount; i++) {
+            seen += counts[i];
+            if (seen >= rank)
+                return lowerBound(i);
+        }
+        return maxValue;
+    }
+
+    /// Добавляет записи другой гистограммы
+    void merge(const LatencyHistogram& other)
+    {
+        for (unsigned i = 0; i < bucketCount; i++)
+            counts[i] += other.counts[i];
+        total += other.total;
+        if (other.maxValue > maxValue)
+            maxValue = other.maxValue;
+    }
+
+    void reset()
+    {
+        counts.assign(bucketCount, 0);
+        total = 0;
+        maxValue = 0;
+    }
+
+private:
+    static const unsigned subBits = 4;
+    static const unsigned bucketCount = (64 - subBits + 1) << subBits;
+
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    uint64_t maxValue = 0;
+
+    static unsigned bucket(uint64_t v)
+    {
+        if (v < (1u << subBits))
+            return static_cast<unsigned>(v);
+        unsigned exponent = 63 - __builtin_clzll(v);
+        unsigned sub = static_cast<unsigned>(v >> (exponent - subBits)) & ((1u << subBits) - 1);
+        return ((exponent - subBits + 1) << subBits) + sub;
+    }
+
+    static uint64_t lowerBound(unsigned index)
+    {
+        if (index < (1u << subBits))
+            return index;
+        unsigned exponent = (index >> subBits) + subBits - 1;
+        uint64_t sub = index & ((1u << subBits) - 1);
+        return (uint64_t(1) << exponent) | (sub << (exponent - subBits));
+    }
+};
@@ -0,0 +1,88 @@
+/**
+ * @file lines_mode.cpp
+ * @brief Режим --lines: каждая строка входа — отдельное сообщение
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "modes.h"
+#include "pipeline.h"
+#include <iostream>
+
+namespace {
+
+/// Фрагмент конвейера в режиме --lines: несколько целых строк
+struct LineBatch {
+    std::wstring text;      ///< Строки; последняя может не оканчиваться переводом строки
+    uint64_t firstLine = 0;
+    std::string out;        ///< Результат в UTF-8
+    std::vector<std::pair<uint64_t, std::string>> errors; ///< Номера строк с ошибками и тексты ошибок
+};
+
+} // namespace
+
+uint64_t processLines(Engine& engine, Input& in, Output& out, const Options& opts, Scheduler* scheduler)
+{
+    uint64_t nextLine = 1, errors = 0;
+    std::wstring pending;
+    bool more = true;
+    Pipeline<LineBatch> pipeline(opts.threads, pipelineDepth, opts.pin);
+    pipeline.run(
+        [&](LineBatch& batch) {
+            // Фрагмент заканчивается последним переводом строки; просматривается
+            // только дочитанная часть, остаток прошлого фрагмента строк не содержит
+            std::size_t nl = std::wstring::npos;
+            while (nl == std::wstring::npos && more) {
+                std::size_t old = pending.size();
+                more = in.read(pending, opts.chunk);
+                for (std::size_t i = pending.size(); i > old && nl == std::wstring::npos; i--) {
+                    if (pending[i - 1] == L'\n')
+                        nl = i - 1;
+                }
+            }
+            if (nl != std::wstring::npos) {
+                batch.text.assign(pending, 0, nl + 1);
+                pending.erase(0, nl + 1);
+            } else if (!pending.empty()) {
+                batch.text.swap(pending);
+                pending.clear();
+            } else {
+                return false;
+            }
+            batch.firstLine = nextLine;
+            nextLine += std::count(batch.text.begin(), batch.text.end(), L'\n') + (batch.text.back() != L'\n');
+            return true;
+        },
+        [&](LineBatch& batch) {
+            batch.out.clear();
+            batch.errors.clear();
+            uint64_t line = batch.firstLine;
+            for (std::size_t start = 0; start < batch.text.size(); line++) {
+                std::size_t nl = batch.text.find(L'\n', start);
+                std::size_t end = nl == std::wstring::npos ? batch.text.size() : nl;
+                std::wstring message = batch.text.substr(start, end - start);
+                if (!message.empty() && message.back() == L'\r')
+                    message.pop_back();
+                Result r = guarded([&] { return transformMessage(engine, message, scheduler, opts.chunk); });
+                if (!r.error.empty()) {
+                    batch.errors.emplace_back(line, r.error);
+                    if (!opts.keepGoing)
+                        return;
+                }
+                appendUtf8(batch.out, r.text);
+                if (nl != std::wstring::npos)
+                    batch.out += '\n';
+                start = end + 1;
+            }
+        },
+        [&](LineBatch& batch) {
+            for (auto& e : batch.errors)
+                std::cerr << "line " << e.first << ": " << e.second << std::endl;
+            errors += batch.errors.size();
+            out.writeEncoded(batch.out);
+            return opts.keepGoing || batch.errors.empty();
+        });
+    return errors;
+}
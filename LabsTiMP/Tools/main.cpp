@@ -0,0 +1,441 @@
+/**
+ * @file main.cpp
+ * @brief Неинтерактивная утилита шифрования для пакетной обработки
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Использование:
+ * @code
+ * cipher -c gronsfeld|route -k КЛЮЧ (-e|-d) [-i ВХОД] [-o ВЫХОД] [--route МАРШРУТ]
+ *        [--lines] [--keep-going] [--threads N] [--chunk РАЗМЕР] [--stats]
+ * cipher -c gronsfeld|route -k КЛЮЧ (-e|-d) --mmap -i ВХОД -o ВЫХОД [--stats]
+ * cipher -c gronsfeld|route -k КЛЮЧ (-e|-d) --uring [--queue-depth N] -i ВХОД -o ВЫХОД [--stats]
+ * cipher -c gronsfeld --running-key ФАЙЛ [--key-offset N] (-e|-d) ...
+ * cipher -c gronsfeld|route -k КЛЮЧ -d --range СМЕЩЕНИЕ:ДЛИНА -i ВХОД [-o ВЫХОД] [--stats]
+ * cipher -c gronsfeld|route -k КЛЮЧ -e --container [--layout] [-i ВХОД] [-o ВЫХОД] [--threads N] [--chunk РАЗМЕР]
+ * cipher -c gronsfeld|route -k КЛЮЧ -d --container [--chunks ПЕРВЫЙ:ЧИСЛО] -i ВХОД [-o ВЫХОД] [--threads N]
+ * cipher -c gronsfeld (-k КЛЮЧ | --running-key ФАЙЛ) -e (--append | --patch СМЕЩЕНИЕ) [-i ВХОД] -o ШИФРТЕКСТ
+ * cipher ... --threads N [--pin] [--first-touch] [--huge-pages off|transparent|explicit] [--compare] [--stats]
+ * @endcode
+ * Вход и выход — текст в UTF-8, по умолчанию стандартные потоки.
+ * --route задаёт маршруты маршрутной перестановки в виде «ЗАПИСЬ:СЧИТЫВАНИЕ»
+ * или «СЧИТЫВАНИЕ» (parseRouteSpec), по умолчанию rows:spiral.
+ * Вместо -k шифр Гронсфельда принимает --running-key ФАЙЛ: бегущий ключ
+ * из текста в UTF-8, который отображается в память и читается в ногу с
+ * сообщением; --key-offset N пропускает первые N букв ключа.
+ *
+ * По умолчанию весь вход — одно сообщение (завершающий перевод строки не
+ * входит в сообщение и переносится в выход). Шифр Гронсфельда обрабатывает
+ * такое сообщение фрагментами по --chunk символов, не загружая его в память
+ * целиком; маршрутная перестановка читает сообщение полностью.
+ * С --lines каждая строка — отдельное сообщение, как в интерактивных
+ * программах лабораторных работ; с --keep-going строка с ошибкой выводится
+ * пустой, а ошибка печатается в стандартный поток ошибок.
+ * Чтение, шифрование и запись выполняются конвейером в отдельных потоках;
+ * --threads задаёт количество потоков шифрования, порядок вывода сохраняется.
+ * При --threads больше 1 сообщения длиннее --chunk символов (маршрутная
+ * перестановка всего входа, длинные строки в --lines) делятся на задачи
+ * планировщика с перехватом работы, короткие шифруются целиком.
+ * --stats печатает объём и скорость обработки и загрузку потоков планировщика.
+ * С --mmap входной и выходной файлы отображаются в память: вход читается
+ * последовательно, выход заранее получает размер входа и усекается до
+ * размера результата, поэтому объём файла не ограничен оперативной памятью.
+ * С --uring файлы читаются и пишутся через io_uring: --queue-depth блоков
+ * чтения и записи находятся в полёте, пока шифруется очередной блок. Если
+ * io_uring недоступен, используется обычный конвейер на потоках.
+ * С --range СМЕЩЕНИЕ:ДЛИНА (только -d) входной файл отображается в память и
+ * выводятся буквы открытого текста с номерами СМЕЩЕНИЕ..СМЕЩЕНИЕ+ДЛИНА-1:
+ * читаются только нужные буквы шифртекста, поэтому страница огромного
+ * документа расшифровывается без расшифрования всего файла.
+ * С --container шифртекст записывается в контейнер (container.h) фрагментами
+ * по --chunk символов с индексом в конце файла; --layout сохраняет пробелы,
+ * знаки и регистр, и расшифрованный текст совпадает с исходным. Фрагменты
+ * контейнера расшифровываются параллельно (--threads), --chunks ПЕРВЫЙ:ЧИСЛО
+ * расшифровывает только указанные фрагменты, не читая остальные.
+ * --append дописывает шифртекст входа в конец существующего шифртекста
+ * шифра Гронсфельда, продолжая ключ с его последней буквы, а --patch
+ * СМЕЩЕНИЕ заменяет буквы с номерами СМЕЩЕНИЕ.. шифртекстом входа на месте.
+ * Остальная часть файла не читается и не перезаписывается.
+ * Размещение для многопроцессорных машин (placement.h): --pin закрепляет
+ * рабочие потоки конвейера и планировщика за ядрами; --first-touch
+ * распределяет части длинного сообщения между потоками планировщика
+ * статически, и каждый поток первым пишет свои части входа и выхода, так что
+ * они размещаются на его узле NUMA; --huge-pages transparent|explicit
+ * отображает эти буферы (и файлы --mmap) огромными страницами, explicit при
+ * нехватке зарезервированных страниц заменяется на transparent. --compare
+ * преобразует длинное сообщение маршрутной перестановки дважды, без
+ * размещения и с ним, и печатает время обоих проходов и ускорение.
+ * Режимы объявлены в modes.h и реализованы в отдельных файлах; здесь
+ * разбираются параметры командной строки и выбирается режим.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <locale>
+#include <string>
+#include <thread>
+#include <vector>
+#include "engine.h"
+#include "modes.h"
+#include "placement.h"
+#include "scheduler.h"
+#include "uring.h"
+#include "utf8.h"
+
+using namespace std;
+
+namespace {
+
+/// Декодирует аргумент командной строки из UTF-8
+wstring fromUtf8(const string& s)
+{
+    vector<wchar_t> buf(s.size() + 2);
+    utf8::Decoder d;
+    size_t n = d.decode(s.data(), s.size(), buf.data());
+    n += d.finish(buf.data() + n);
+    return wstring(buf.data(), n);
+}
+
+Options parseOptions(int argc, char** argv)
+{
+    Options opts;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if ((arg == "-c" || arg == "--cipher") && hasValue)
+            opts.cipher = argv[++i];
+        else if ((arg == "-k" || arg == "--key") && hasValue)
+            opts.key = fromUtf8(argv[++i]);
+        else if (arg == "-e" || arg == "--encrypt" || arg == "-d" || arg == "--decrypt") {
+            opts.mode = arg == "-e" || arg == "--encrypt" ? Mode::Encrypt : Mode::Decrypt;
+            opts.modeSet = true;
+        } else if ((arg == "-i" || arg == "--input") && hasValue)
+            opts.input = argv[++i];
+        else if ((arg == "-o" || arg == "--output") && hasValue)
+            opts.output = argv[++i];
+        else if (arg == "--lines")
+            opts.lines = true;
+        else if (arg == "--keep-going")
+            opts.keepGoing = true;
+        else if (arg == "--threads" && hasValue)
+            opts.threads = stoul(argv[++i]);
+        else if (arg == "--chunk" && hasValue)
+            opts.chunk = stoul(argv[++i]);
+        else if (arg == "--stats")
+            opts.stats = true;
+        else if (arg == "--mmap")
+            opts.mmap = true;
+        else if (arg == "--uring")
+            opts.uring = true;
+        else if (arg == "--queue-depth" && hasValue)
+            opts.queueDepth = stoul(argv[++i]);
+        else if (arg == "--route" && hasValue)
+            opts.route = argv[++i];
+        else if (arg == "--running-key" && hasValue)
+            opts.runningKey = argv[++i];
+        else if (arg == "--key-offset" && hasValue)
+            opts.keyOffset = stoull(argv[++i]);
+        else if (arg == "--range" && hasValue)
+            opts.range = argv[++i];
+        else if (arg == "--container")
+            opts.container = true;
+        else if (arg == "--layout")
+            opts.layout = true;
+        else if (arg == "--chunks" && hasValue)
+            opts.chunks = argv[++i];
+        else if (arg == "--append")
+            opts.append = true;
+        else if (arg == "--patch" && hasValue)
+            opts.patch = argv[++i];
+        else if (arg == "--pin")
+            opts.pin = true;
+        else if (arg == "--first-touch")
+            opts.firstTouch = true;
+        else if (arg == "--huge-pages" && hasValue)
+            opts.hugePages = parseHugePages(argv[++i]);
+        else if (arg == "--compare")
+            opts.compare = true;
+        else
+            throw invalid_argument("unknown option: " + arg);
+    }
+    if (opts.cipher != "gronsfeld" && opts.cipher != "route")
+        throw invalid_argument("cipher must be gronsfeld or route");
+    if (!opts.runningKey.empty() && opts.cipher != "gronsfeld")
+        throw invalid_argument("--running-key requires the gronsfeld cipher");
+    if (!opts.runningKey.empty() && !opts.key.empty())
+        throw invalid_argument("--key and --running-key are mutually exclusive");
+    if (opts.keyOffset && opts.runningKey.empty())
+        throw invalid_argument("--key-offset requires --running-key");
+    if (opts.key.empty() && opts.runningKey.empty())
+        throw invalid_argument("key is required");
+    if (!opts.modeSet)
+        throw invalid_argument("one of --encrypt or --decrypt is required");
+    if (opts.threads == 0)
+        opts.threads = thread::hardware_concurrency() ? thread::hardware_concurrency() : 1;
+    if (opts.chunk == 0)
+        throw invalid_argument("chunk size must be positive");
+    if (opts.mmap && (opts.input.empty() || opts.output.empty()))
+        throw invalid_argument("--mmap requires --input and --output files");
+    if (opts.mmap && opts.lines)
+        throw invalid_argument("--mmap cannot be combined with --lines");
+    if (opts.uring && (opts.input.empty() || opts.output.empty()))
+        throw invalid_argument("--uring requires --input and --output files");
+    if (opts.uring && (opts.lines || opts.mmap))
+        throw invalid_argument("--uring cannot be combined with --lines or --mmap");
+    if (opts.queueDepth == 0 || opts.queueDepth > 1024)
+        throw invalid_argument("queue depth must be between 1 and 1024");
+    if (!opts.route.empty() && opts.cipher != "route")
+        throw invalid_argument("--route requires the route cipher");
+    if (!opts.range.empty()) {
+        size_t colon = opts.range.find(':'), pos = 0;
+        if (colon == string::npos)
+            throw invalid_argument("--range must be OFFSET:LENGTH");
+        opts.rangeOffset = stoull(opts.range.substr(0, colon), &pos);
+        opts.rangeLength = stoull(opts.range.substr(colon + 1));
+        if (pos != colon)
+            throw invalid_argument("--range must be OFFSET:LENGTH");
+        if (opts.mode != Mode::Decrypt)
+            throw invalid_argument("--range requires --decrypt");
+        if (opts.input.empty())
+            throw invalid_argument("--range requires an --input file");
+        if (opts.lines || opts.mmap || opts.uring)
+            throw invalid_argument("--range cannot be combined with --lines, --mmap or --uring");
+    }
+    if (opts.container) {
+        if (opts.lines || opts.mmap || opts.uring || !opts.range.empty())
+            throw invalid_argument("--container cannot be combined with --lines, --mmap, --uring or --range");
+        if (opts.mode == Mode::Decrypt && opts.input.empty())
+            throw invalid_argument("--container --decrypt requires an --input file");
+        if (opts.chunk > (1u << 30))
+            throw invalid_argument("container chunk size must not exceed 1073741824");
+    }
+    if (opts.layout && !(opts.container && opts.mode == Mode::Encrypt))
+        throw invalid_argument("--layout requires --container --encrypt");
+    if (opts.append || !opts.patch.empty()) {
+        if (opts.append && !opts.patch.empty())
+            throw invalid_argument("--append and --patch are mutually exclusive");
+        if (opts.cipher != "gronsfeld")
+            throw invalid_argument("--append and --patch require the gronsfeld cipher");
+        if (opts.mode != Mode::Encrypt)
+            throw invalid_argument("--append and --patch require --encrypt");
+        if (opts.output.empty())
+            throw invalid_argument("--append and --patch require an --output file");
+        if (opts.lines || opts.mmap || opts.uring || opts.container)
+            throw invalid_argument("--append and --patch cannot be combined with --lines, --mmap, --uring or --container");
+        if (!opts.patch.empty()) {
+            size_t pos = 0;
+            opts.patchOffset = stoull(opts.patch, &pos);
+            if (pos != opts.patch.size())
+                throw invalid_argument("--patch must be a letter offset");
+        }
+    }
+    if (!opts.chunks.empty()) {
+        if (!opts.container || opts.mode != Mode::Decrypt)
+            throw invalid_argument("--chunks requires --container --decrypt");
+        size_t colon = opts.chunks.find(':'), pos = 0;
+        if (colon == string::npos)
+            throw invalid_argument("--chunks must be FIRST:COUNT");
+        opts.chunkFirst = stoull(opts.chunks.substr(0, colon), &pos);
+        opts.chunkCount = stoull(opts.chunks.substr(colon + 1));
+        if (pos != colon)
+            throw invalid_argument("--chunks must be FIRST:COUNT");
+    }
+    if (opts.firstTouch && opts.threads < 2)
+        throw invalid_argument("--first-touch requires --threads greater than 1");
+    if (opts.hugePages != HugePages::None && opts.threads < 2 && !opts.mmap)
+        throw invalid_argument("--huge-pages requires --threads greater than 1 or --mmap");
+    if (opts.compare) {
+        if (opts.threads < 2 || !(opts.pin || opts.firstTouch || opts.hugePages != HugePages::None))
+            throw invalid_argument("--compare requires --threads greater than 1 and --pin, --first-touch or --huge-pages");
+        if (opts.cipher != "route" || opts.lines || opts.mmap || opts.uring || opts.container || !opts.range.empty())
+            throw invalid_argument("--compare requires the route cipher without --lines, --mmap, --uring, --container or --range");
+    }
+    return opts;
+}
+
+/// Печатает объём и скорость обработки (--stats)
+void printStats(uint64_t bytesIn, uint64_t bytesOut, double seconds, unsigned threads)
+{
+    double s = max(seconds, 1e-9);
+    fprintf(stderr, "read %llu bytes, wrote %llu bytes in %.3f s: %.1f MB/s in, %.1f MB/s out, %u thread(s)\n",
+            static_cast<unsigned long long>(bytesIn), static_cast<unsigned long long>(bytesOut), s,
+            bytesIn / s / 1e6, bytesOut / s / 1e6, threads);
+}
+
+/// Печатает загрузку потоков планировщика (--stats)
+void printSchedulerStats(const Scheduler& scheduler)
+{
+    vector<WorkerStats> stats = scheduler.stats();
+    for (size_t i = 0; i < stats.size(); i++) {
+        fprintf(stderr, "worker %zu: %llu task(s), %llu stolen, busy %.3f s, utilization %.1f%%", i,
+                static_cast<unsigned long long>(stats[i].tasks), static_cast<unsigned long long>(stats[i].steals),
+                stats[i].busySeconds, 100 * stats[i].utilization());
+        if (stats[i].cpu >= 0)
+            fprintf(stderr, ", cpu %d, node %d", stats[i].cpu, stats[i].node);
+        fputc('\n', stderr);
+    }
+}
+
+void init_locale()
+{
+    try {
+        locale::global(locale("ru_RU.UTF-8"));
+    } catch (const exception& e) {
+        cerr << "Ошибка установки локали: " << e.what() << endl;
+        locale::global(locale(""));
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Главная функция программы
+ * @return 0 при успешной обработке, 1 при ошибке параметров, шифра или ввода-вывода
+ */
+int main(int argc, char** argv)
+{
+    init_locale();
+
+    Options opts;
+    unique_ptr<Engine> engine;
+    try {
+        opts = parseOptions(argc, argv);
+        if (opts.cipher == "gronsfeld" && !opts.runningKey.empty()) {
+            engine = makeRunningKeyEngine(opts.runningKey, opts.keyOffset, opts.mode);
+        } else if (opts.cipher == "gronsfeld") {
+            engine = makeGronsfeldEngine(opts.key, opts.mode);
+        } else {
+            size_t pos = 0;
+            string key(opts.key.begin(), opts.key.end());
+            long long columns = stoll(key, &pos);
+            if (pos != key.size())
+                throw invalid_argument("route key must be a number of columns");
+            engine = makeRouteEngine(columns, opts.mode, routeSpec(opts));
+        }
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        cerr << "Usage: " << argv[0] << " -c gronsfeld|route (-k KEY | --running-key FILE [--key-offset N])"
+             << " (-e|-d) [-i IN] [-o OUT] [--route ROUTE]"
+             << " [--lines] [--keep-going] [--threads N] [--chunk SIZE] [--stats] [--mmap]"
+             << " [--uring] [--queue-depth N] [--range OFFSET:LENGTH]"
+             << " [--container [--layout] [--chunks FIRST:COUNT]] [--append | --patch OFFSET]"
+             << " [--pin] [--first-touch] [--huge-pages off|transparent|explicit] [--compare]" << endl;
+        return 1;
+    }
+
+    if (!opts.range.empty()) {
+        uint64_t bytesIn = 0, bytesOut = 0;
+        auto start = chrono::steady_clock::now();
+        uint64_t errors = processRange(*engine, opts, bytesIn, bytesOut);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        if (opts.stats)
+            printStats(bytesIn, bytesOut, elapsed.count(), 1);
+        return errors ? 1 : 0;
+    }
+
+    if (opts.container && opts.mode == Mode::Decrypt) {
+        unique_ptr<Scheduler> scheduler;
+        if (opts.threads > 1)
+            scheduler.reset(new Scheduler(opts.threads, placementOf(opts)));
+        uint64_t bytesIn = 0, bytesOut = 0;
+        auto start = chrono::steady_clock::now();
+        uint64_t errors = processContainerDecrypt(*engine, opts, scheduler.get(), bytesIn, bytesOut);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        if (opts.stats) {
+            printStats(bytesIn, bytesOut, elapsed.count(), opts.threads);
+            if (scheduler)
+                printSchedulerStats(*scheduler);
+        }
+        return errors ? 1 : 0;
+    }
+
+    if (opts.mmap) {
+        uint64_t bytesIn = 0, bytesOut = 0;
+        auto start = chrono::steady_clock::now();
+        uint64_t errors = processMapped(*engine, opts, bytesIn, bytesOut);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        if (opts.stats)
+            printStats(bytesIn, bytesOut, elapsed.count(), 1);
+        return errors ? 1 : 0;
+    }
+
+    if (opts.uring && !Uring::available()) {
+        if (opts.stats)
+            cerr << "io_uring is unavailable, using threads" << endl;
+        opts.uring = false;
+    }
+    if (opts.uring) {
+        UringStats stats;
+        auto start = chrono::steady_clock::now();
+        uint64_t errors = processUring(*engine, opts, stats);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        if (opts.stats) {
+            fprintf(stderr, "io_uring: queue depth %u, up to %u operations in flight, %s buffers\n", stats.depth,
+                    stats.maxInFlight, stats.registered ? "registered" : "unregistered");
+            printStats(stats.bytesRead, stats.bytesWritten, elapsed.count(), 1);
+        }
+        return errors ? 1 : 0;
+    }
+
+    FILE* inFile = opts.input.empty() ? stdin : fopen(opts.input.c_str(), "rb");
+    if (!inFile) {
+        cerr << "Error: cannot open " << opts.input << ": " << strerror(errno) << endl;
+        return 1;
+    }
+    if (opts.append || !opts.patch.empty()) {
+        Input in(inFile);
+        uint64_t bytesOut = 0;
+        auto start = chrono::steady_clock::now();
+        uint64_t errors = processUpdate(*engine, in, opts, bytesOut);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        if (opts.stats)
+            printStats(in.bytesRead(), bytesOut, elapsed.count(), 1);
+        if (inFile != stdin)
+            fclose(inFile);
+        return errors ? 1 : 0;
+    }
+    FILE* outFile = opts.output.empty() ? stdout : fopen(opts.output.c_str(), "wb");
+    if (!outFile) {
+        cerr << "Error: cannot open " << opts.output << ": " << strerror(errno) << endl;
+        return 1;
+    }
+
+    Input in(inFile);
+    Output out(outFile);
+    unique_ptr<Scheduler> scheduler;
+    if (opts.threads > 1)
+        scheduler.reset(new Scheduler(opts.threads, placementOf(opts)));
+    auto start = chrono::steady_clock::now();
+    uint64_t errors, containerBytes = 0;
+    if (opts.container)
+        errors = processContainerEncrypt(*engine, in, outFile, opts, containerBytes);
+    else if (opts.lines)
+        errors = processLines(*engine, in, out, opts, scheduler.get());
+    else if (engine->chunked())
+        errors = processChunked(*engine, in, out, opts);
+    else
+        errors = processWhole(*engine, in, out, opts, scheduler.get());
+    if (!out.flush()) {
+        cerr << "Error: write failed" << endl;
+        errors++;
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    if (opts.stats) {
+        printStats(in.bytesRead(), out.bytesWritten() + containerBytes, elapsed.count(), opts.threads);
+        if (scheduler)
+            printSchedulerStats(*scheduler);
+    }
+    if (inFile != stdin)
+        fclose(inFile);
+    if (outFile != stdout)
+        fclose(outFile);
+    return errors ? 1 : 0;
+}
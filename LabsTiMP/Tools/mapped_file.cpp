@@ -0,0 +1,139 @@
+/**
+ * @file mapped_file.cpp
+ * @brief Файл реализации отображения файлов в память
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "mapped_file.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+[[noreturn]] void fail(const std::string& what, const std::string& path)
+{
+    throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+MappedFile MappedFile::openRead(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        fail("cannot open", path);
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        fail("cannot stat", path);
+    }
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+    char* p = nullptr;
+    if (size > 0) {
+        void* m = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (m == MAP_FAILED) {
+            ::close(fd);
+            fail("cannot map", path);
+        }
+        p = static_cast<char*>(m);
+    }
+    return MappedFile(fd, p, size);
+}
+
+MappedFile MappedFile::create(const std::string& path, std::size_t size)
+{
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        fail("cannot create", path);
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        fail("cannot resize", path);
+    }
+    char* p = nullptr;
+    if (size > 0) {
+        void* m = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (m == MAP_FAILED) {
+            ::close(fd);
+            fail("cannot map", path);
+        }
+        p = static_cast<char*>(m);
+    }
+    return MappedFile(fd, p, size);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept : fd(other.fd), ptr(other.ptr), length(other.length)
+{
+    other.fd = -1;
+    other.ptr = nullptr;
+    other.length = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        fd = other.fd;
+        ptr = other.ptr;
+        length = other.length;
+        other.fd = -1;
+        other.ptr = nullptr;
+        other.length = 0;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    release();
+}
+
+void MappedFile::adviseSequential() const
+{
+    if (ptr)
+        madvise(ptr, length, MADV_SEQUENTIAL);
+}
+
+void MappedFile::adviseRandom() const
+{
+    if (ptr)
+        madvise(ptr, length, MADV_RANDOM);
+}
+
+HugePages MappedFile::adviseHugePages(HugePages pages) const
+{
+    return ::adviseHugePages(ptr, length, pages);
+}
+
+void MappedFile::close(std::size_t size)
+{
+    if (ptr)
+        munmap(ptr, length);
+    ptr = nullptr;
+    length = 0;
+    if (fd >= 0) {
+        int rc = ftruncate(fd, static_cast<off_t>(size));
+        int closed = ::close(fd);
+        fd = -1;
+        if (rc != 0 || closed != 0)
+            throw std::runtime_error(std::string("cannot finish output file: ") + std::strerror(errno));
+    }
+}
+
+void MappedFile::release()
+{
+    if (ptr)
+        munmap(ptr, length);
+    if (fd >= 0)
+        ::close(fd);
+    ptr = nullptr;
+    fd = -1;
+    length = 0;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file mapped_file.h
+ * @brief Файлы, отображённые в память (mmap)
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Отображение позволяет шифровать файлы без копирования их в std::wstring и
+ * без ограничения объёмом оперативной памяти: страницы подгружаются и
+ * вытесняются страничным кэшем ядра.
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include "placement.h"
+
+/**
+ * @brief Файл, отображённый в память
+ * @details Владеет дескриптором и отображением; только перемещается.
+ *          Ошибки системных вызовов сообщаются исключением std::runtime_error.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Отображает существующий файл для чтения
+     * @param[in] path Путь к файлу
+     */
+    static MappedFile openRead(const std::string& path);
+    /**
+     * @brief Создаёт (или перезаписывает) файл заданного размера и отображает его для записи
+     * @param[in] path Путь к файлу
+     * @param[in] size Размер файла, байт (верхняя оценка результата)
+     */
+    static MappedFile create(const std::string& path, std::size_t size);
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    char* data() const { return ptr; }
+    std::size_t size() const { return length; }
+
+    /// Подсказка ядру о последовательном доступе (агрессивное упреждающее чтение)
+    void adviseSequential() const;
+    /// Подсказка ядру о произвольном доступе (без упреждающего чтения)
+    void adviseRandom() const;
+    /**
+     * @brief Подсказка ядру отображать файл огромными страницами
+     * @return Фактический режим (см. ::adviseHugePages)
+     */
+    HugePages adviseHugePages(HugePages pages) const;
+    /**
+     * @brief Снимает отображение и устанавливает окончательный размер файла
+     * @param[in] size Фактический размер результата, не больше size()
+     */
+    void close(std::size_t size);
+
+private:
+    MappedFile(int fd, char* ptr, std::size_t length) : fd(fd), ptr(ptr), length(length) {}
+    void release();
+
+    int fd = -1;
+    char* ptr = nullptr;
+    std::size_t length = 0;
+};
@@ -0,0 +1,56 @@
+/**
+ * @file mapped_mode.cpp
+ * @brief Режим --mmap: преобразование входного файла, отображённого в память
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "modes.h"
+#include "mapped_file.h"
+#include <iostream>
+
+uint64_t processMapped(Engine& engine, const Options& opts, uint64_t& bytesIn, uint64_t& bytesOut)
+{
+    try {
+        MappedFile in = MappedFile::openRead(opts.input);
+        in.adviseSequential();
+        MappedFile out = MappedFile::create(opts.output, in.size());
+        out.adviseSequential();
+        if (opts.hugePages != HugePages::None) {
+            HugePages pages = in.adviseHugePages(opts.hugePages);
+            out.adviseHugePages(opts.hugePages);
+            if (opts.stats)
+                fprintf(stderr, "huge pages: %s requested, %s advised for the mapped files\n",
+                        hugePagesName(opts.hugePages), hugePagesName(pages));
+        }
+
+        // Завершающий перевод строки не входит в сообщение, как и в потоковом режиме
+        std::size_t size = in.size();
+        bool newline = size > 0 && in.data()[size - 1] == '\n';
+        if (newline) {
+            size--;
+            if (size > 0 && in.data()[size - 1] == '\r')
+                size--;
+        }
+        bytesIn = in.size();
+        Result r = guarded([&] {
+            std::size_t n = engine.transformMapped(in.data(), size, out.data());
+            if (newline)
+                out.data()[n++] = '\n';
+            bytesOut = n;
+            return std::wstring();
+        });
+        if (!r.error.empty()) {
+            out.close(0);
+            std::cerr << "Error: " << r.error << std::endl;
+            return 1;
+        }
+        out.close(bytesOut);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file modes.cpp
+ * @brief Вспомогательные функции, общие для режимов утилиты cipher
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "modes.h"
+#include "scheduler.h"
+
+void appendUtf8(std::string& out, const std::wstring& s)
+{
+    std::size_t old = out.size();
+    out.resize(old + 4 * s.size());
+    out.resize(old + utf8::encode(s.data(), s.size(), &out[old]));
+}
+
+bool stripNewline(std::wstring& s)
+{
+    if (s.empty() || s.back() != L'\n')
+        return false;
+    s.pop_back();
+    if (!s.empty() && s.back() == L'\r')
+        s.pop_back();
+    return true;
+}
+
+std::wstring transformMessage(Engine& engine, const std::wstring& message, Scheduler* scheduler, std::size_t grain)
+{
+    if (scheduler && message.size() > grain)
+        return engine.transformTasks(message, *scheduler, grain);
+    return engine.transform(message);
+}
+
+Placement placementOf(const Options& opts)
+{
+    Placement placement;
+    placement.pin = opts.pin;
+    placement.firstTouch = opts.firstTouch;
+    placement.hugePages = opts.hugePages;
+    return placement;
+}
+
+RouteSpec routeSpec(const Options& opts)
+{
+    return opts.route.empty() ? RouteSpec() : parseRouteSpec(opts.route);
+}
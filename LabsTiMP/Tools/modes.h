@@ -0,0 +1,300 @@
+/**
+ * @file modes.h
+ * @brief Режимы обработки утилиты cipher, их параметры и буферизованный ввод-вывод
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Каждый режим реализован в своём файле: lines_mode.cpp (--lines),
+ * chunked_mode.cpp и whole_mode.cpp (весь вход — одно сообщение, по частям
+ * или целиком), mapped_mode.cpp (--mmap), range_mode.cpp (--range),
+ * container_mode.cpp (--container), update_mode.cpp (--append и --patch),
+ * uring_mode.cpp (--uring); общие вспомогательные функции — в modes.cpp.
+ * Разбор командной строки и выбор режима остаются в main.cpp. Режимы
+ * печатают ошибки в стандартный поток ошибок и возвращают их количество.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+#include "engine.h"
+#include "placement.h"
+#include "utf8.h"
+
+class Scheduler;
+struct UringStats;
+
+/// Размер блока чтения и записи, байт
+const std::size_t ioBlock = 1 << 20;
+/// Ёмкость очереди каждого потока шифрования, фрагментов
+const std::size_t pipelineDepth = 2;
+
+/// Параметры командной строки
+struct Options {
+    std::string cipher;
+    std::wstring key;
+    Mode mode = Mode::Encrypt;
+    bool modeSet = false;
+    std::string input, output;
+    bool lines = false;
+    bool keepGoing = false;
+    unsigned threads = 1;
+    std::size_t chunk = 1 << 20;
+    bool stats = false;
+    bool mmap = false;
+    bool uring = false;
+    unsigned queueDepth = 8;
+    std::string route;
+    std::string runningKey;
+    uint64_t keyOffset = 0;
+    std::string range;
+    uint64_t rangeOffset = 0, rangeLength = 0;
+    bool container = false;
+    bool layout = false;
+    std::string chunks;
+    uint64_t chunkFirst = 0, chunkCount = UINT64_MAX;
+    bool append = false;
+    std::string patch;
+    uint64_t patchOffset = 0;
+    bool pin = false;
+    bool firstTouch = false;
+    HugePages hugePages = HugePages::None;
+    bool compare = false;
+};
+
+/**
+ * @brief Буферизованный ввод UTF-8 из файла
+ */
+class Input {
+public:
+    explicit Input(FILE* f) : file(f), bytes(ioBlock), chars(ioBlock + 1) {}
+
+    /**
+     * @brief Дописывает к строке до count декодированных символов
+     * @return false, если вход исчерпан и ничего не прочитано
+     */
+    bool read(std::wstring& out, std::size_t count)
+    {
+        std::size_t start = out.size();
+        while (out.size() - start < count && !eof) {
+            if (pos == available) {
+                std::size_t n = fread(bytes.data(), 1, bytes.size(), file);
+                total += n;
+                available = n ? decoder.decode(bytes.data(), n, chars.data()) : decoder.finish(chars.data());
+                pos = 0;
+                if (n == 0 && available == 0) {
+                    eof = true;
+                    break;
+                }
+            }
+            std::size_t take = std::min(available - pos, count - (out.size() - start));
+            out.append(chars.data() + pos, take);
+            pos += take;
+        }
+        return out.size() > start;
+    }
+
+    /// Вход исчерпан
+    bool done() { return eof || (pos == available && peekEof()); }
+    /// Прочитано байт
+    uint64_t bytesRead() const { return total; }
+
+private:
+    FILE* file;
+    std::vector<char> bytes;
+    std::vector<wchar_t> chars;
+    utf8::Decoder decoder;
+    std::size_t pos = 0, available = 0;
+    uint64_t total = 0;
+    bool eof = false;
+
+    bool peekEof()
+    {
+        int c = fgetc(file);
+        if (c == EOF)
+            return true;
+        ungetc(c, file);
+        return false;
+    }
+};
+
+/**
+ * @brief Буферизованный вывод UTF-8 в файл
+ */
+class Output {
+public:
+    explicit Output(FILE* f) : file(f) { buffer.reserve(2 * ioBlock); }
+
+    void write(const std::wstring& s) { write(s.data(), s.size()); }
+
+    void write(const wchar_t* s, std::size_t size)
+    {
+        for (std::size_t i = 0; i < size; i += ioBlock / 4) {
+            std::size_t n = std::min(size - i, ioBlock / 4);
+            std::size_t old = buffer.size();
+            buffer.resize(old + 4 * n);
+            buffer.resize(old + utf8::encode(s + i, n, &buffer[old]));
+            if (buffer.size() >= ioBlock)
+                flush();
+        }
+    }
+
+    /// Выводит байты, уже закодированные в UTF-8
+    void writeEncoded(const std::string& bytes)
+    {
+        if (buffer.size() + bytes.size() > ioBlock)
+            flush();
+        if (bytes.size() >= ioBlock) {
+            if (fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size())
+                failed = true;
+            total += bytes.size();
+        } else {
+            buffer += bytes;
+        }
+    }
+
+    void put(wchar_t c) { write(std::wstring(1, c)); }
+
+    bool flush()
+    {
+        if (!buffer.empty() && fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size())
+            failed = true;
+        total += buffer.size();
+        buffer.clear();
+        return fflush(file) == 0 && !failed;
+    }
+
+    /// Записано байт
+    uint64_t bytesWritten() const { return total; }
+
+private:
+    FILE* file;
+    std::string buffer;
+    uint64_t total = 0;
+    bool failed = false;
+};
+
+/// Результат обработки одного сообщения или фрагмента
+struct Result {
+    std::wstring text;
+    std::string error; ///< Пусто, если ошибки не было
+};
+
+template <class F>
+Result guarded(F f)
+{
+    Result r;
+    try {
+        r.text = f();
+    } catch (const std::exception& e) {
+        r.error = e.what();
+    }
+    return r;
+}
+
+/// Закрывает файловый дескриптор при выходе из области видимости
+struct FileDescriptor {
+    int fd;
+    explicit FileDescriptor(int fd) : fd(fd) {}
+    ~FileDescriptor()
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+};
+
+/// Дописывает строку к буферу в UTF-8
+void appendUtf8(std::string& out, const std::wstring& s);
+
+/// Отрезает завершающий перевод строки; возвращает true, если он был
+bool stripNewline(std::wstring& s);
+
+/// Преобразует сообщение; длинное — задачами планировщика, если он есть
+std::wstring transformMessage(Engine& engine, const std::wstring& message, Scheduler* scheduler, std::size_t grain);
+
+/// Размещение рабочих потоков и буферов по параметрам командной строки
+Placement placementOf(const Options& opts);
+
+/// Маршруты из параметров командной строки
+RouteSpec routeSpec(const Options& opts);
+
+/**
+ * @brief Режим --lines: каждая строка — отдельное сообщение
+ * @return Количество строк с ошибками
+ */
+uint64_t processLines(Engine& engine, Input& in, Output& out, const Options& opts, Scheduler* scheduler);
+
+/**
+ * @brief Весь вход — одно сообщение, обрабатываемое фрагментами
+ * @return 0 при успехе, 1 при ошибке
+ */
+uint64_t processChunked(Engine& engine, Input& in, Output& out, const Options& opts);
+
+/**
+ * @brief Весь вход — одно сообщение, обрабатываемое целиком
+ * @details Длинное сообщение при --threads больше 1 преобразуется задачами
+ *          планировщика с размещением буферов (--first-touch, --huge-pages),
+ *          с --compare — сначала и без размещения.
+ * @return 0 при успехе, 1 при ошибке
+ */
+uint64_t processWhole(Engine& engine, Input& in, Output& out, const Options& opts, Scheduler* scheduler);
+
+/**
+ * @brief Режим --mmap: весь входной файл — одно сообщение, отображённое в память
+ * @param[out] bytesIn Прочитано байт
+ * @param[out] bytesOut Записано байт
+ * @return 0 при успехе, 1 при ошибке
+ */
+uint64_t processMapped(Engine& engine, const Options& opts, uint64_t& bytesIn, uint64_t& bytesOut);
+
+/**
+ * @brief Режим --range: часть расшифрованного сообщения из отображённого шифртекста
+ * @param[out] bytesIn Длина шифртекста, байт
+ * @param[out] bytesOut Записано байт
+ * @return 0 при успехе, 1 при ошибке
+ */
+uint64_t processRange(Engine& engine, const Options& opts, uint64_t& bytesIn, uint64_t& bytesOut);
+
+/**
+ * @brief Режим --container -e: сообщение записывается в контейнер фрагментами
+ * @details Фрагменты шифра Гронсфельда продолжают ключ сообщения, фрагменты
+ *          маршрутной перестановки шифруются как отдельные сообщения.
+ * @param[out] bytesOut Записано байт
+ * @return 0 при успехе, 1 при ошибке
+ */
+uint64_t processContainerEncrypt(Engine& engine, Input& in, FILE* file, const Options& opts, uint64_t& bytesOut);
+
+/**
+ * @brief Режим --container -d: фрагменты контейнера расшифровываются параллельно
+ * @param[out] bytesIn Прочитано байт фрагментов
+ * @param[out] bytesOut Записано байт
+ * @return 0 при успехе, 1 при ошибке
+ */
+uint64_t processContainerDecrypt(Engine& engine, const Options& opts, Scheduler* scheduler, uint64_t& bytesIn,
+                                 uint64_t& bytesOut);
+
+/**
+ * @brief Режимы --append и --patch: изменение существующего шифртекста на месте
+ * @details Шифртекст состоит из двухбайтовых букв, поэтому количество букв
+ *          и положение буквы в файле известны без чтения файла; читается
+ *          только хвост для поиска перевода строки. Вход шифруется
+ *          фрагментами с продолжением ключа (Engine::transformChunk).
+ * @param[out] bytesOut Записано байт
+ * @return 0 при успехе, 1 при ошибке
+ */
+uint64_t processUpdate(Engine& engine, Input& in, const Options& opts, uint64_t& bytesOut);
+
+/**
+ * @brief Режим --uring: весь входной файл — одно сообщение, ввод-вывод через io_uring
+ * @param[out] stats Глубина очереди и объём ввода-вывода
+ * @return 0 при успехе, 1 при ошибке
+ */
+uint64_t processUring(Engine& engine, const Options& opts, UringStats& stats);
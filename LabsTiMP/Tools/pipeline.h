@@ -0,0 +1,161 @@
+/**
+ * @file pipeline.h
+ * @brief Конвейер «чтение — шифрование — запись» на кольцевых буферах
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Поток чтения заполняет фрагменты, рабочие потоки шифруют их, поток записи
+ * выводит результаты. Стадии связаны очередями SpscRing, поэтому ввод-вывод
+ * и вычисления идут одновременно.
+ */
+
+#pragma once
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "placement.h"
+#include "spsc_ring.h"
+
+/**
+ * @brief Конвейер из потока чтения, рабочих потоков и потока записи
+ * @details Фрагменты (Item) выделяются один раз и переиспользуются: поток
+ *          записи возвращает обработанный фрагмент потоку чтения по отдельной
+ *          очереди. Поток чтения раздаёт фрагменты рабочим по кругу, поток
+ *          записи забирает их в том же порядке, поэтому порядок вывода
+ *          совпадает с порядком ввода, а каждая очередь имеет ровно одного
+ *          писателя и одного читателя.
+ * @tparam Item Фрагмент с буферами ввода и вывода
+ */
+template <class Item>
+class Pipeline {
+public:
+    /**
+     * @param[in] workers Количество рабочих потоков (не меньше 1)
+     * @param[in] depth Ёмкость очереди каждого рабочего потока, фрагментов
+     * @param[in] pin Закрепить рабочий поток номер w за ядром allowedCpus()[w % число ядер]
+     */
+    Pipeline(unsigned workers, std::size_t depth, bool pin = false)
+        : workers(workers ? workers : 1), depth(depth ? depth : 1), pin(pin)
+    {
+    }
+
+    /**
+     * @brief Обрабатывает весь поток фрагментов
+     * @param[in] produce bool(Item&) — заполняет фрагмент; false, если ввод исчерпан
+     *                    (поток чтения)
+     * @param[in] work void(Item&) — преобразует фрагмент (рабочие потоки)
+     * @param[in] consume bool(Item&) — выводит фрагмент; false останавливает конвейер,
+     *                    оставшиеся фрагменты отбрасываются (поток записи)
+     * @throw Первое исключение, выброшенное любой из стадий
+     */
+    template <class Produce, class Work, class Consume>
+    void run(Produce produce, Work work, Consume consume)
+    {
+        const std::size_t poolSize = 2 * workers * depth + workers;
+        std::vector<std::unique_ptr<Item>> pool;
+        SpscRing<Item*> free(poolSize);
+        for (std::size_t i = 0; i < poolSize; i++) {
+            pool.emplace_back(new Item());
+            free.push(pool.back().get());
+        }
+        std::vector<std::unique_ptr<SpscRing<Item*>>> toWorker, fromWorker;
+        for (unsigned i = 0; i < workers; i++) {
+            toWorker.emplace_back(new SpscRing<Item*>(depth));
+            fromWorker.emplace_back(new SpscRing<Item*>(depth + 1));
+        }
+        std::atomic<bool> stop(false);
+        std::exception_ptr errors[2];
+
+        // Поток чтения; nullptr в очереди рабочего означает конец ввода
+        std::thread reader([&] {
+            try {
+                for (std::size_t n = 0; !stop.load(std::memory_order_relaxed); n++) {
+                    Item* item = free.pop();
+                    if (!produce(*item))
+                        break;
+                    toWorker[n % workers]->push(item);
+                }
+            } catch (...) {
+                errors[0] = std::current_exception();
+                stop = true;
+            }
+            for (auto& ring : toWorker)
+                ring->push(nullptr);
+        });
+
+        std::vector<std::thread> workerThreads;
+        std::vector<std::exception_ptr> workErrors(workers);
+        std::vector<unsigned> cpus;
+        if (pin)
+            cpus = allowedCpus();
+        for (unsigned w = 0; w < workers; w++) {
+            workerThreads.emplace_back([&, w] {
+                if (!cpus.empty())
+                    pinThread(cpus[w % cpus.size()]);
+                for (;;) {
+                    Item* item = toWorker[w]->pop();
+                    if (item && !stop.load(std::memory_order_relaxed)) {
+                        try {
+                            work(*item);
+                        } catch (...) {
+                            workErrors[w] = std::current_exception();
+                            stop = true;
+                        }
+                    }
+                    fromWorker[w]->push(item);
+                    if (!item)
+                        break;
+                }
+            });
+        }
+
+        // Поток записи — вызывающий поток; первый nullptr по кругу означает конец
+        std::size_t n = 0;
+        try {
+            for (;; n++) {
+                Item* item = fromWorker[n % workers]->pop();
+                if (!item)
+                    break;
+                if (!stop.load(std::memory_order_relaxed) && !consume(*item))
+                    stop = true;
+                free.push(item);
+            }
+        } catch (...) {
+            errors[1] = std::current_exception();
+            stop = true;
+            drain(fromWorker, free, n + 1);
+        }
+        reader.join();
+        for (auto& t : workerThreads)
+            t.join();
+
+        for (auto& e : errors) {
+            if (e)
+                std::rethrow_exception(e);
+        }
+        for (auto& e : workErrors) {
+            if (e)
+                std::rethrow_exception(e);
+        }
+    }
+
+private:
+    unsigned workers;
+    std::size_t depth;
+    bool pin;
+
+    /// Освобождает очереди после ошибки потока записи, чтобы остальные стадии завершились
+    void drain(std::vector<std::unique_ptr<SpscRing<Item*>>>& fromWorker, SpscRing<Item*>& free, std::size_t n)
+    {
+        for (;; n++) {
+            Item* item = fromWorker[n % workers]->pop();
+            if (!item)
+                return;
+            free.push(item);
+        }
+    }
+};
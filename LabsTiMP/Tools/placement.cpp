@@ -0,0 +1,138 @@
+/**
+ * @file placement.cpp
+ * @brief Файл реализации размещения потоков и буферов
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "placement.h"
+#include <algorithm>
+#include <dirent.h>
+#include <fstream>
+#include <new>
+#include <pthread.h>
+#include <sched.h>
+#include <stdexcept>
+#include <sys/mman.h>
+
+const char* hugePagesName(HugePages pages)
+{
+    switch (pages) {
+    case HugePages::Transparent:
+        return "transparent";
+    case HugePages::Explicit:
+        return "explicit";
+    default:
+        return "off";
+    }
+}
+
+HugePages parseHugePages(const std::string& value)
+{
+    if (value == "off")
+        return HugePages::None;
+    if (value == "transparent")
+        return HugePages::Transparent;
+    if (value == "explicit")
+        return HugePages::Explicit;
+    throw std::invalid_argument("--huge-pages must be off, transparent or explicit");
+}
+
+std::vector<unsigned> allowedCpus()
+{
+    std::vector<std::pair<int, unsigned>> nodes; // Узел и номер ядра
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (unsigned cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &set))
+                nodes.emplace_back(cpuNode(cpu), cpu);
+        }
+    }
+    std::sort(nodes.begin(), nodes.end());
+    std::vector<unsigned> cpus;
+    for (auto& n : nodes)
+        cpus.push_back(n.second);
+    if (cpus.empty())
+        cpus.push_back(0);
+    return cpus;
+}
+
+int cpuNode(unsigned cpu)
+{
+    // В каталоге ядра есть ссылка nodeN на его узел
+    std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    DIR* dir = opendir(path.c_str());
+    if (!dir)
+        return -1;
+    int node = -1;
+    while (dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+            name.find_first_not_of("0123456789", 4) == std::string::npos) {
+            node = std::stoi(name.substr(4));
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+}
+
+bool pinThread(unsigned cpu)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+std::size_t hugePageSize()
+{
+    static const std::size_t size = [] {
+        std::ifstream meminfo("/proc/meminfo");
+        std::string key;
+        std::size_t kb = 0;
+        while (meminfo >> key) {
+            if (key == "Hugepagesize:" && meminfo >> kb)
+                return kb * 1024;
+            meminfo.ignore(256, '\n');
+        }
+        return std::size_t(2) << 20;
+    }();
+    return size;
+}
+
+HugePages adviseHugePages(void* data, std::size_t bytes, HugePages pages)
+{
+    if (pages == HugePages::None || !data || bytes < hugePageSize())
+        return HugePages::None;
+    return madvise(data, bytes, MADV_HUGEPAGE) == 0 ? HugePages::Transparent : HugePages::None;
+}
+
+std::pair<void*, std::size_t> mapPages(std::size_t bytes, HugePages& pages)
+{
+    std::size_t huge = hugePageSize();
+    if (bytes < huge)
+        pages = HugePages::None;
+    if (pages == HugePages::Explicit) {
+        // Размер отображения hugetlbfs кратен огромной странице
+        std::size_t length = (bytes + huge - 1) / huge * huge;
+        void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED)
+            return { p, length };
+        pages = HugePages::Transparent;
+    }
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        throw std::bad_alloc();
+    if (pages == HugePages::Transparent)
+        pages = adviseHugePages(p, bytes, pages);
+    return { p, bytes };
+}
+
+void unmapPages(std::pair<void*, std::size_t> mapping)
+{
+    munmap(mapping.first, mapping.second);
+}
@@ -0,0 +1,137 @@
+/**
+ * @file placement.h
+ * @brief Размещение рабочих потоков и буферов: ядра, узлы NUMA, огромные страницы
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * На многопроцессорных машинах страница памяти размещается на узле NUMA
+ * того потока, который первым к ней обратился (first touch). Если рабочий
+ * поток закреплён за ядром и сам первым пишет в свою часть буфера, он затем
+ * читает и пишет её без обращений к памяти другого процессора. Огромные
+ * страницы (2 МиБ) сокращают промахи TLB при проходах по большим буферам.
+ * Библиотека libnuma не используется: узел ядра читается из sysfs, а
+ * размещение страниц задаётся первым касанием.
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Огромные страницы для больших буферов
+enum class HugePages {
+    None,        ///< Обычные страницы
+    Transparent, ///< Прозрачные огромные страницы (madvise MADV_HUGEPAGE)
+    Explicit     ///< Зарезервированные страницы hugetlbfs (MAP_HUGETLB)
+};
+
+/// Название режима огромных страниц для --stats
+const char* hugePagesName(HugePages pages);
+
+/**
+ * @brief Разбирает значение --huge-pages: off, transparent или explicit
+ * @throw std::invalid_argument При другом значении
+ */
+HugePages parseHugePages(const std::string& value);
+
+/// Размещение рабочих потоков планировщика и их буферов
+struct Placement {
+    bool pin = false;        ///< Закрепить рабочие потоки за ядрами
+    bool firstTouch = false; ///< Статическое разбиение работы и первое касание частей буферов
+    HugePages hugePages = HugePages::None;
+};
+
+/**
+ * @brief Ядра, на которых процессу разрешено выполняться
+ * @details Упорядочены по узлам NUMA, внутри узла — по номерам: потоки,
+ *          закреплённые по порядку, сначала занимают ядра одного узла.
+ */
+std::vector<unsigned> allowedCpus();
+
+/// Узел NUMA ядра или -1, если он неизвестен
+int cpuNode(unsigned cpu);
+
+/**
+ * @brief Закрепляет вызывающий поток за ядром
+ * @return false, если ядро отказало
+ */
+bool pinThread(unsigned cpu);
+
+/// Размер огромной страницы, байт (Hugepagesize из /proc/meminfo, по умолчанию 2 МиБ)
+std::size_t hugePageSize();
+
+/**
+ * @brief Подсказывает ядру использовать огромные страницы для уже отображённой памяти
+ * @details Для отображённых файлов действует, если ядро поддерживает
+ *          огромные страницы в страничном кэше; иначе подсказка игнорируется.
+ * @return Фактический режим: Transparent или None
+ */
+HugePages adviseHugePages(void* data, std::size_t bytes, HugePages pages);
+
+/**
+ * @brief Отображает анонимную память, страницы которой ещё не выделены
+ * @param[in] bytes Размер, байт
+ * @param[in,out] pages Запрошенный режим; на выходе — полученный. Если
+ *                зарезервированных огромных страниц нет, используются
+ *                прозрачные; буфер меньше огромной страницы получает обычные.
+ * @return Адрес и фактический размер отображения
+ * @throw std::bad_alloc Если память не отображается
+ */
+std::pair<void*, std::size_t> mapPages(std::size_t bytes, HugePages& pages);
+
+/// Снимает отображение, созданное mapPages
+void unmapPages(std::pair<void*, std::size_t> mapping);
+
+/**
+ * @brief Буфер в анонимной памяти без начального заполнения
+ * @details В отличие от std::vector и std::wstring, конструктор не пишет в
+ *          буфер, поэтому каждая страница размещается на узле того потока,
+ *          который первым в неё запишет. Только перемещается.
+ * @tparam T Тривиальный тип элементов
+ */
+template <class T>
+class PageBuffer {
+public:
+    PageBuffer() {}
+    PageBuffer(std::size_t count, HugePages pages) : count(count), obtained(pages)
+    {
+        if (count > 0)
+            mapping = mapPages(count * sizeof(T), obtained);
+        else
+            obtained = HugePages::None;
+    }
+    PageBuffer(PageBuffer&& other) noexcept { swap(other); }
+    PageBuffer& operator=(PageBuffer&& other) noexcept
+    {
+        PageBuffer(std::move(other)).swap(*this);
+        return *this;
+    }
+    PageBuffer(const PageBuffer&) = delete;
+    PageBuffer& operator=(const PageBuffer&) = delete;
+    ~PageBuffer()
+    {
+        if (mapping.first)
+            unmapPages(mapping);
+    }
+
+    T* data() const { return static_cast<T*>(mapping.first); }
+    std::size_t size() const { return count; }
+    T& operator[](std::size_t i) const { return data()[i]; }
+    /// Фактический режим огромных страниц
+    HugePages pages() const { return obtained; }
+
+private:
+    std::pair<void*, std::size_t> mapping{nullptr, 0};
+    std::size_t count = 0;
+    HugePages obtained = HugePages::None;
+
+    void swap(PageBuffer& other) noexcept
+    {
+        std::swap(mapping, other.mapping);
+        std::swap(count, other.count);
+        std::swap(obtained, other.obtained);
+    }
+};
@@ -0,0 +1,142 @@
+/**
+ * @file protocol.cpp
+ * @brief Файл реализации протокола локальной службы шифрования
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "protocol.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace protocol {
+
+namespace {
+
+void putLength(std::string& out, uint32_t n)
+{
+    for (int i = 0; i < 4; i++)
+        out.push_back(static_cast<char>((n >> (8 * i)) & 0xFF));
+}
+
+uint32_t getLength(const char* p)
+{
+    uint32_t n = 0;
+    for (int i = 3; i >= 0; i--)
+        n = (n << 8) | static_cast<unsigned char>(p[i]);
+    return n;
+}
+
+} // namespace
+
+std::string encode(const Request& request)
+{
+    if (request.key.size() > 0xFFFF)
+        throw std::invalid_argument("key is too long");
+    std::string out;
+    uint32_t length = static_cast<uint32_t>(4 + request.key.size() + request.text.size());
+    out.reserve(4 + length);
+    putLength(out, length);
+    out.push_back(static_cast<char>(request.op));
+    out.push_back(static_cast<char>(request.kind));
+    out.push_back(static_cast<char>(request.key.size() & 0xFF));
+    out.push_back(static_cast<char>(request.key.size() >> 8));
+    out += request.key;
+    out += request.text;
+    return out;
+}
+
+std::string encode(const Response& response)
+{
+    std::string out;
+    out.reserve(5 + response.body.size());
+    putLength(out, static_cast<uint32_t>(1 + response.body.size()));
+    out.push_back(static_cast<char>(response.status));
+    out += response.body;
+    return out;
+}
+
+bool decode(const char* data, std::size_t size, Request& request)
+{
+    if (size < 4)
+        return false;
+    uint8_t op = static_cast<uint8_t>(data[0]);
+    uint8_t kind = static_cast<uint8_t>(data[1]);
+    std::size_t keySize = static_cast<unsigned char>(data[2]) | (static_cast<unsigned char>(data[3]) << 8);
+    if (op > 2 || kind > 1 || 4 + keySize > size)
+        return false;
+    request.op = static_cast<Op>(op);
+    request.kind = static_cast<Kind>(kind);
+    request.key.assign(data + 4, keySize);
+    request.text.assign(data + 4 + keySize, size - 4 - keySize);
+    return true;
+}
+
+bool decode(const char* data, std::size_t size, Response& response)
+{
+    if (size < 1 || static_cast<uint8_t>(data[0]) > 2)
+        return false;
+    response.status = static_cast<Status>(data[0]);
+    response.body.assign(data + 1, size - 1);
+    return true;
+}
+
+bool frameLength(const std::string& buffer, uint32_t& length)
+{
+    if (buffer.size() < 4)
+        return false;
+    length = getLength(buffer.data());
+    return true;
+}
+
+void sendAll(int fd, const std::string& data)
+{
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            throw std::runtime_error(std::string("send: ") + std::strerror(errno));
+        sent += static_cast<std::size_t>(n);
+    }
+}
+
+namespace {
+
+void receiveAll(int fd, char* data, std::size_t size)
+{
+    while (size > 0) {
+        ssize_t n = recv(fd, data, size, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            throw std::runtime_error(std::string("recv: ") + std::strerror(errno));
+        if (n == 0)
+            throw std::runtime_error("connection closed");
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+}
+
+} // namespace
+
+std::string receiveFrame(int fd)
+{
+    char header[4];
+    receiveAll(fd, header, 4);
+    uint32_t length = getLength(header);
+    if (length > maxFrame)
+        throw std::runtime_error("frame is too long");
+    std::string payload(length, '\0');
+    if (length > 0)
+        receiveAll(fd, &payload[0], length);
+    return payload;
+}
+
+} // namespace protocol
@@ -0,0 +1,87 @@
+/**
+ * @file protocol.h
+ * @brief Протокол локальной службы шифрования (Unix-сокет)
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Каждое сообщение — кадр: длина содержимого (4 байта, little-endian) и
+ * содержимое не длиннее maxFrame байт.
+ *
+ * Запрос: операция (1 байт), шифр (1 байт), длина ключа (2 байта,
+ * little-endian), ключ и текст в UTF-8. Ответ: состояние (1 байт) и
+ * результат или текст ошибки в UTF-8.
+ *
+ * На одном соединении запросы обрабатываются по одному: следующий запрос
+ * читается после отправки ответа на предыдущий.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace protocol {
+
+/// Операция запроса
+enum class Op : uint8_t {
+    Encrypt = 0,
+    Decrypt = 1,
+    Stats = 2 ///< Статистика службы; шифр, ключ и текст не используются
+};
+
+/// Шифр
+enum class Kind : uint8_t { Gronsfeld = 0, Route = 1 };
+
+/// Состояние ответа
+enum class Status : uint8_t {
+    Ok = 0,
+    CipherError = 1, ///< Шифр отклонил ключ или текст
+    BadRequest = 2   ///< Некорректный кадр
+};
+
+/// Наибольшая длина содержимого кадра, байт
+const uint32_t maxFrame = 16u << 20;
+
+struct Request {
+    Op op = Op::Encrypt;
+    Kind kind = Kind::Gronsfeld;
+    std::string key;  ///< UTF-8
+    std::string text; ///< UTF-8
+};
+
+struct Response {
+    Status status = Status::Ok;
+    std::string body; ///< Результат или текст ошибки, UTF-8
+};
+
+/// Кадр запроса вместе с длиной
+std::string encode(const Request& request);
+/// Кадр ответа вместе с длиной
+std::string encode(const Response& response);
+
+/**
+ * @brief Разбирает содержимое кадра запроса
+ * @return false, если содержимое некорректно
+ */
+bool decode(const char* data, std::size_t size, Request& request);
+/// Разбирает содержимое кадра ответа
+bool decode(const char* data, std::size_t size, Response& response);
+
+/**
+ * @brief Длина содержимого кадра в начале буфера
+ * @param[out] length Длина содержимого (без 4 байт заголовка)
+ * @return false, если заголовок ещё не получен целиком
+ */
+bool frameLength(const std::string& buffer, uint32_t& length);
+
+/// Отправляет все байты (блокирующий сокет); std::runtime_error при ошибке
+void sendAll(int fd, const std::string& data);
+/**
+ * @brief Принимает содержимое одного кадра (блокирующий сокет)
+ * @throw std::runtime_error При ошибке, закрытом соединении или слишком длинном кадре
+ */
+std::string receiveFrame(int fd);
+
+} // namespace protocol
@@ -0,0 +1,53 @@
+/**
+ * @file range_mode.cpp
+ * @brief Режим --range: расшифрование части отображённого в память шифртекста
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "modes.h"
+#include "mapped_file.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+uint64_t processRange(Engine& engine, const Options& opts, uint64_t& bytesIn, uint64_t& bytesOut)
+{
+    try {
+        MappedFile in = MappedFile::openRead(opts.input);
+        in.adviseRandom();
+        std::size_t size = in.size();
+        bool newline = size > 0 && in.data()[size - 1] == '\n';
+        if (newline) {
+            size--;
+            if (size > 0 && in.data()[size - 1] == '\r')
+                size--;
+        }
+        if (size % 2 != 0)
+            throw std::invalid_argument("cipher text must consist of two-byte UTF-8 letters");
+        if (opts.rangeOffset > size / 2 || opts.rangeLength > size / 2 - opts.rangeOffset)
+            throw std::invalid_argument("range is outside the cipher text");
+        bytesIn = 2 * opts.rangeLength;
+
+        FILE* file = opts.output.empty() ? stdout : fopen(opts.output.c_str(), "wb");
+        if (!file)
+            throw std::runtime_error("cannot open " + opts.output + ": " + strerror(errno));
+        Output out(file);
+        out.write(engine.decryptMappedRange(in.data(), size, opts.rangeOffset, opts.rangeLength));
+        if (newline)
+            out.put(L'\n');
+        bool written = out.flush();
+        bytesOut = out.bytesWritten();
+        if (file != stdout)
+            written = fclose(file) == 0 && written;
+        if (!written)
+            throw std::runtime_error("cannot write output");
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
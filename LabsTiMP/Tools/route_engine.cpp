@@ -0,0 +1,304 @@
+/**
+ * @file route_engine.cpp
+ * @brief Адаптер шифра табличной маршрутной перестановки (RouteCipher) к интерфейсу Engine
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "engine.h"
+#include "scheduler.h"
+#include "utf8.h"
+#include "../Lab4/route_cipher.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cwctype>
+#include <vector>
+
+namespace {
+
+/// Декодирует двухбайтовую последовательность UTF-8
+inline wchar_t decode2(const char* p)
+{
+    return static_cast<wchar_t>(((p[0] & 0x1F) << 6) | (p[1] & 0x3F));
+}
+
+/// Кодирует символ от U+0080 до U+07FF двумя байтами UTF-8
+inline void encode2(wchar_t c, char* p)
+{
+    p[0] = static_cast<char>(0xC0 | (c >> 6));
+    p[1] = static_cast<char>(0x80 | (c & 0x3F));
+}
+
+/// Русская буква, записанная в p двумя байтами UTF-8
+inline bool russianAt(const char* p, const char* end)
+{
+    return end - p >= 2 && (p[0] == '\xD0' || p[0] == '\xD1') && (p[1] & 0xC0) == 0x80
+        && isRussianLetter(decode2(p));
+}
+
+/**
+ * @brief Шифр маршрутной перестановки
+ * @details Маршрут проходит по всей таблице, поэтому сообщение обрабатывается
+ *          только целиком.
+ */
+class RouteEngine : public Engine {
+public:
+    RouteEngine(std::int64_t columns, Mode mode, const RouteSpec& routes) : cipher(columns, routes), mode(mode) {}
+
+    std::wstring transform(const std::wstring& text) override
+    {
+        return mode == Mode::Encrypt ? cipher.encrypt(text) : cipher.decrypt(text);
+    }
+
+    std::pmr::wstring transform(std::wstring_view text, std::pmr::memory_resource* resource) override
+    {
+        return mode == Mode::Encrypt ? cipher.encrypt(text, resource) : cipher.decrypt(text, resource);
+    }
+
+    bool chunked() const override { return false; }
+
+    uint64_t letters(const std::wstring& chunk) const override { return chunk.size(); }
+
+    std::wstring transformChunk(const std::wstring&, uint64_t) override
+    {
+        throw std::logic_error("RouteCipher cannot process a message in chunks");
+    }
+
+    void finish(uint64_t) override {}
+
+    std::size_t transformMapped(const char* in, std::size_t size, char* out) override
+    {
+        std::size_t written = mode == Mode::Encrypt ? encryptMapped(in, size, out) : decryptMapped(in, size, out);
+        if (written != notFast)
+            return written;
+        // Прочие символы: полная семантика RouteCipher через std::wstring
+        std::vector<wchar_t> chars(size + 1);
+        utf8::Decoder decoder;
+        std::size_t count = decoder.decode(in, size, chars.data());
+        count += decoder.finish(chars.data() + count);
+        std::wstring result = transform(std::wstring(chars.data(), count));
+        std::vector<char> bytes(4 * result.size());
+        written = utf8::encode(result.data(), result.size(), bytes.data());
+        if (written > size)
+            throw std::length_error("result is longer than the mapped output");
+        std::memcpy(out, bytes.data(), written);
+        return written;
+    }
+
+    std::wstring decryptMappedRange(const char* in, std::size_t size, uint64_t offset, std::size_t count) override
+    {
+        // Буква открытого текста номер i — буква шифртекста номер k, байты 2k и 2k + 1
+        const char* end = in + size;
+        std::int64_t from = static_cast<std::int64_t>(offset);
+        std::wstring result(count, L'\0');
+        std::int64_t length = static_cast<std::int64_t>(size / 2);
+        cipher.cellRange(length, from, static_cast<std::int64_t>(offset + count), [&](std::int64_t i, std::int64_t k) {
+            const char* p = in + 2 * static_cast<std::size_t>(k);
+            if (!russianAt(p, end))
+                throw cipher_error("Cipher text must contain only Russian letters");
+            result[static_cast<std::size_t>(i - from)] = decode2(p);
+        });
+        return result;
+    }
+
+    std::size_t transformTasks(const wchar_t* text, std::size_t length, wchar_t* out, Scheduler& scheduler,
+                               std::size_t grain) override
+    {
+        if (length <= grain)
+            return whole(text, length, out);
+        return mode == Mode::Encrypt ? encryptTasks(text, length, out, scheduler, grain)
+                                     : decryptTasks(text, length, out, scheduler, grain);
+    }
+
+private:
+    RouteCipher cipher;
+    Mode mode;
+
+    /// Признак того, что сообщение не подходит для обработки без декодирования
+    static const std::size_t notFast = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Параллельное зашифрование
+     * @details Проверка и подсчёт букв по частям входа, перенос букв в
+     *          сплошной буфер по вычисленным смещениям, затем сборка частей
+     *          шифртекста по диапазонам маршрута (RouteCipher::routeRange или
+     *          RoutePlan::gather для маршрутов не по умолчанию).
+     *          При ошибке сообщение передаётся transform() ради того же исключения.
+     */
+    std::size_t encryptTasks(const wchar_t* text, std::size_t size, wchar_t* out, Scheduler& scheduler, std::size_t grain)
+    {
+        std::size_t parts = (size + grain - 1) / grain;
+        std::vector<std::size_t> offsets(parts + 1, 0);
+        std::vector<char> valid(parts, 1);
+        scheduler.parallelFor(parts, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                std::size_t n = 0;
+                for (std::size_t k = i * grain; k < std::min(size, (i + 1) * grain); k++) {
+                    if (text[k] == L' ')
+                        continue;
+                    if (!isRussianLetter(text[k]))
+                        valid[i] = 0;
+                    n++;
+                }
+                offsets[i + 1] = n;
+            }
+        });
+        for (std::size_t i = 0; i < parts; i++) {
+            if (!valid[i])
+                return whole(text, size, out);
+            offsets[i + 1] += offsets[i];
+        }
+        if (offsets[parts] == 0)
+            return whole(text, size, out);
+        std::int64_t length = static_cast<std::int64_t>(offsets[parts]);
+
+        // Буквы части i впервые записывает задача части i (первое касание)
+        PageBuffer<wchar_t> letters(offsets[parts], scheduler.placement().hugePages);
+        scheduler.parallelFor(parts, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                std::size_t q = offsets[i];
+                for (std::size_t k = i * grain; k < std::min(size, (i + 1) * grain); k++) {
+                    if (text[k] != L' ')
+                        letters[q++] = toUpperRussian(text[k]);
+                }
+            }
+        });
+
+        if (cipher.routes() != RouteSpec()) {
+            // План компилируется один раз для всех задач
+            std::shared_ptr<const RoutePlan> plan = cipher.plan(length);
+            scheduler.parallelFor(letters.size(), grain, [&](std::size_t begin, std::size_t end) {
+                plan->gather(letters.data(), static_cast<std::int64_t>(begin), static_cast<std::int64_t>(end), out + begin);
+            });
+            return letters.size();
+        }
+        scheduler.parallelFor(letters.size(), grain, [&](std::size_t begin, std::size_t end) {
+            std::size_t q = begin;
+            cipher.routeRange(length, static_cast<std::int64_t>(begin), static_cast<std::int64_t>(end), [&](std::int64_t i) {
+                out[q++] = letters[static_cast<std::size_t>(i)];
+            });
+        });
+        return letters.size();
+    }
+
+    /**
+     * @brief Параллельное расшифрование
+     * @details k-я буква шифртекста записывается на место номер route(k);
+     *          диапазоны шифртекста обрабатываются независимыми задачами.
+     */
+    std::size_t decryptTasks(const wchar_t* text, std::size_t size, wchar_t* out, Scheduler& scheduler, std::size_t grain)
+    {
+        std::size_t parts = (size + grain - 1) / grain;
+        std::vector<char> valid(parts, 1);
+        scheduler.parallelFor(parts, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                for (std::size_t k = i * grain; k < std::min(size, (i + 1) * grain); k++) {
+                    if (!isRussianLetter(std::towupper(text[k])))
+                        valid[i] = 0;
+                }
+            }
+        });
+        if (std::find(valid.begin(), valid.end(), 0) != valid.end())
+            return whole(text, size, out);
+        std::int64_t length = static_cast<std::int64_t>(size);
+
+        if (cipher.routes() != RouteSpec()) {
+            std::shared_ptr<const RoutePlan> plan = cipher.plan(length);
+            scheduler.parallelFor(size, grain, [&](std::size_t begin, std::size_t end) {
+                plan->scatter(text + begin, static_cast<std::int64_t>(begin), static_cast<std::int64_t>(end), out);
+            });
+            return size;
+        }
+        scheduler.parallelFor(size, grain, [&](std::size_t begin, std::size_t end) {
+            std::size_t k = begin;
+            cipher.routeRange(length, static_cast<std::int64_t>(begin), static_cast<std::int64_t>(end), [&](std::int64_t i) {
+                out[static_cast<std::size_t>(i)] = text[k++];
+            });
+        });
+        return size;
+    }
+
+    /// Преобразование transform() с результатом в буфере transformTasks()
+    std::size_t whole(const wchar_t* text, std::size_t size, wchar_t* out)
+    {
+        return copyResult(transform(std::wstring(text, size)), size, out);
+    }
+
+    /**
+     * @brief Зашифрование сообщения из русских букв и пробелов
+     * @details Шифртекст собирается по маршруту RouteCipher::route прямо из
+     *          входа. Проверка и подсчёт букв идут одним проходом; если в
+     *          сообщении есть пробелы, в том же проходе буквы с первого
+     *          пробела переписываются подряд в отдельный буфер.
+     * @return Длина результата или notFast
+     */
+    std::size_t encryptMapped(const char* in, std::size_t size, char* out)
+    {
+        const char* end = in + size;
+        std::vector<char> compact;
+        char* q = nullptr;
+        std::size_t letters = 0;
+        for (const char* p = in; p < end;) {
+            if (*p == ' ') {
+                if (!q) {
+                    // До первого пробела вход состоит из букв
+                    compact.resize(size);
+                    q = std::copy(in, p, compact.data());
+                }
+                p++;
+            } else if (russianAt(p, end)) {
+                if (q) {
+                    q[0] = p[0];
+                    q[1] = p[1];
+                    q += 2;
+                }
+                letters++;
+                p += 2;
+            } else {
+                return notFast;
+            }
+        }
+        if (letters == 0)
+            return notFast;
+        const char* source = q ? compact.data() : in;
+        char* w = out;
+        cipher.route(static_cast<std::int64_t>(letters), [&](std::int64_t i) {
+            encode2(toUpperRussian(decode2(source + 2 * static_cast<std::size_t>(i))), w);
+            w += 2;
+        });
+        return 2 * letters;
+    }
+
+    /**
+     * @brief Расшифрование сообщения из русских букв
+     * @details k-я буква шифртекста записывается на место номер route(k);
+     *          буквы проверяются в том же проходе, и при ошибке результат
+     *          отбрасывается.
+     * @return Длина результата или notFast
+     */
+    std::size_t decryptMapped(const char* in, std::size_t size, char* out)
+    {
+        const char* end = in + size;
+        if (size == 0 || size % 2 != 0)
+            return notFast;
+        const char* p = in;
+        bool letters = true;
+        cipher.route(static_cast<std::int64_t>(size / 2), [&](std::int64_t i) {
+            letters &= russianAt(p, end);
+            out[2 * static_cast<std::size_t>(i)] = p[0];
+            out[2 * static_cast<std::size_t>(i) + 1] = p[1];
+            p += 2;
+        });
+        return letters ? size : notFast;
+    }
+};
+
+} // namespace
+
+std::unique_ptr<Engine> makeRouteEngine(std::int64_t columns, Mode mode, const RouteSpec& routes)
+{
+    return std::unique_ptr<Engine>(new RouteEngine(columns, mode, routes));
+}
@@ -0,0 +1,244 @@
+/**
+ * @file scheduler.cpp
+ * @brief Файл реализации планировщика задач с перехватом работы
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "scheduler.h"
+#include <algorithm>
+
+namespace {
+
+/// Планировщик и номер рабочего потока, в котором выполняется код
+thread_local const Scheduler* ownerScheduler = nullptr;
+thread_local int ownerIndex = -1;
+
+uint64_t elapsedNs(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - since).count();
+}
+
+} // namespace
+
+Scheduler::Scheduler(unsigned count, const Placement& placement)
+    : statsStart(std::chrono::steady_clock::now()), where(placement)
+{
+    if (count == 0)
+        count = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> cpus;
+    if (where.pin)
+        cpus = allowedCpus();
+    for (unsigned i = 0; i < count; i++)
+        workers.emplace_back(new Worker());
+    for (unsigned i = 0; i < count; i++)
+        threads.emplace_back(&Scheduler::loop, this, i, cpus.empty() ? -1 : static_cast<int>(cpus[i % cpus.size()]));
+}
+
+Scheduler::~Scheduler()
+{
+    // Оставшиеся задачи выполняются до остановки потоков
+    while (queued.load() > 0)
+        std::this_thread::yield();
+    stopping = true;
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        wakeup.notify_all();
+    }
+    for (auto& t : threads)
+        t.join();
+}
+
+int Scheduler::currentWorker() const
+{
+    return ownerScheduler == this ? ownerIndex : -1;
+}
+
+void Scheduler::submit(TaskGroup& group, std::function<void()> task)
+{
+    group.pending++;
+    int self = currentWorker();
+    unsigned target = self >= 0 ? static_cast<unsigned>(self) : nextWorker++ % size();
+    enqueue(target, Task{ std::move(task), &group });
+}
+
+void Scheduler::enqueue(unsigned target, Task task)
+{
+    bool bound = task.bound;
+    {
+        std::lock_guard<std::mutex> guard(workers[target]->lock);
+        workers[target]->tasks.push_back(std::move(task));
+    }
+    queued++;
+    std::lock_guard<std::mutex> guard(sleepLock);
+    // Задачу потока target не может взять другой поток: будятся все
+    if (bound)
+        wakeup.notify_all();
+    else
+        wakeup.notify_one();
+}
+
+bool Scheduler::take(int self, Task& task, bool& stolen)
+{
+    // Своя очередь — с конца
+    if (self >= 0) {
+        Worker& own = *workers[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            stolen = false;
+            return true;
+        }
+    }
+    // Чужие очереди — с начала, начиная с соседа
+    unsigned n = size();
+    unsigned start = self >= 0 ? static_cast<unsigned>(self) + 1 : nextWorker.load();
+    for (unsigned k = 0; k < n; k++) {
+        unsigned victim = (start + k) % n;
+        if (static_cast<int>(victim) == self)
+            continue;
+        Worker& other = *workers[victim];
+        std::lock_guard<std::mutex> guard(other.lock);
+        if (!other.tasks.empty() && !other.tasks.front().bound) {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            stolen = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Scheduler::execute(int self, Task& task, bool stolen)
+{
+    queued--;
+    auto begin = std::chrono::steady_clock::now();
+    try {
+        task.run();
+    } catch (...) {
+        std::lock_guard<std::mutex> guard(task.group->lock);
+        if (!task.group->error)
+            task.group->error = std::current_exception();
+    }
+    if (self >= 0) {
+        Worker& w = *workers[self];
+        w.busyNs += elapsedNs(begin);
+        w.executed++;
+        if (stolen)
+            w.stolen++;
+    }
+    task.group->pending--;
+}
+
+bool Scheduler::runOne(int self)
+{
+    Task task;
+    bool stolen = false;
+    if (!take(self, task, stolen))
+        return false;
+    execute(self, task, stolen);
+    return true;
+}
+
+void Scheduler::loop(unsigned self, int cpu)
+{
+    ownerScheduler = this;
+    ownerIndex = static_cast<int>(self);
+    if (cpu >= 0 && pinThread(static_cast<unsigned>(cpu)))
+        workers[self]->cpu = cpu;
+    while (!stopping) {
+        if (runOne(static_cast<int>(self)))
+            continue;
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wakeup.wait_for(guard, std::chrono::milliseconds(100), [&] { return stopping || queued.load() > 0; });
+    }
+}
+
+void Scheduler::wait(TaskGroup& group)
+{
+    int self = currentWorker();
+    unsigned idle = 0;
+    while (group.pending.load() > 0) {
+        if (runOne(self)) {
+            idle = 0;
+        } else if (++idle < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+    std::lock_guard<std::mutex> guard(group.lock);
+    if (group.error) {
+        std::exception_ptr error = group.error;
+        group.error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void Scheduler::split(TaskGroup& group, std::size_t begin, std::size_t end, std::size_t grain,
+                      const std::function<void(std::size_t, std::size_t)>& body)
+{
+    while (end - begin > grain) {
+        std::size_t middle = begin + (end - begin) / 2;
+        std::size_t upper = end;
+        submit(group, [this, &group, middle, upper, grain, &body] { split(group, middle, upper, grain, body); });
+        end = middle;
+    }
+    body(begin, end);
+}
+
+void Scheduler::parallelFor(std::size_t n, std::size_t grain, const std::function<void(std::size_t, std::size_t)>& body)
+{
+    if (n == 0)
+        return;
+    grain = std::max<std::size_t>(grain, 1);
+    if (n <= grain) {
+        body(0, n);
+        return;
+    }
+    TaskGroup group;
+    if (where.firstTouch) {
+        // Части j, j + size(), j + 2 size(), ... — потоку j
+        std::size_t parts = (n + grain - 1) / grain;
+        for (unsigned w = 0; w < size() && w < parts; w++) {
+            group.pending++;
+            enqueue(w, Task{ [=, &body] {
+                for (std::size_t j = w; j < parts; j += size())
+                    body(j * grain, std::min(n, (j + 1) * grain));
+            }, &group, true });
+        }
+    } else {
+        submit(group, [this, &group, n, grain, &body] { split(group, 0, n, grain, body); });
+    }
+    wait(group);
+}
+
+std::vector<WorkerStats> Scheduler::stats() const
+{
+    double total = elapsedNs(statsStart) / 1e9;
+    std::vector<WorkerStats> result;
+    for (auto& w : workers) {
+        WorkerStats s;
+        s.tasks = w->executed;
+        s.steals = w->stolen;
+        s.busySeconds = w->busyNs / 1e9;
+        s.totalSeconds = total;
+        s.cpu = w->cpu;
+        s.node = s.cpu >= 0 ? cpuNode(static_cast<unsigned>(s.cpu)) : -1;
+        result.push_back(s);
+    }
+    return result;
+}
+
+void Scheduler::resetStats()
+{
+    for (auto& w : workers) {
+        w->executed = 0;
+        w->stolen = 0;
+        w->busyNs = 0;
+    }
+    statsStart = std::chrono::steady_clock::now();
+}
@@ -0,0 +1,150 @@
+/**
+ * @file scheduler.h
+ * @brief Планировщик задач с перехватом работы (work stealing)
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * У каждого рабочего потока своя двусторонняя очередь задач: поток берёт
+ * задачи с конца своей очереди (последние поставленные, они «горячие» в
+ * кэше), а простаивающие потоки забирают задачи с начала чужих очередей
+ * (самые старые, обычно самые крупные части разбиения). Большие сообщения
+ * разбиваются на подзадачи методом Engine::transformTasks, малые
+ * выполняются целиком.
+ *
+ * С размещением (Placement) рабочие потоки закрепляются за ядрами, а
+ * parallelFor распределяет части статически, чтобы часть буфера
+ * обрабатывал тот же поток, который первым в неё записал (placement.h).
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "placement.h"
+
+/**
+ * @brief Группа задач, завершения которых можно дождаться
+ * @details Первое исключение, выброшенное задачей группы, сохраняется и
+ *          выбрасывается из Scheduler::wait().
+ */
+class TaskGroup {
+public:
+    TaskGroup() {}
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+private:
+    friend class Scheduler;
+    std::atomic<std::size_t> pending{0};
+    std::mutex lock;
+    std::exception_ptr error;
+};
+
+/// Статистика рабочего потока
+struct WorkerStats {
+    uint64_t tasks = 0;      ///< Выполнено задач
+    uint64_t steals = 0;     ///< Из них взято из чужих очередей
+    double busySeconds = 0;  ///< Время выполнения задач
+    double totalSeconds = 0; ///< Время с запуска или последнего resetStats()
+    int cpu = -1;            ///< Ядро, за которым закреплён поток, или -1
+    int node = -1;           ///< Узел NUMA этого ядра или -1
+
+    /// Доля времени, занятая задачами
+    double utilization() const { return totalSeconds > 0 ? busySeconds / totalSeconds : 0; }
+};
+
+/**
+ * @brief Пул потоков с очередями задач и перехватом работы
+ */
+class Scheduler {
+public:
+    /**
+     * @param[in] workers Количество рабочих потоков; 0 — по числу ядер
+     * @param[in] placement С pin поток номер i закрепляется за ядром
+     *            allowedCpus()[i % число ядер]; firstTouch включает
+     *            статическое разбиение в parallelFor
+     */
+    explicit Scheduler(unsigned workers = 0, const Placement& placement = Placement());
+    /// Дожидается завершения всех поставленных задач
+    ~Scheduler();
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }
+    const Placement& placement() const { return where; }
+
+    /**
+     * @brief Ставит задачу в очередь
+     * @details Из рабочего потока — в конец его собственной очереди, из
+     *          других потоков — по очереди рабочим потокам.
+     */
+    void submit(TaskGroup& group, std::function<void()> task);
+
+    /**
+     * @brief Дожидается завершения задач группы
+     * @details Ожидающий поток сам выполняет задачи, поэтому задача может
+     *          ставить подзадачи и ждать их без риска взаимной блокировки.
+     * @throw Первое исключение, выброшенное задачей группы
+     */
+    void wait(TaskGroup& group);
+
+    /**
+     * @brief Выполняет body(begin, end) для частей диапазона [0, n) не длиннее grain
+     * @details Диапазон делится пополам: одна половина ставится в очередь
+     *          (её могут забрать другие потоки), другая делится дальше.
+     *          С placement().firstTouch диапазон делится на части по grain, и
+     *          часть номер j всегда выполняет рабочий поток j % size(), без
+     *          перехвата: проходы с одним grain по одному буферу обращаются к
+     *          каждой его части из одного и того же потока.
+     */
+    void parallelFor(std::size_t n, std::size_t grain, const std::function<void(std::size_t, std::size_t)>& body);
+
+    /// Статистика по рабочим потокам
+    std::vector<WorkerStats> stats() const;
+    /// Обнуляет статистику
+    void resetStats();
+
+private:
+    struct Task {
+        std::function<void()> run;
+        TaskGroup* group;
+        bool bound = false; ///< Выполняется только своим потоком, не перехватывается
+    };
+
+    struct Worker {
+        std::mutex lock;
+        std::deque<Task> tasks;
+        std::atomic<uint64_t> executed{0}, stolen{0}, busyNs{0};
+        std::atomic<int> cpu{-1};
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> queued{0};
+    std::atomic<unsigned> nextWorker{0};
+    std::atomic<bool> stopping{false};
+    std::mutex sleepLock;
+    std::condition_variable wakeup;
+    std::chrono::steady_clock::time_point statsStart;
+    Placement where;
+
+    void loop(unsigned self, int cpu);
+    void enqueue(unsigned target, Task task);
+    bool runOne(int self);
+    bool take(int self, Task& task, bool& stolen);
+    void execute(int self, Task& task, bool stolen);
+    void split(TaskGroup& group, std::size_t begin, std::size_t end, std::size_t grain,
+               const std::function<void(std::size_t, std::size_t)>& body);
+    int currentWorker() const;
+};
@@ -0,0 +1,530 @@
+/**
+ * @file server.cpp
+ * @brief Файл реализации локальной службы шифрования
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "server.h"
+#include "utf8.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+[[noreturn]] void fail(const std::string& what)
+{
+    throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+void setNonBlocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+        fail("fcntl");
+}
+
+std::wstring fromUtf8(const std::string& s)
+{
+    std::vector<wchar_t> buf(s.size() + 1);
+    utf8::Decoder decoder;
+    std::size_t n = decoder.decode(s.data(), s.size(), buf.data());
+    n += decoder.finish(buf.data() + n);
+    return std::wstring(buf.data(), n);
+}
+
+/// Декодирует UTF-8 в строку, размещённую в resource
+std::pmr::wstring fromUtf8(const std::string& s, std::pmr::memory_resource* resource)
+{
+    std::pmr::wstring out(s.size() + 1, L'\0', resource);
+    utf8::Decoder decoder;
+    std::size_t n = decoder.decode(s.data(), s.size(), &out[0]);
+    n += decoder.finish(&out[n]);
+    out.resize(n);
+    return out;
+}
+
+std::string toUtf8(std::wstring_view s)
+{
+    std::string out(4 * s.size(), '\0');
+    out.resize(utf8::encode(s.data(), s.size(), &out[0]));
+    return out;
+}
+
+/**
+ * @brief Источник памяти сверх буфера арены
+ * @details Передаёт запросы дальше и считает их, чтобы служба знала, как
+ *          часто запросы не умещаются в буфер.
+ */
+class Overflow : public std::pmr::memory_resource {
+public:
+    explicit Overflow(std::pmr::memory_resource* upstream) : upstream(upstream) {}
+
+    uint64_t allocations = 0;
+
+private:
+    std::pmr::memory_resource* upstream;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        allocations++;
+        return upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        upstream->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+/// Кадр в начале буфера получен целиком
+bool complete(const std::string& in)
+{
+    uint32_t length;
+    return protocol::frameLength(in, length) && in.size() >= 4 + static_cast<std::size_t>(length);
+}
+
+/**
+ * @brief Создаёт шифр по ключу запроса
+ * @details Ключ маршрутной перестановки — десятичное число столбцов из
+ *          цифр ASCII; любой другой символ (в том числе не ASCII) отклоняется.
+ * @throw std::invalid_argument Если ключ недопустим
+ */
+std::shared_ptr<Engine> makeEngine(protocol::Kind kind, Mode mode, const std::wstring& key)
+{
+    if (kind == protocol::Kind::Gronsfeld)
+        return makeGronsfeldEngine(key, mode);
+    bool digits = !key.empty();
+    for (wchar_t c : key)
+        digits = digits && c >= L'0' && c <= L'9';
+    long long columns = 0;
+    try {
+        if (digits)
+            columns = std::stoll(std::string(key.begin(), key.end()));
+    } catch (const std::exception&) {
+        digits = false;
+    }
+    if (!digits)
+        throw std::invalid_argument("route key must be a number of columns");
+    return makeRouteEngine(columns, mode);
+}
+
+} // namespace
+
+std::shared_ptr<Engine> EngineCache::get(protocol::Kind kind, Mode mode, const std::wstring& key)
+{
+    std::wstring id = std::wstring(1, static_cast<wchar_t>(kind)) + static_cast<wchar_t>(mode) + key;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = index.find(id);
+        if (it != index.end()) {
+            hitCount++;
+            order.splice(order.begin(), order, it->second);
+            return it->second->second;
+        }
+    }
+    missCount++;
+    // Шифр строится без блокировки, чтобы промах не задерживал остальные потоки
+    std::shared_ptr<Engine> engine = makeEngine(kind, mode, key);
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = index.find(id);
+    if (it != index.end()) {
+        // Тот же шифр уже построен другим потоком
+        order.splice(order.begin(), order, it->second);
+        return it->second->second;
+    }
+    order.emplace_front(id, engine);
+    index[id] = order.begin();
+    if (order.size() > capacity) {
+        index.erase(order.back().first);
+        order.pop_back();
+    }
+    return engine;
+}
+
+Server::Server(const ServerOptions& options) : options(options), cache(options.cacheSize) {}
+
+Server::~Server()
+{
+    stop();
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        queueReady.notify_all();
+    }
+    for (auto& t : workers) {
+        if (t.joinable())
+            t.join();
+    }
+}
+
+void Server::stop()
+{
+    stopping = true;
+    wake();
+}
+
+void Server::wake()
+{
+    if (wakeWrite >= 0) {
+        char c = 0;
+        ssize_t n = write(wakeWrite, &c, 1);
+        (void)n;
+    }
+}
+
+void Server::run()
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (options.path.empty() || options.path.size() >= sizeof(address.sun_path))
+        throw std::runtime_error("invalid socket path: " + options.path);
+    std::strcpy(address.sun_path, options.path.c_str());
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0)
+        fail("socket");
+    unlink(options.path.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+        fail("bind " + options.path);
+    if (listen(listenFd, 128) < 0)
+        fail("listen");
+    setNonBlocking(listenFd);
+    int pipeFds[2];
+    if (pipe(pipeFds) < 0)
+        fail("pipe");
+    wakeRead = pipeFds[0];
+    wakeWrite = pipeFds[1];
+    setNonBlocking(wakeRead);
+    setNonBlocking(wakeWrite);
+
+    for (unsigned i = 0; i < std::max(1u, options.workers); i++)
+        workers.emplace_back(&Server::work, this);
+
+    std::vector<pollfd> fds;
+    std::vector<uint64_t> ids;
+    while (!stopping) {
+        fds.clear();
+        ids.clear();
+        fds.push_back(pollfd{ wakeRead, POLLIN, 0 });
+        bool accepting = connections.size() < options.maxConnections;
+        if (accepting)
+            fds.push_back(pollfd{ listenFd, POLLIN, 0 });
+        for (auto& entry : connections) {
+            Connection& c = entry.second;
+            short events = 0;
+            if (c.outPos < c.out.size())
+                events |= POLLOUT;
+            // Пока запрос не обработан или не прочитан целиком следующий кадр, соединение не читается
+            if (!c.busy && !complete(c.in))
+                events |= POLLIN;
+            fds.push_back(pollfd{ c.fd, events, 0 });
+            ids.push_back(entry.first);
+        }
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            fail("poll");
+        }
+
+        if (fds[0].revents & POLLIN) {
+            char buf[256];
+            while (read(wakeRead, buf, sizeof(buf)) > 0) {
+            }
+        }
+        collect();
+        std::size_t first = 1;
+        if (accepting) {
+            if (fds[1].revents & POLLIN)
+                acceptConnections();
+            first = 2;
+        }
+        std::vector<uint64_t> closed;
+        for (std::size_t i = first; i < fds.size(); i++) {
+            auto it = connections.find(ids[i - first]);
+            if (it == connections.end() || !fds[i].revents)
+                continue;
+            Connection& c = it->second;
+            bool alive = true;
+            if (fds[i].revents & POLLOUT)
+                alive = writeConnection(c);
+            if (alive && (fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+                alive = readConnection(c);
+            if (!alive)
+                closed.push_back(it->first);
+        }
+        for (uint64_t id : closed) {
+            close(connections[id].fd);
+            connections.erase(id);
+        }
+        dispatch();
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        queueReady.notify_all();
+    }
+    for (auto& t : workers)
+        t.join();
+    workers.clear();
+    for (auto& entry : connections)
+        close(entry.second.fd);
+    connections.clear();
+    close(listenFd);
+    close(wakeRead);
+    int w = wakeWrite;
+    wakeWrite = -1;
+    close(w);
+    unlink(options.path.c_str());
+}
+
+void Server::acceptConnections()
+{
+    while (connections.size() < options.maxConnections) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0)
+            return;
+        setNonBlocking(fd);
+        Connection c;
+        c.fd = fd;
+        connections.insert(std::make_pair(nextConnection++, std::move(c)));
+        peakConnections = std::max<uint64_t>(peakConnections, connections.size());
+    }
+}
+
+bool Server::readConnection(Connection& c)
+{
+    char buf[64 * 1024];
+    for (;;) {
+        uint32_t length;
+        if (protocol::frameLength(c.in, length)) {
+            if (length > protocol::maxFrame)
+                return false;
+            if (c.in.size() >= 4 + static_cast<std::size_t>(length))
+                return true;
+        }
+        ssize_t n = recv(c.fd, buf, sizeof(buf), 0);
+        if (n > 0) {
+            c.in.append(buf, static_cast<std::size_t>(n));
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+            return true;
+        // Клиент закрыл соединение; ответ на уже переданный запрос не нужен
+        return false;
+    }
+}
+
+bool Server::writeConnection(Connection& c)
+{
+    while (c.outPos < c.out.size()) {
+        ssize_t n = send(c.fd, c.out.data() + c.outPos, c.out.size() - c.outPos, MSG_NOSIGNAL);
+        if (n > 0) {
+            c.outPos += static_cast<std::size_t>(n);
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+            return true;
+        return false;
+    }
+    c.out.clear();
+    c.outPos = 0;
+    return true;
+}
+
+void Server::respond(Connection& c, const protocol::Response& response)
+{
+    c.out += protocol::encode(response);
+}
+
+void Server::dispatch()
+{
+    std::size_t room;
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        room = queue.size() < options.queueLimit ? options.queueLimit - queue.size() : 0;
+    }
+    std::vector<std::unique_ptr<Job>> jobs;
+    std::vector<uint64_t> broken;
+    // Обход начинается после соединения, обслуженного последним, чтобы при
+    // заполненной очереди соединения с большими номерами не ждали бесконечно
+    auto it = connections.upper_bound(cursor);
+    for (std::size_t visited = 0; visited < connections.size(); visited++, ++it) {
+        if (it == connections.end())
+            it = connections.begin();
+        auto& entry = *it;
+        Connection& c = entry.second;
+        if (c.busy || c.outPos < c.out.size() || !complete(c.in))
+            continue;
+        bool stats = c.in.size() > 4 && static_cast<protocol::Op>(c.in[4]) == protocol::Op::Stats;
+        // Очередь заполнена: кадр остаётся в буфере соединения до освобождения места
+        if (!stats && room == 0)
+            continue;
+        uint32_t length;
+        protocol::frameLength(c.in, length);
+        std::unique_ptr<Job> job(new Job());
+        job->connection = entry.first;
+        job->received = nowNs();
+        bool valid = protocol::decode(c.in.data() + 4, length, job->request);
+        c.in.erase(0, 4 + static_cast<std::size_t>(length));
+        if (!valid) {
+            protocol::Response r;
+            r.status = protocol::Status::BadRequest;
+            r.body = "malformed request";
+            respond(c, r);
+            errors++;
+        } else if (job->request.op == protocol::Op::Stats) {
+            protocol::Response r;
+            r.body = statistics();
+            respond(c, r);
+        } else {
+            c.busy = true;
+            room--;
+            cursor = entry.first;
+            jobs.push_back(std::move(job));
+            continue;
+        }
+        if (!writeConnection(c))
+            broken.push_back(entry.first);
+    }
+    for (uint64_t id : broken) {
+        close(connections[id].fd);
+        connections.erase(id);
+    }
+    if (jobs.empty())
+        return;
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        for (auto& job : jobs)
+            queue.push_back(std::move(job));
+        peakQueue = std::max<uint64_t>(peakQueue, queue.size());
+    }
+    queueReady.notify_all();
+}
+
+void Server::collect()
+{
+    std::vector<std::unique_ptr<Job>> finished;
+    {
+        std::lock_guard<std::mutex> guard(doneLock);
+        finished.swap(done);
+    }
+    int64_t now = nowNs();
+    std::vector<uint64_t> broken;
+    for (auto& job : finished) {
+        latency.record(static_cast<uint64_t>(now - job->received));
+        requests++;
+        if (job->response.status != protocol::Status::Ok)
+            errors++;
+        auto it = connections.find(job->connection);
+        if (it == connections.end())
+            continue;
+        it->second.busy = false;
+        respond(it->second, job->response);
+        if (!writeConnection(it->second))
+            broken.push_back(it->first);
+    }
+    for (uint64_t id : broken) {
+        close(connections[id].fd);
+        connections.erase(id);
+    }
+}
+
+void Server::work()
+{
+    std::vector<std::unique_ptr<Job>> batch;
+    std::vector<char> scratch(options.arenaSize);
+    std::pmr::unsynchronized_pool_resource pool;
+    Overflow overflow(&pool);
+    for (;;) {
+        batch.clear();
+        {
+            std::unique_lock<std::mutex> guard(queueLock);
+            queueReady.wait(guard, [&] { return stopping || !queue.empty(); });
+            if (stopping)
+                return;
+            // Пачка: всё, что накопилось в очереди, но не больше maxBatch
+            std::size_t n = std::min(queue.size(), std::max<std::size_t>(1, options.maxBatch));
+            for (std::size_t i = 0; i < n; i++) {
+                batch.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+        }
+        batches++;
+        batched += batch.size();
+        // Запросы пачки с одинаковым ключом используют один экземпляр шифра
+        std::map<std::wstring, std::shared_ptr<Engine>> local;
+        for (auto& job : batch) {
+            // Арена запроса: буфер потока, сверх него — пул потока без блокировок
+            uint64_t before = overflow.allocations;
+            {
+                std::pmr::monotonic_buffer_resource arena(scratch.data(), scratch.size(), &overflow);
+                execute(*job, local, arena);
+            }
+            if (overflow.allocations != before)
+                arenaSpills++;
+        }
+        {
+            std::lock_guard<std::mutex> guard(doneLock);
+            for (auto& job : batch)
+                done.push_back(std::move(job));
+        }
+        wake();
+    }
+}
+
+void Server::execute(Job& job, std::map<std::wstring, std::shared_ptr<Engine>>& local, std::pmr::memory_resource& arena)
+{
+    const protocol::Request& request = job.request;
+    try {
+        Mode mode = request.op == protocol::Op::Encrypt ? Mode::Encrypt : Mode::Decrypt;
+        std::wstring key = fromUtf8(request.key);
+        std::wstring id = std::wstring(1, static_cast<wchar_t>(request.kind)) + static_cast<wchar_t>(mode) + key;
+        std::shared_ptr<Engine>& engine = local[id];
+        if (!engine)
+            engine = cache.get(request.kind, mode, key);
+        job.response.status = protocol::Status::Ok;
+        job.response.body = toUtf8(engine->transform(fromUtf8(request.text, &arena), &arena));
+    } catch (const std::exception& e) {
+        job.response.status = protocol::Status::CipherError;
+        job.response.body = e.what();
+    }
+}
+
+std::string Server::statistics() const
+{
+    char text[512];
+    uint64_t b = batches, n = batched;
+    std::snprintf(text, sizeof(text),
+                  "requests %llu, errors %llu, batches %llu (%.2f requests per batch), queue peak %llu, "
+                  "connections %zu (peak %llu), cache hits %llu, misses %llu, arena spills %llu\n"
+                  "latency us: p50 %.1f, p99 %.1f, p999 %.1f, max %.1f\n",
+                  static_cast<unsigned long long>(requests), static_cast<unsigned long long>(errors),
+                  static_cast<unsigned long long>(b), b ? static_cast<double>(n) / b : 0.0,
+                  static_cast<unsigned long long>(peakQueue), connections.size(),
+                  static_cast<unsigned long long>(peakConnections),
+                  static_cast<unsigned long long>(cache.hits()), static_cast<unsigned long long>(cache.misses()),
+                  static_cast<unsigned long long>(arenaSpills.load()),
+                  latency.percentile(0.5) / 1e3, latency.percentile(0.99) / 1e3, latency.percentile(0.999) / 1e3,
+                  latency.max() / 1e3);
+    return text;
+}
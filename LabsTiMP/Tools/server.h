@@ -0,0 +1,137 @@
+/**
+ * @file server.h
+ * @brief Локальная служба шифрования на Unix-сокете
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Поток ввода-вывода принимает соединения и читает кадры (protocol.h),
+ * фиксированный пул потоков выполняет запросы пачками, используя кэш
+ * экземпляров шифров по ключу. Память запроса (декодированный текст,
+ * буферы шифра, результат) выделяется из арены std::pmr поверх буфера
+ * потока и освобождается целиком после ответа, без обращений к общему
+ * распределителю памяти.
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "engine.h"
+#include "histogram.h"
+#include "protocol.h"
+
+/// Параметры службы
+struct ServerOptions {
+    std::string path;               ///< Путь Unix-сокета
+    unsigned workers = 4;           ///< Потоков шифрования
+    unsigned maxConnections = 256;  ///< Одновременных соединений; остальные ждут в очереди listen()
+    std::size_t queueLimit = 1024;  ///< Запросов в очереди; при заполнении соединения не читаются
+    std::size_t maxBatch = 32;      ///< Запросов, забираемых потоком за раз
+    std::size_t cacheSize = 256;    ///< Экземпляров шифров в кэше
+    std::size_t arenaSize = 1 << 20; ///< Буфер арены запроса в каждом потоке, байт
+};
+
+/**
+ * @brief Кэш шифров по (шифр, направление, ключ) с вытеснением давно не использованных
+ * @details Потокобезопасен; при промахе шифр строится вне блокировки.
+ *          Ошибка ключа не кэшируется и передаётся вызывающему.
+ */
+class EngineCache {
+public:
+    explicit EngineCache(std::size_t capacity) : capacity(capacity ? capacity : 1) {}
+
+    std::shared_ptr<Engine> get(protocol::Kind kind, Mode mode, const std::wstring& key);
+
+    uint64_t hits() const { return hitCount; }
+    uint64_t misses() const { return missCount; }
+
+private:
+    typedef std::pair<std::wstring, std::shared_ptr<Engine>> Entry;
+
+    std::size_t capacity;
+    std::mutex lock;
+    std::list<Entry> order; ///< Начало — последний использованный
+    std::unordered_map<std::wstring, std::list<Entry>::iterator> index;
+    std::atomic<uint64_t> hitCount{0}, missCount{0};
+};
+
+/**
+ * @brief Служба шифрования
+ */
+class Server {
+public:
+    explicit Server(const ServerOptions& options);
+    ~Server();
+
+    /**
+     * @brief Создаёт сокет и обслуживает запросы до вызова stop()
+     * @throw std::runtime_error Если сокет не удалось создать
+     */
+    void run();
+    /// Завершает run(); безопасно вызывать из обработчика сигнала
+    void stop();
+    /// Текстовая статистика: запросы, пачки, кэш, процентили задержки
+    std::string statistics() const;
+
+private:
+    /// Запрос, переданный пулу потоков
+    struct Job {
+        uint64_t connection;
+        protocol::Request request;
+        protocol::Response response;
+        int64_t received; ///< Время получения кадра, нс
+    };
+
+    struct Connection {
+        int fd;
+        std::string in, out;
+        std::size_t outPos = 0;
+        bool busy = false; ///< Запрос передан пулу, ответ ещё не получен
+    };
+
+    ServerOptions options;
+    int listenFd = -1;
+    int wakeRead = -1, wakeWrite = -1;
+    std::atomic<bool> stopping{false};
+
+    std::map<uint64_t, Connection> connections;
+    uint64_t nextConnection = 1;
+    uint64_t cursor = 0; ///< Последнее соединение, чей запрос поставлен в очередь
+
+    std::mutex queueLock;
+    std::condition_variable queueReady;
+    std::deque<std::unique_ptr<Job>> queue;
+    std::mutex doneLock;
+    std::vector<std::unique_ptr<Job>> done;
+    std::vector<std::thread> workers;
+    EngineCache cache;
+
+    // Статистика изменяется только потоком ввода-вывода (кроме пачек)
+    LatencyHistogram latency;
+    uint64_t requests = 0, errors = 0;
+    std::atomic<uint64_t> batches{0}, batched{0};
+    std::atomic<uint64_t> arenaSpills{0}; ///< Запросов, не уместившихся в буфер арены
+    uint64_t peakQueue = 0, peakConnections = 0;
+
+    void work();
+    void execute(Job& job, std::map<std::wstring, std::shared_ptr<Engine>>& local, std::pmr::memory_resource& arena);
+    void acceptConnections();
+    bool readConnection(Connection& c);
+    bool writeConnection(Connection& c);
+    void dispatch();
+    void collect();
+    void respond(Connection& c, const protocol::Response& response);
+    void wake();
+};
@@ -0,0 +1,119 @@
+/**
+ * @file spsc_ring.h
+ * @brief Кольцевой буфер без блокировок для одного писателя и одного читателя
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Ожидание с постепенным отступлением
+ * @details Сначала уступает процессор, затем засыпает, чтобы ожидающий поток
+ *          не занимал ядро, пока другая стадия ждёт диска.
+ */
+class Backoff {
+public:
+    void pause()
+    {
+        if (spins < 64) {
+            spins++;
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+private:
+    unsigned spins = 0;
+};
+
+/**
+ * @brief Очередь фиксированной ёмкости для одного потока-писателя и одного потока-читателя
+ * @details push() вызывает только писатель, pop() — только читатель.
+ *          Индексы растут неограниченно, ёмкость округляется до степени двойки.
+ *          Каждая сторона кэширует индекс другой стороны и перечитывает его
+ *          только когда очередь кажется полной или пустой.
+ * @tparam T Копируемый тип элемента (обычно указатель)
+ */
+template <class T>
+class SpscRing {
+public:
+    explicit SpscRing(std::size_t capacity) : slots(roundUp(capacity)), mask(slots.size() - 1) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /// Добавляет элемент; false, если очередь заполнена
+    bool tryPush(const T& value)
+    {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - headCache == slots.size()) {
+            headCache = head.load(std::memory_order_acquire);
+            if (t - headCache == slots.size())
+                return false;
+        }
+        slots[t & mask] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Извлекает элемент; false, если очередь пуста
+    bool tryPop(T& value)
+    {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tailCache) {
+            tailCache = tail.load(std::memory_order_acquire);
+            if (h == tailCache)
+                return false;
+        }
+        value = slots[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Добавляет элемент, ожидая свободного места
+    void push(const T& value)
+    {
+        Backoff backoff;
+        while (!tryPush(value))
+            backoff.pause();
+    }
+
+    /// Извлекает элемент, ожидая его появления
+    T pop()
+    {
+        T value;
+        Backoff backoff;
+        while (!tryPop(value))
+            backoff.pause();
+        return value;
+    }
+
+private:
+    static std::size_t roundUp(std::size_t n)
+    {
+        std::size_t size = 1;
+        while (size < n)
+            size <<= 1;
+        return size;
+    }
+
+    // Поля писателя и читателя разнесены по разным строкам кэша
+    std::vector<T> slots;
+    std::size_t mask;
+    char padSlots[64];
+    std::atomic<std::size_t> head{0}; ///< Следующий элемент для читателя
+    std::size_t tailCache = 0;        ///< Копия tail у читателя
+    char padHead[64];
+    std::atomic<std::size_t> tail{0}; ///< Следующее свободное место для писателя
+    std::size_t headCache = 0;        ///< Копия head у писателя
+    char padTail[64];
+};
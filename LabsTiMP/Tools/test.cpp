@@ -0,0 +1,118 @@
+/**
+ * @file test.cpp
+ * @brief Тесты службы шифрования: кэш шифров и запросы через сокет
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "client.h"
+#include "server.h"
+
+#include <UnitTest++/UnitTest++.h>
+
+#include <chrono>
+#include <iostream>
+#include <locale>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace std;
+
+void init_locale()
+{
+    try {
+        locale::global(locale("ru_RU.UTF-8"));
+    } catch(const exception& e) {
+        cerr << "Ошибка установки локали: " << e.what() << endl;
+        locale::global(locale(""));
+    }
+}
+
+// Служба на временном сокете в отдельном потоке
+struct Daemon_fixture {
+    ServerOptions options;
+    Server* server;
+    thread runner;
+    Daemon_fixture()
+    {
+        options.path = "/tmp/cipherd-test-" + to_string(getpid()) + ".sock";
+        options.workers = 2;
+        server = new Server(options);
+        runner = thread([this] { server->run(); });
+    }
+    ~Daemon_fixture()
+    {
+        server->stop();
+        runner.join();
+        delete server;
+        unlink(options.path.c_str());
+    }
+    // Соединение, как только служба начала принимать запросы
+    protocol::Response call(const protocol::Request& request)
+    {
+        for (int attempt = 0;; attempt++) {
+            try {
+                Client client(options.path);
+                return client.call(request);
+            } catch (const runtime_error&) {
+                if (attempt == 200)
+                    throw;
+                this_thread::sleep_for(chrono::milliseconds(10));
+            }
+        }
+    }
+};
+
+protocol::Request routeRequest(const string& key, const string& text)
+{
+    protocol::Request request;
+    request.kind = protocol::Kind::Route;
+    request.key = key;
+    request.text = text;
+    return request;
+}
+
+SUITE(EngineCacheTest)
+{
+    TEST(RouteKeyIsDecimalNumber) {
+        EngineCache cache(4);
+        CHECK(cache.get(protocol::Kind::Route, Mode::Encrypt, L"55"));
+        CHECK_THROW(cache.get(protocol::Kind::Route, Mode::Encrypt, L"ее"), invalid_argument);
+        CHECK_THROW(cache.get(protocol::Kind::Route, Mode::Encrypt, L"д"), invalid_argument);
+        CHECK_THROW(cache.get(protocol::Kind::Route, Mode::Encrypt, L"5е"), invalid_argument);
+        CHECK_THROW(cache.get(protocol::Kind::Route, Mode::Encrypt, L""), invalid_argument);
+    }
+    TEST(SecondRequestHitsCache) {
+        EngineCache cache(4);
+        auto first = cache.get(protocol::Kind::Gronsfeld, Mode::Encrypt, L"КЛЮЧ");
+        CHECK(first == cache.get(protocol::Kind::Gronsfeld, Mode::Encrypt, L"КЛЮЧ"));
+        CHECK_EQUAL(1, (int)cache.hits());
+        CHECK_EQUAL(1, (int)cache.misses());
+    }
+}
+
+SUITE(DaemonTest)
+{
+    TEST_FIXTURE(Daemon_fixture, RouteEncrypt) {
+        protocol::Response response = call(routeRequest("3", "ПРИВЕТМИР"));
+        CHECK(response.status == protocol::Status::Ok);
+        CHECK_EQUAL(9u, response.body.size() / 2);
+    }
+    TEST_FIXTURE(Daemon_fixture, NonAsciiRouteKeyIsRejected) {
+        // Младшие байты «е» и «д» — коды цифр '5' и '4'
+        protocol::Response response = call(routeRequest("ее", "ПРИВЕТМИР"));
+        CHECK(response.status == protocol::Status::CipherError);
+        response = call(routeRequest("д", "ПРИВЕТМИР"));
+        CHECK(response.status == protocol::Status::CipherError);
+    }
+}
+
+int main()
+{
+    init_locale();
+    return UnitTest::RunAllTests();
+}
@@ -0,0 +1,102 @@
+/**
+ * @file update_mode.cpp
+ * @brief Режимы --append и --patch: изменение шифртекста Гронсфельда на месте
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "modes.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+/// Записывает буфер по смещению целиком
+void writeAt(int fd, const std::string& bytes, uint64_t position, const std::string& path)
+{
+    for (std::size_t done = 0; done < bytes.size();) {
+        ssize_t n = pwrite(fd, bytes.data() + done, bytes.size() - done, position + done);
+        if (n < 0)
+            throw std::runtime_error("cannot write " + path + ": " + strerror(errno));
+        done += n;
+    }
+}
+
+} // namespace
+
+uint64_t processUpdate(Engine& engine, Input& in, const Options& opts, uint64_t& bytesOut)
+{
+    try {
+        FileDescriptor out(open(opts.output.c_str(), O_RDWR | (opts.append ? O_CREAT : 0), 0644));
+        if (out.fd < 0)
+            throw std::runtime_error("cannot open " + opts.output + ": " + strerror(errno));
+        off_t fileSize = lseek(out.fd, 0, SEEK_END);
+        if (fileSize < 0)
+            throw std::runtime_error("cannot seek " + opts.output + ": " + strerror(errno));
+        uint64_t size = static_cast<uint64_t>(fileSize);
+        char tail[2] = { 0, 0 };
+        std::size_t tailSize = static_cast<std::size_t>(std::min<uint64_t>(size, 2));
+        if (tailSize && pread(out.fd, tail + 2 - tailSize, tailSize, fileSize - tailSize) != static_cast<ssize_t>(tailSize))
+            throw std::runtime_error("cannot read " + opts.output + ": " + strerror(errno));
+        uint64_t end = size;
+        if (end > 0 && tail[1] == '\n')
+            end -= end > 1 && tail[0] == '\r' ? 2 : 1;
+        if (end % 2 != 0)
+            throw std::invalid_argument("cipher text must consist of two-byte UTF-8 letters");
+        uint64_t letters = end / 2;
+        if (!opts.append && opts.patchOffset > letters)
+            throw std::invalid_argument("range is outside the cipher text");
+
+        // Шифртекст входа: буквы с номерами offset..
+        uint64_t offset = opts.append ? letters : opts.patchOffset;
+        std::wstring text;
+        std::string encoded;
+        bool newline = false;
+        if (!opts.append) {
+            // Замена проверяется целиком до записи, чтобы при ошибке файл не менялся
+            while (in.read(text, ioBlock)) {
+            }
+            stripNewline(text);
+            std::wstring cipherText = engine.transformChunk(text, offset);
+            if (cipherText.size() > letters - offset)
+                throw std::invalid_argument("range is outside the cipher text");
+            appendUtf8(encoded, cipherText);
+            writeAt(out.fd, encoded, 2 * offset, opts.output);
+            bytesOut = encoded.size();
+            return 0;
+        }
+        try {
+            while (text.clear(), in.read(text, opts.chunk)) {
+                if (in.done())
+                    newline = stripNewline(text);
+                encoded.clear();
+                appendUtf8(encoded, engine.transformChunk(text, offset));
+                writeAt(out.fd, encoded, 2 * offset, opts.output);
+                offset += encoded.size() / 2;
+                bytesOut += encoded.size();
+            }
+            if (end == 0 && offset == 0)
+                engine.finish(0);
+        } catch (...) {
+            // Файл возвращается к прежнему содержимому
+            if (ftruncate(out.fd, end) == 0)
+                writeAt(out.fd, std::string(tail + 2 - (size - end), size - end), end, opts.output);
+            throw;
+        }
+        // Перевод строки переносится в конец, если он был у старого файла или у входа
+        std::string rest = newline || end < size ? "\n" : "";
+        writeAt(out.fd, rest, 2 * offset, opts.output);
+        bytesOut += rest.size();
+        if (ftruncate(out.fd, 2 * offset + rest.size()) != 0)
+            throw std::runtime_error("cannot truncate " + opts.output + ": " + strerror(errno));
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,329 @@
+/**
+ * @file uring.cpp
+ * @brief Файл реализации асинхронного ввода-вывода через io_uring
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "uring.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+
+[[noreturn]] void fail(const std::string& what, int error)
+{
+    throw std::runtime_error(what + ": " + std::strerror(error));
+}
+
+int setup(unsigned entries, io_uring_params* params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+/// Метки операций: тип в старших битах, номер буфера в младших
+const uint64_t readTag = 1ull << 32;
+const uint64_t writeTag = 2ull << 32;
+
+} // namespace
+
+Uring::Uring(unsigned entries)
+{
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    fd = setup(entries, &params);
+    if (fd < 0)
+        fail("io_uring_setup", errno);
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single)
+        sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        int error = errno;
+        sqRing = nullptr;
+        close(fd);
+        fail("io_uring mmap", error);
+    }
+    cqRing = single ? sqRing
+                    : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    sqeSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqeMemory = cqRing == MAP_FAILED ? MAP_FAILED
+                                     : mmap(nullptr, sqeSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (cqRing == MAP_FAILED || sqeMemory == MAP_FAILED) {
+        int error = errno;
+        if (cqRing != MAP_FAILED && cqRing != sqRing)
+            munmap(cqRing, cqRingSize);
+        munmap(sqRing, sqRingSize);
+        close(fd);
+        fail("io_uring mmap", error);
+    }
+
+    char* sq = static_cast<char*>(sqRing);
+    char* cq = static_cast<char*>(cqRing);
+    sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    sqes = sqeMemory;
+    cqes = cq + params.cq_off.cqes;
+}
+
+Uring::~Uring()
+{
+    munmap(sqeMemory, sqeSize);
+    if (cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    munmap(sqRing, sqRingSize);
+    close(fd);
+}
+
+bool Uring::available()
+{
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    int probe = setup(1, &params);
+    if (probe < 0)
+        return false;
+    close(probe);
+    return true;
+}
+
+bool Uring::registerBuffers(const std::vector<std::pair<char*, std::size_t>>& buffers)
+{
+    std::vector<iovec> iov;
+    for (auto& b : buffers)
+        iov.push_back(iovec{ b.first, b.second });
+    fixed = syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS, iov.data(),
+                    static_cast<unsigned>(iov.size())) == 0;
+    return fixed;
+}
+
+void* Uring::nextEntry()
+{
+    unsigned tail = *sqTail;
+    if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) > *sqMask)
+        throw std::logic_error("io_uring submission queue is full");
+    unsigned index = tail & *sqMask;
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqes) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqArray[index] = index;
+    return sqe;
+}
+
+void Uring::read(int file, char* data, unsigned size, uint64_t offset, int buffer, uint64_t tag)
+{
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(nextEntry());
+    sqe->opcode = fixed && buffer >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    sqe->fd = file;
+    sqe->off = offset;
+    sqe->addr = reinterpret_cast<uint64_t>(data);
+    sqe->len = size;
+    sqe->user_data = tag;
+    if (sqe->opcode == IORING_OP_READ_FIXED)
+        sqe->buf_index = static_cast<uint16_t>(buffer);
+    __atomic_store_n(sqTail, *sqTail + 1, __ATOMIC_RELEASE);
+    pending++;
+}
+
+void Uring::write(int file, const char* data, unsigned size, uint64_t offset, int buffer, uint64_t tag)
+{
+    io_uring_sqe* sqe = static_cast<io_uring_sqe*>(nextEntry());
+    sqe->opcode = fixed && buffer >= 0 ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+    sqe->fd = file;
+    sqe->off = offset;
+    sqe->addr = reinterpret_cast<uint64_t>(data);
+    sqe->len = size;
+    sqe->user_data = tag;
+    if (sqe->opcode == IORING_OP_WRITE_FIXED)
+        sqe->buf_index = static_cast<uint16_t>(buffer);
+    __atomic_store_n(sqTail, *sqTail + 1, __ATOMIC_RELEASE);
+    pending++;
+}
+
+void Uring::wait(uint64_t& tag, int& result)
+{
+    // Сначала отправляем накопленные операции, чтобы они выполнялись, пока разбираются завершения
+    while (pending > 0) {
+        long rc = syscall(__NR_io_uring_enter, fd, pending, 0, 0, nullptr, 0);
+        if (rc < 0 && errno != EINTR)
+            fail("io_uring_enter", errno);
+        if (rc > 0)
+            pending -= std::min<unsigned>(pending, static_cast<unsigned>(rc));
+    }
+    for (;;) {
+        unsigned head = *cqHead;
+        if (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+            const io_uring_cqe& cqe = static_cast<const io_uring_cqe*>(cqes)[head & *cqMask];
+            tag = cqe.user_data;
+            result = cqe.res;
+            __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+            return;
+        }
+        if (syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR)
+            fail("io_uring_enter", errno);
+    }
+}
+
+UringStream::UringStream(unsigned depth, std::size_t block)
+    : ring(2 * depth), depth(depth), block(block), memory(2 * depth * block), reads(depth), writes(depth)
+{
+    std::vector<std::pair<char*, std::size_t>> buffers;
+    for (unsigned i = 0; i < depth; i++) {
+        reads[i].data = &memory[i * block];
+        writes[i].data = &memory[(depth + i) * block];
+        buffers.emplace_back(reads[i].data, block);
+    }
+    for (unsigned i = 0; i < depth; i++)
+        buffers.emplace_back(writes[i].data, block);
+    counters.depth = depth;
+    counters.registered = ring.registerBuffers(buffers);
+}
+
+UringStream::~UringStream()
+{
+    // Буферы освобождаются только после завершения всех операций ядра
+    while (inFlight > 0) {
+        uint64_t tag;
+        int result;
+        try {
+            ring.wait(tag, result);
+        } catch (const std::exception&) {
+            break;
+        }
+        inFlight--;
+    }
+}
+
+void UringStream::submitRead(unsigned slot)
+{
+    Slot& s = reads[slot];
+    ring.read(inFd, s.data + s.done, static_cast<unsigned>(s.size - s.done), s.offset + s.done, slot, readTag | slot);
+    inFlight++;
+    counters.maxInFlight = std::max(counters.maxInFlight, inFlight);
+}
+
+void UringStream::submitWrite(unsigned slot)
+{
+    Slot& s = writes[slot];
+    ring.write(outFd, s.data + s.done, static_cast<unsigned>(s.size - s.done), s.offset + s.done, depth + slot,
+               writeTag | slot);
+    inFlight++;
+    counters.maxInFlight = std::max(counters.maxInFlight, inFlight);
+}
+
+void UringStream::reap()
+{
+    uint64_t tag;
+    int result;
+    ring.wait(tag, result);
+    inFlight--;
+    bool isRead = (tag & ~0xFFFFFFFFull) == readTag;
+    Slot& s = isRead ? reads[tag & 0xFFFFFFFF] : writes[tag & 0xFFFFFFFF];
+    if (result < 0)
+        fail(isRead ? "read" : "write", -result);
+    if (result == 0)
+        throw std::runtime_error(isRead ? "read: unexpected end of file" : "write: no progress");
+    s.done += static_cast<std::size_t>(result);
+    if (s.done < s.size) {
+        // Неполная операция: дочитываем или дописываем остаток
+        if (isRead)
+            submitRead(static_cast<unsigned>(tag & 0xFFFFFFFF));
+        else
+            submitWrite(static_cast<unsigned>(tag & 0xFFFFFFFF));
+        return;
+    }
+    if (isRead)
+        counters.bytesRead += s.size;
+    else {
+        counters.bytesWritten += s.size;
+        s.busy = false;
+    }
+}
+
+void UringStream::run(int in, uint64_t size, int out, const std::function<void(const char*, std::size_t, bool)>& consume)
+{
+    inFd = in;
+    outFd = out;
+    uint64_t blocks = (size + block - 1) / block;
+    uint64_t submitted = 0;
+    for (uint64_t next = 0; next < blocks; next++) {
+        // Держим в полёте до depth чтений вперёд
+        for (; submitted < blocks && submitted < next + depth; submitted++) {
+            Slot& s = reads[submitted % depth];
+            s.offset = submitted * block;
+            s.size = static_cast<std::size_t>(std::min<uint64_t>(block, size - s.offset));
+            s.done = 0;
+            s.busy = true;
+            submitRead(static_cast<unsigned>(submitted % depth));
+        }
+        Slot& s = reads[next % depth];
+        while (s.done < s.size)
+            reap();
+        consume(s.data, s.size, next + 1 == blocks);
+    }
+    if (blocks == 0)
+        consume(nullptr, 0, true);
+}
+
+void UringStream::write(const char* data, std::size_t size)
+{
+    while (size > 0) {
+        Slot& s = writes[current];
+        while (s.busy)
+            reap();
+        std::size_t n = std::min(size, block - s.size);
+        std::memcpy(s.data + s.size, data, n);
+        s.size += n;
+        data += n;
+        size -= n;
+        if (s.size == block) {
+            s.offset = outOffset;
+            s.done = 0;
+            s.busy = true;
+            outOffset += s.size;
+            submitWrite(static_cast<unsigned>(current));
+            current = (current + 1) % depth;
+            // Следующий буфер начинается пустым, когда освободится
+            Slot& nextSlot = writes[current];
+            while (nextSlot.busy)
+                reap();
+            nextSlot.size = 0;
+        }
+    }
+}
+
+void UringStream::flush()
+{
+    Slot& s = writes[current];
+    if (s.size > 0 && !s.busy) {
+        s.offset = outOffset;
+        s.done = 0;
+        s.busy = true;
+        outOffset += s.size;
+        submitWrite(static_cast<unsigned>(current));
+        current = (current + 1) % depth;
+        while (writes[current].busy)
+            reap();
+        writes[current].size = 0;
+    }
+    for (auto& w : writes) {
+        while (w.busy)
+            reap();
+    }
+}
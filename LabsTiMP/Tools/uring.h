@@ -0,0 +1,138 @@
+/**
+ * @file uring.h
+ * @brief Асинхронный файловый ввод-вывод через io_uring (Linux)
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Используются системные вызовы io_uring_setup/io_uring_enter/io_uring_register
+ * напрямую, без liburing. Если ядро не поддерживает io_uring или его
+ * использование запрещено, Uring::available() возвращает false и утилита
+ * работает через потоки (pipeline.h).
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Кольца отправки и завершения io_uring
+ * @details Ошибки системных вызовов сообщаются исключением std::runtime_error.
+ */
+class Uring {
+public:
+    /**
+     * @brief Создаёт кольцо
+     * @param[in] entries Количество мест в очереди отправки
+     */
+    explicit Uring(unsigned entries);
+    ~Uring();
+    Uring(const Uring&) = delete;
+    Uring& operator=(const Uring&) = delete;
+
+    /// Поддерживает ли ядро io_uring
+    static bool available();
+
+    /**
+     * @brief Регистрирует буферы для операций READ_FIXED/WRITE_FIXED
+     * @return false, если ядро отказало (например, из-за ограничения RLIMIT_MEMLOCK);
+     *         тогда используются обычные READ/WRITE
+     */
+    bool registerBuffers(const std::vector<std::pair<char*, std::size_t>>& buffers);
+
+    /**
+     * @brief Ставит в очередь чтение
+     * @param[in] buffer Номер зарегистрированного буфера или -1
+     */
+    void read(int fd, char* data, unsigned size, uint64_t offset, int buffer, uint64_t tag);
+    /// Ставит в очередь запись
+    void write(int fd, const char* data, unsigned size, uint64_t offset, int buffer, uint64_t tag);
+
+    /**
+     * @brief Отправляет поставленные операции и ждёт завершения хотя бы одной
+     * @param[out] tag Метка завершённой операции
+     * @param[out] result Результат: число байт или -errno
+     */
+    void wait(uint64_t& tag, int& result);
+
+private:
+    int fd = -1;
+    void* sqRing = nullptr;
+    void* cqRing = nullptr;
+    void* sqeMemory = nullptr;
+    std::size_t sqRingSize = 0, cqRingSize = 0, sqeSize = 0;
+    unsigned *sqHead, *sqTail, *sqMask, *sqArray;
+    unsigned *cqHead, *cqTail, *cqMask;
+    void* sqes;
+    void* cqes;
+    unsigned pending = 0;
+    bool fixed = false;
+
+    void* nextEntry();
+};
+
+/**
+ * @brief Статистика UringStream
+ */
+struct UringStats {
+    unsigned depth = 0;       ///< Заданная глубина очереди
+    unsigned maxInFlight = 0; ///< Наибольшее число одновременных операций
+    bool registered = false;  ///< Использовались ли зарегистрированные буферы
+    uint64_t bytesRead = 0, bytesWritten = 0;
+};
+
+/**
+ * @brief Последовательная обработка файла блоками с несколькими операциями в полёте
+ * @details Чтения следующих блоков ставятся в очередь заранее, блоки
+ *          передаются обработчику строго по порядку по мере готовности.
+ *          Результат, переданный в write(), копируется в выходные буферы и
+ *          записывается асинхронно по возрастающим смещениям.
+ */
+class UringStream {
+public:
+    /**
+     * @param[in] depth Количество блоков чтения и записи в полёте
+     * @param[in] block Размер блока, байт
+     */
+    UringStream(unsigned depth, std::size_t block);
+    ~UringStream();
+
+    /**
+     * @brief Обрабатывает первые size байт файла in и пишет результат в out
+     * @param[in] consume Вызывается для каждого блока по порядку; last — последний блок
+     */
+    void run(int in, uint64_t size, int out, const std::function<void(const char*, std::size_t, bool)>& consume);
+    /// Выводит байты результата (вызывается из consume или после run)
+    void write(const char* data, std::size_t size);
+    /// Дожидается завершения всех записей
+    void flush();
+
+    const UringStats& stats() const { return counters; }
+
+private:
+    /// Состояние буфера: число байт в буфере и число байт, уже прочитанных/записанных
+    struct Slot {
+        char* data = nullptr;
+        std::size_t size = 0, done = 0;
+        uint64_t offset = 0;
+        bool busy = false;
+    };
+
+    Uring ring;
+    unsigned depth;
+    std::size_t block;
+    std::vector<char> memory;
+    std::vector<Slot> reads, writes;
+    int inFd = -1, outFd = -1;
+    unsigned inFlight = 0;
+    std::size_t current = 0; ///< Заполняемый выходной буфер
+    uint64_t outOffset = 0;
+    UringStats counters;
+
+    void submitRead(unsigned slot);
+    void submitWrite(unsigned slot);
+    void reap();
+};
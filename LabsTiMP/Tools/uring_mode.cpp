@@ -0,0 +1,81 @@
+/**
+ * @file uring_mode.cpp
+ * @brief Режим --uring: преобразование файла с вводом-выводом через io_uring
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "modes.h"
+#include "uring.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <stdexcept>
+
+uint64_t processUring(Engine& engine, const Options& opts, UringStats& stats)
+{
+    try {
+        FileDescriptor in(open(opts.input.c_str(), O_RDONLY));
+        if (in.fd < 0)
+            throw std::runtime_error("cannot open " + opts.input + ": " + strerror(errno));
+        FileDescriptor out(open(opts.output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644));
+        if (out.fd < 0)
+            throw std::runtime_error("cannot open " + opts.output + ": " + strerror(errno));
+
+        // Завершающий перевод строки не входит в сообщение, как и в потоковом режиме
+        off_t fileSize = lseek(in.fd, 0, SEEK_END);
+        if (fileSize < 0)
+            throw std::runtime_error("cannot seek " + opts.input + ": " + strerror(errno));
+        uint64_t size = static_cast<uint64_t>(fileSize);
+        char tail[2] = { 0, 0 };
+        std::size_t tailSize = static_cast<std::size_t>(std::min<uint64_t>(size, 2));
+        if (tailSize && pread(in.fd, tail + 2 - tailSize, tailSize, fileSize - tailSize) != static_cast<ssize_t>(tailSize))
+            throw std::runtime_error("cannot read " + opts.input + ": " + strerror(errno));
+        bool newline = size > 0 && tail[1] == '\n';
+        if (newline)
+            size -= size > 1 && tail[0] == '\r' ? 2 : 1;
+
+        UringStream stream(opts.queueDepth, ioBlock);
+        utf8::Decoder decoder;
+        std::vector<wchar_t> chars(ioBlock + 1);
+        std::wstring whole;
+        std::string encoded;
+        uint64_t offset = 0;
+        stream.run(in.fd, size, out.fd, [&](const char* data, std::size_t n, bool last) {
+            std::size_t count = decoder.decode(data, n, chars.data());
+            if (last)
+                count += decoder.finish(chars.data() + count);
+            if (engine.chunked()) {
+                // Блоки шифра Гронсфельда обрабатываются по мере поступления
+                std::wstring chunk(chars.data(), count);
+                encoded.clear();
+                appendUtf8(encoded, engine.transformChunk(chunk, offset));
+                offset += engine.letters(chunk);
+                stream.write(encoded.data(), encoded.size());
+                if (last)
+                    engine.finish(offset);
+            } else {
+                whole.append(chars.data(), count);
+                if (last) {
+                    std::wstring result = engine.transform(whole);
+                    for (std::size_t i = 0; i < result.size(); i += ioBlock / 4) {
+                        encoded.clear();
+                        appendUtf8(encoded, result.substr(i, ioBlock / 4));
+                        stream.write(encoded.data(), encoded.size());
+                    }
+                }
+            }
+        });
+        if (newline)
+            stream.write("\n", 1);
+        stream.flush();
+        stats = stream.stats();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file utf8.cpp
+ * @brief Файл реализации потокового преобразования UTF-8
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "utf8.h"
+
+namespace utf8 {
+
+std::size_t Decoder::decode(const char* in, std::size_t size, wchar_t* out)
+{
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(in);
+    const unsigned char* end = p + size;
+    wchar_t* o = out;
+    while (p < end) {
+        unsigned char b = *p;
+        if (need == 0) {
+            // Быстрый путь для ASCII и двухбайтовых символов (кириллица)
+            if (b < 0x80) {
+                *o++ = b;
+                p++;
+                continue;
+            }
+            if ((b & 0xE0) == 0xC0 && b >= 0xC2 && p + 1 < end && (p[1] & 0xC0) == 0x80) {
+                *o++ = static_cast<wchar_t>(((b & 0x1F) << 6) | (p[1] & 0x3F));
+                p += 2;
+                continue;
+            }
+            p++;
+            if (b >= 0xC2 && b < 0xE0) {
+                partial = b & 0x1F;
+                need = 1;
+            } else if ((b & 0xF0) == 0xE0) {
+                partial = b & 0x0F;
+                need = 2;
+            } else if (b >= 0xF0 && b < 0xF5) {
+                partial = b & 0x07;
+                need = 3;
+            } else {
+                *o++ = replacement;
+            }
+        } else if ((b & 0xC0) == 0x80) {
+            partial = (partial << 6) | (b & 0x3F);
+            p++;
+            if (--need == 0)
+                *o++ = partial <= 0x10FFFF && (partial < 0xD800 || partial > 0xDFFF)
+                    ? static_cast<wchar_t>(partial) : replacement;
+        } else {
+            // Последовательность оборвалась: байт разбирается заново как начало символа
+            need = 0;
+            *o++ = replacement;
+        }
+    }
+    return static_cast<std::size_t>(o - out);
+}
+
+std::size_t Decoder::finish(wchar_t* out)
+{
+    if (need == 0)
+        return 0;
+    need = 0;
+    *out = replacement;
+    return 1;
+}
+
+std::size_t encode(const wchar_t* text, std::size_t size, char* out)
+{
+    char* p = out;
+    for (std::size_t i = 0; i < size; i++) {
+        uint32_t c = static_cast<uint32_t>(text[i]);
+        if (c < 0x80) {
+            *p++ = static_cast<char>(c);
+        } else if (c < 0x800) {
+            *p++ = static_cast<char>(0xC0 | (c >> 6));
+            *p++ = static_cast<char>(0x80 | (c & 0x3F));
+        } else if (c < 0x10000) {
+            *p++ = static_cast<char>(0xE0 | (c >> 12));
+            *p++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            *p++ = static_cast<char>(0x80 | (c & 0x3F));
+        } else {
+            *p++ = static_cast<char>(0xF0 | (c >> 18));
+            *p++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            *p++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            *p++ = static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+    return static_cast<std::size_t>(p - out);
+}
+
+} // namespace utf8
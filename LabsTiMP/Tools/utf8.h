@@ -0,0 +1,57 @@
+/**
+ * @file utf8.h
+ * @brief Потоковое преобразование между UTF-8 и wchar_t
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ *
+ * Преобразование не зависит от локали и работает блоками произвольной длины:
+ * последовательность UTF-8, разрезанная границей блока, дочитывается
+ * при следующем вызове.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace utf8 {
+
+/// Символ, подставляемый вместо некорректной последовательности байт
+const wchar_t replacement = 0xFFFD;
+
+/**
+ * @brief Декодер UTF-8 с сохранением состояния между блоками
+ */
+class Decoder {
+public:
+    /**
+     * @brief Декодирует очередной блок байт
+     * @param[in] in Байты UTF-8
+     * @param[in] size Количество байт
+     * @param[out] out Буфер не менее size + 1 символов
+     * @return Количество записанных символов
+     */
+    std::size_t decode(const char* in, std::size_t size, wchar_t* out);
+    /**
+     * @brief Завершает поток
+     * @param[out] out Буфер не менее 1 символа
+     * @return 1, если поток оборвался посреди последовательности (записан replacement), иначе 0
+     */
+    std::size_t finish(wchar_t* out);
+
+private:
+    uint32_t partial = 0; ///< Накопленные биты незавершённой последовательности
+    int need = 0;         ///< Сколько байт продолжения ещё ожидается
+};
+
+/**
+ * @brief Кодирует символы в UTF-8
+ * @param[in] text Символы
+ * @param[in] size Количество символов
+ * @param[out] out Буфер не менее 4 * size байт
+ * @return Количество записанных байт
+ */
+std::size_t encode(const wchar_t* text, std::size_t size, char* out);
+
+} // namespace utf8
@@ -0,0 +1,100 @@
+/**
+ * @file whole_mode.cpp
+ * @brief Весь вход — одно сообщение, обрабатываемое целиком, с размещением буферов
+ * @author Рябов Кирилл
+ * @version 1.0
+ * @date 19.10.2026г.
+ * @copyright ИБСТ ПГУ
+ */
+
+#include "modes.h"
+#include "scheduler.h"
+#include <chrono>
+#include <iostream>
+
+namespace {
+
+/**
+ * @brief Преобразует длинное сообщение задачами планировщика в буфер без начального заполнения
+ * @details С --first-touch сообщение сначала переписывается задачами по
+ *          частям в такой же буфер (исходная строка освобождается): часть
+ *          входа и часть выхода размещаются на узле NUMA потока, который
+ *          обрабатывает эту часть. Буферы получают огромные страницы по --huge-pages.
+ * @param[in,out] text Сообщение; с --first-touch освобождается
+ * @param[out] result Буфер результата
+ * @return Длина результата
+ */
+std::size_t transformPlaced(Engine& engine, std::wstring& text, Scheduler& scheduler, std::size_t grain,
+                            PageBuffer<wchar_t>& result)
+{
+    const Placement& placement = scheduler.placement();
+    std::size_t size = text.size();
+    result = PageBuffer<wchar_t>(size, placement.hugePages);
+    if (!placement.firstTouch)
+        return engine.transformTasks(text.data(), size, result.data(), scheduler, grain);
+    PageBuffer<wchar_t> input(size, placement.hugePages);
+    scheduler.parallelFor(size, grain, [&](std::size_t begin, std::size_t end) {
+        std::copy(text.begin() + begin, text.begin() + end, input.data() + begin);
+    });
+    std::wstring().swap(text);
+    return engine.transformTasks(input.data(), size, result.data(), scheduler, grain);
+}
+
+/**
+ * @brief Режим --compare: время преобразования без размещения и с ним
+ * @details Сообщение сначала преобразуется планировщиком без закрепления,
+ *          первого касания и огромных страниц; результат отбрасывается.
+ * @return Время, с
+ */
+double baselineSeconds(Engine& engine, const std::wstring& text, const Options& opts)
+{
+    Scheduler plain(opts.threads);
+    auto start = std::chrono::steady_clock::now();
+    guarded([&] { return engine.transformTasks(text, plain, opts.chunk); });
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace
+
+uint64_t processWhole(Engine& engine, Input& in, Output& out, const Options& opts, Scheduler* scheduler)
+{
+    std::wstring text;
+    while (in.read(text, ioBlock)) {
+    }
+    bool newline = stripNewline(text);
+    if (scheduler && text.size() > opts.chunk) {
+        double baseline = opts.compare ? baselineSeconds(engine, text, opts) : 0;
+        PageBuffer<wchar_t> result;
+        std::size_t length = 0;
+        auto start = std::chrono::steady_clock::now();
+        Result r = guarded([&] {
+            length = transformPlaced(engine, text, *scheduler, opts.chunk, result);
+            return std::wstring();
+        });
+        std::chrono::duration<double> placed = std::chrono::steady_clock::now() - start;
+        if (!r.error.empty()) {
+            std::cerr << "Error: " << r.error << std::endl;
+            return 1;
+        }
+        if (opts.stats && opts.hugePages != HugePages::None)
+            fprintf(stderr, "huge pages: %s requested, %s obtained (%zu kB pages)\n", hugePagesName(opts.hugePages),
+                    hugePagesName(result.pages()), hugePageSize() / 1024);
+        if (opts.compare)
+            fprintf(stderr, "placement: baseline %.3f s, placed %.3f s, speedup %.2fx\n", baseline, placed.count(),
+                    baseline / std::max(placed.count(), 1e-9));
+        out.write(result.data(), length);
+        if (newline)
+            out.put(L'\n');
+        return 0;
+    }
+    Result r = guarded([&] { return transformMessage(engine, text, scheduler, opts.chunk); });
+    if (!r.error.empty()) {
+        std::cerr << "Error: " << r.error << std::endl;
+        return 1;
+    }
+    out.write(r.text);
+    if (newline)
+        out.put(L'\n');
+    return 0;
+}